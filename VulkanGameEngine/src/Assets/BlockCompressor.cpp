@@ -0,0 +1,478 @@
+#include "BlockCompressor.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BLOCK_COMPRESSOR_SSE2
+#endif
+
+#include "../Core/Profiler.h"
+
+// Share of end endpoint per BC1 index, index 2 and 3 lie between the endpoints
+constexpr float BC1_WEIGHTS[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+
+// Share of end endpoint per BC4 index in eight value mode
+constexpr float BC4_WEIGHTS[8] = { 0.0f, 1.0f, 1.0f / 7.0f, 2.0f / 7.0f, 3.0f / 7.0f, 4.0f / 7.0f, 5.0f / 7.0f, 6.0f / 7.0f };
+
+// Interpolation weights of BC7 4 bit indices, out of 64
+constexpr uint32_t BC7_WEIGHTS[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+// Power iterations finding the principal axis of a block
+constexpr uint32_t POWER_ITERATIONS = 8;
+
+// Writes fields of an encoded block least significant bit first
+class BitWriter {
+public:
+	BitWriter(uint8_t* output) : m_Output(output) {}	// Constructor, output must be zeroed
+
+	// Append low bits of value
+	void Write(uint32_t value, uint32_t bits) {
+		for (uint32_t i = 0; i < bits; i++, m_Position++) {
+			m_Output[m_Position / 8] |= static_cast<uint8_t>(((value >> i) & 1) << (m_Position % 8));
+		}
+	}
+private:
+	uint8_t* m_Output;			// Encoded block
+	uint32_t m_Position = 0;	// Next bit
+};
+
+// Constructor
+BlockCompressor::BlockCompressor(ThreadPool* threadPool)
+: m_ThreadPool(threadPool) {
+}
+
+// Destructor
+BlockCompressor::~BlockCompressor(){
+}
+
+// Encode tightly packed RGBA8 texels, partial blocks at edges repeat the last texel
+std::vector<uint8_t> BlockCompressor::Compress(const uint8_t* texels, uint32_t width, uint32_t height, BlockFormat format){
+	PROFILE_SCOPE("BlockCompressor::Compress");
+	auto blocksWide = (width + BLOCK_EXTENT - 1) / BLOCK_EXTENT;
+	auto blocksHigh = (height + BLOCK_EXTENT - 1) / BLOCK_EXTENT;
+	auto blockSize = GetBlockSize(format);
+	std::vector<uint8_t> output(static_cast<size_t>(blocksWide) * blocksHigh * blockSize);
+
+	// Encode rows of blocks, edge blocks are gathered with clamped coordinates first
+	auto encodeRows = [&](uint32_t firstRow, uint32_t lastRow) {
+		uint8_t padded[BLOCK_EXTENT * BLOCK_EXTENT * 4];
+		for (auto by = firstRow; by < lastRow; by++) {
+			for (uint32_t bx = 0; bx < blocksWide; bx++) {
+				auto destination = output.data() + (static_cast<size_t>(by) * blocksWide + bx) * blockSize;
+				auto x = bx * BLOCK_EXTENT;
+				auto y = by * BLOCK_EXTENT;
+				if (x + BLOCK_EXTENT <= width && y + BLOCK_EXTENT <= height) {
+					CompressBlock(texels + (static_cast<size_t>(y) * width + x) * 4, width * 4, format, destination);
+					continue;
+				}
+				for (uint32_t row = 0; row < BLOCK_EXTENT; row++) {
+					for (uint32_t column = 0; column < BLOCK_EXTENT; column++) {
+						auto source = texels + (static_cast<size_t>(std::min(y + row, height - 1)) * width + std::min(x + column, width - 1)) * 4;
+						std::memcpy(padded + (row * BLOCK_EXTENT + column) * 4, source, 4);
+					}
+				}
+				CompressBlock(padded, BLOCK_EXTENT * 4, format, destination);
+			}
+		}
+	};
+
+	// Encode serially without workers or with a single task
+	if (!m_ThreadPool || blocksHigh <= BLOCK_ROWS_PER_TASK) {
+		encodeRows(0, blocksHigh);
+		return output;
+	}
+
+	// Queue a task per slice of block rows, blocks are independent
+	for (uint32_t row = 0; row < blocksHigh; row += BLOCK_ROWS_PER_TASK) {
+		auto lastRow = std::min(row + BLOCK_ROWS_PER_TASK, blocksHigh);
+		m_ThreadPool->Enqueue([&encodeRows, row, lastRow]() { encodeRows(row, lastRow); });
+	}
+	m_ThreadPool->Wait();
+	return output;
+}
+
+// Encode 4x4 RGBA8 texels starting at texels, rows stride bytes apart
+void BlockCompressor::CompressBlock(const uint8_t* texels, uint32_t stride, BlockFormat format, uint8_t* output){
+	// Split texels into channel planes
+	Block block;
+	for (uint32_t row = 0; row < BLOCK_EXTENT; row++) {
+		for (uint32_t column = 0; column < BLOCK_EXTENT; column++) {
+			for (uint32_t channel = 0; channel < 4; channel++) {
+				block.channels[channel][row * BLOCK_EXTENT + column] = texels[row * stride + column * 4 + channel];
+			}
+		}
+	}
+
+	// Encode, BC3 and BC5 are two 8 byte halves
+	std::memset(output, 0, GetBlockSize(format));
+	switch (format) {
+	case BlockFormat::BC1:
+		EncodeBC1(block, output);
+		break;
+	case BlockFormat::BC3:
+		EncodeBC4(block, 3, output);
+		EncodeBC1(block, output + 8);
+		break;
+	case BlockFormat::BC5:
+		EncodeBC4(block, 0, output);
+		EncodeBC4(block, 1, output + 8);
+		break;
+	case BlockFormat::BC7:
+		EncodeBC7(block, output);
+		break;
+	}
+}
+
+// Vulkan format of encoded blocks, BC5 is never sRGB
+VkFormat BlockCompressor::GetVkFormat(BlockFormat format, bool srgb){
+	switch (format) {
+	case BlockFormat::BC1:
+		return srgb ? VK_FORMAT_BC1_RGB_SRGB_BLOCK : VK_FORMAT_BC1_RGB_UNORM_BLOCK;
+	case BlockFormat::BC3:
+		return srgb ? VK_FORMAT_BC3_SRGB_BLOCK : VK_FORMAT_BC3_UNORM_BLOCK;
+	case BlockFormat::BC5:
+		return VK_FORMAT_BC5_UNORM_BLOCK;
+	case BlockFormat::BC7:
+		return srgb ? VK_FORMAT_BC7_SRGB_BLOCK : VK_FORMAT_BC7_UNORM_BLOCK;
+	}
+	throw std::runtime_error("Unable to map unknown block format!");
+}
+
+// Bytes per encoded block
+uint32_t BlockCompressor::GetBlockSize(BlockFormat format){
+	return format == BlockFormat::BC1 ? 8 : 16;
+}
+
+// Colour block with two 565 endpoints and 2 bit indices
+void BlockCompressor::EncodeBC1(const Block& block, uint8_t* output){
+	// Round to 565 and expand back the way the hardware does
+	auto quantize = [](const glm::vec4& colour) {
+		auto r = static_cast<uint32_t>(std::lround(colour.r * 31.0f / 255.0f));
+		auto g = static_cast<uint32_t>(std::lround(colour.g * 63.0f / 255.0f));
+		auto b = static_cast<uint32_t>(std::lround(colour.b * 31.0f / 255.0f));
+		return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+	};
+	auto expand = [](uint16_t colour) {
+		uint32_t r = colour >> 11;
+		uint32_t g = (colour >> 5) & 63;
+		uint32_t b = colour & 31;
+		return glm::vec4((r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2), 0.0f);
+	};
+
+	// Start from extremes along principal axis, then refit endpoints to the chosen indices
+	glm::vec4 start;
+	glm::vec4 end;
+	FitEndpoints(block, 0, 3, start, end);
+	auto bestError = FLT_MAX;
+	uint16_t colours[2] = {};
+	uint8_t bestIndices[16] = {};
+	for (uint32_t iteration = 0; iteration <= REFINE_ITERATIONS; iteration++) {
+		uint16_t candidate[2] = { quantize(start), quantize(end) };
+		auto first = expand(candidate[0]);
+		auto second = expand(candidate[1]);
+		glm::vec4 palette[4] = { first, second, (first * 2.0f + second) / 3.0f, (first + second * 2.0f) / 3.0f };
+		uint8_t indices[16];
+		auto error = FitIndices(block, 0, 3, palette, 4, indices);
+		if (error < bestError) {
+			bestError = error;
+			std::memcpy(colours, candidate, sizeof(colours));
+			std::memcpy(bestIndices, indices, sizeof(bestIndices));
+		}
+		if (iteration == REFINE_ITERATIONS || !RefineEndpoints(block, 0, 3, indices, BC1_WEIGHTS, start, end)) {
+			break;
+		}
+	}
+
+	// Four colour mode needs first endpoint above second, swapping endpoints swaps index pairs
+	if (colours[0] < colours[1]) {
+		std::swap(colours[0], colours[1]);
+		for (auto& index : bestIndices) {
+			index ^= 1;
+		}
+	}
+	else if (colours[0] == colours[1]) {
+		std::memset(bestIndices, 0, sizeof(bestIndices));
+	}
+
+	// Endpoints followed by 2 bit indices, first texel lowest
+	BitWriter writer(output);
+	writer.Write(colours[0], 16);
+	writer.Write(colours[1], 16);
+	for (auto index : bestIndices) {
+		writer.Write(index, 2);
+	}
+}
+
+// Single channel block with two 8 bit endpoints and 3 bit indices, BC3 alpha and BC5 channels
+void BlockCompressor::EncodeBC4(const Block& block, uint32_t channel, uint8_t* output){
+	// Start from channel range, then refit endpoints to the chosen indices
+	glm::vec4 start;
+	glm::vec4 end;
+	FitEndpoints(block, channel, 1, start, end);
+	auto bestError = FLT_MAX;
+	uint32_t values[2] = {};
+	uint8_t bestIndices[16] = {};
+	for (uint32_t iteration = 0; iteration <= REFINE_ITERATIONS; iteration++) {
+		uint32_t candidate[2] = { static_cast<uint32_t>(std::lround(start[channel])), static_cast<uint32_t>(std::lround(end[channel])) };
+		glm::vec4 palette[8] = {};
+		for (uint32_t i = 0; i < 8; i++) {
+			palette[i][channel] = candidate[0] + (static_cast<float>(candidate[1]) - candidate[0]) * BC4_WEIGHTS[i];
+		}
+		uint8_t indices[16];
+		auto error = FitIndices(block, channel, 1, palette, 8, indices);
+		if (error < bestError) {
+			bestError = error;
+			std::memcpy(values, candidate, sizeof(values));
+			std::memcpy(bestIndices, indices, sizeof(bestIndices));
+		}
+		if (iteration == REFINE_ITERATIONS || !RefineEndpoints(block, channel, 1, indices, BC4_WEIGHTS, start, end)) {
+			break;
+		}
+	}
+
+	// Eight value mode needs first endpoint above second, swapping endpoints mirrors interpolated indices
+	if (values[0] < values[1]) {
+		std::swap(values[0], values[1]);
+		for (auto& index : bestIndices) {
+			index = index < 2 ? index ^ 1 : 9 - index;
+		}
+	}
+	else if (values[0] == values[1]) {
+		std::memset(bestIndices, 0, sizeof(bestIndices));
+	}
+
+	// Endpoints followed by 3 bit indices, first texel lowest
+	BitWriter writer(output);
+	writer.Write(values[0], 8);
+	writer.Write(values[1], 8);
+	for (auto index : bestIndices) {
+		writer.Write(index, 3);
+	}
+}
+
+// Mode 6 block, one RGBA subset with 7 bit endpoints, p-bits and 4 bit indices
+void BlockCompressor::EncodeBC7(const Block& block, uint8_t* output){
+	float weights[16];
+	for (uint32_t i = 0; i < 16; i++) {
+		weights[i] = BC7_WEIGHTS[i] / 64.0f;
+	}
+
+	// Start from extremes along principal axis, then refit endpoints to the chosen indices
+	glm::vec4 start;
+	glm::vec4 end;
+	FitEndpoints(block, 0, 4, start, end);
+	auto bestError = FLT_MAX;
+	glm::uvec4 endpoints[2] = {};
+	uint32_t pBits[2] = {};
+	uint8_t bestIndices[16] = {};
+	for (uint32_t iteration = 0; iteration <= REFINE_ITERATIONS; iteration++) {
+		// Each endpoint shares its lowest bit across channels, try every p-bit pair
+		for (uint32_t p = 0; p < 4; p++) {
+			uint32_t candidateBits[2] = { p & 1, p >> 1 };
+			glm::uvec4 candidate[2];
+			glm::vec4 expanded[2];
+			for (uint32_t e = 0; e < 2; e++) {
+				auto& source = e == 0 ? start : end;
+				for (uint32_t c = 0; c < 4; c++) {
+					candidate[e][c] = static_cast<uint32_t>(std::clamp<long>(std::lround((source[c] - candidateBits[e]) * 0.5f), 0, 127));
+					expanded[e][c] = static_cast<float>(candidate[e][c] * 2 + candidateBits[e]);
+				}
+			}
+
+			// Interpolate palette with the hardware's rounding
+			glm::vec4 palette[16];
+			for (uint32_t i = 0; i < 16; i++) {
+				for (uint32_t c = 0; c < 4; c++) {
+					auto value = (64 - BC7_WEIGHTS[i]) * static_cast<uint32_t>(expanded[0][c]) + BC7_WEIGHTS[i] * static_cast<uint32_t>(expanded[1][c]) + 32;
+					palette[i][c] = static_cast<float>(value >> 6);
+				}
+			}
+			uint8_t indices[16];
+			auto error = FitIndices(block, 0, 4, palette, 16, indices);
+			if (error < bestError) {
+				bestError = error;
+				endpoints[0] = candidate[0];
+				endpoints[1] = candidate[1];
+				pBits[0] = candidateBits[0];
+				pBits[1] = candidateBits[1];
+				std::memcpy(bestIndices, indices, sizeof(bestIndices));
+			}
+		}
+		if (iteration == REFINE_ITERATIONS || !RefineEndpoints(block, 0, 4, bestIndices, weights, start, end)) {
+			break;
+		}
+	}
+
+	// First texel's index drops its top bit, swap endpoints and mirror indices if it is set
+	if (bestIndices[0] & 8) {
+		std::swap(endpoints[0], endpoints[1]);
+		std::swap(pBits[0], pBits[1]);
+		for (auto& index : bestIndices) {
+			index = 15 - index;
+		}
+	}
+
+	// Mode bit, endpoints per channel, p-bits and indices
+	BitWriter writer(output);
+	writer.Write(1 << 6, 7);
+	for (uint32_t c = 0; c < 4; c++) {
+		writer.Write(endpoints[0][c], 7);
+		writer.Write(endpoints[1][c], 7);
+	}
+	writer.Write(pBits[0], 1);
+	writer.Write(pBits[1], 1);
+	writer.Write(bestIndices[0], 3);
+	for (uint32_t i = 1; i < 16; i++) {
+		writer.Write(bestIndices[i], 4);
+	}
+}
+
+// Nearest palette entry per texel over channel range, returns squared error
+float BlockCompressor::FitIndices(const Block& block, uint32_t firstChannel, uint32_t channelCount, const glm::vec4* palette, uint32_t paletteSize, uint8_t* indices){
+	auto error = 0.0f;
+#ifdef BLOCK_COMPRESSOR_SSE2
+	// Four texels at a time, keeping the smallest distance and its index per lane
+	for (uint32_t texel = 0; texel < 16; texel += 4) {
+		auto best = _mm_set1_ps(FLT_MAX);
+		auto bestIndex = _mm_setzero_si128();
+		for (uint32_t entry = 0; entry < paletteSize; entry++) {
+			auto distance = _mm_setzero_ps();
+			for (auto c = firstChannel; c < firstChannel + channelCount; c++) {
+				auto difference = _mm_sub_ps(_mm_load_ps(&block.channels[c][texel]), _mm_set1_ps(palette[entry][c]));
+				distance = _mm_add_ps(distance, _mm_mul_ps(difference, difference));
+			}
+			auto closer = _mm_castps_si128(_mm_cmplt_ps(distance, best));
+			best = _mm_min_ps(distance, best);
+			bestIndex = _mm_or_si128(_mm_and_si128(closer, _mm_set1_epi32(static_cast<int>(entry))), _mm_andnot_si128(closer, bestIndex));
+		}
+
+		// Store lanes
+		alignas(16) int32_t laneIndices[4];
+		alignas(16) float laneErrors[4];
+		_mm_store_si128(reinterpret_cast<__m128i*>(laneIndices), bestIndex);
+		_mm_store_ps(laneErrors, best);
+		for (uint32_t lane = 0; lane < 4; lane++) {
+			indices[texel + lane] = static_cast<uint8_t>(laneIndices[lane]);
+			error += laneErrors[lane];
+		}
+	}
+#else
+	// One texel at a time
+	for (uint32_t texel = 0; texel < 16; texel++) {
+		auto best = FLT_MAX;
+		for (uint32_t entry = 0; entry < paletteSize; entry++) {
+			auto distance = 0.0f;
+			for (auto c = firstChannel; c < firstChannel + channelCount; c++) {
+				auto difference = block.channels[c][texel] - palette[entry][c];
+				distance += difference * difference;
+			}
+			if (distance < best) {
+				best = distance;
+				indices[texel] = static_cast<uint8_t>(entry);
+			}
+		}
+		error += best;
+	}
+#endif
+	return error;
+}
+
+// Extremes of texels along their principal axis over channel range
+void BlockCompressor::FitEndpoints(const Block& block, uint32_t firstChannel, uint32_t channelCount, glm::vec4& start, glm::vec4& end){
+	auto lastChannel = firstChannel + channelCount;
+
+	// Mean and bounding box of texels
+	glm::vec4 mean(0.0f);
+	glm::vec4 min(FLT_MAX);
+	glm::vec4 max(-FLT_MAX);
+	for (auto c = firstChannel; c < lastChannel; c++) {
+		for (uint32_t texel = 0; texel < 16; texel++) {
+			mean[c] += block.channels[c][texel];
+			min[c] = std::min(min[c], block.channels[c][texel]);
+			max[c] = std::max(max[c], block.channels[c][texel]);
+		}
+		mean[c] /= 16.0f;
+	}
+	for (auto c = 0u; c < 4; c++) {
+		if (c < firstChannel || c >= lastChannel) {
+			min[c] = max[c] = 0.0f;
+		}
+	}
+
+	// Single channels and flat blocks need no axis
+	if (channelCount == 1 || min == max) {
+		start = min;
+		end = max;
+		return;
+	}
+
+	// Covariance of texels around mean
+	glm::mat4 covariance(0.0f);
+	for (uint32_t texel = 0; texel < 16; texel++) {
+		glm::vec4 offset(0.0f);
+		for (auto c = firstChannel; c < lastChannel; c++) {
+			offset[c] = block.channels[c][texel] - mean[c];
+		}
+		covariance += glm::outerProduct(offset, offset);
+	}
+
+	// Principal axis by power iteration, starting along box diagonal
+	auto axis = max - min;
+	for (uint32_t i = 0; i < POWER_ITERATIONS; i++) {
+		auto next = covariance * axis;
+		auto length = glm::length(next);
+		if (length < 1e-6f) {
+			break;
+		}
+		axis = next / length;
+	}
+	axis = glm::normalize(axis);
+
+	// Furthest texels either way along axis
+	auto lowest = FLT_MAX;
+	auto highest = -FLT_MAX;
+	for (uint32_t texel = 0; texel < 16; texel++) {
+		auto projection = 0.0f;
+		for (auto c = firstChannel; c < lastChannel; c++) {
+			projection += (block.channels[c][texel] - mean[c]) * axis[c];
+		}
+		lowest = std::min(lowest, projection);
+		highest = std::max(highest, projection);
+	}
+	start = glm::clamp(mean + axis * lowest, 0.0f, 255.0f);
+	end = glm::clamp(mean + axis * highest, 0.0f, 255.0f);
+}
+
+// Least squares endpoints for fixed indices, weights give the share of end per index, false if indices do not constrain them
+bool BlockCompressor::RefineEndpoints(const Block& block, uint32_t firstChannel, uint32_t channelCount, const uint8_t* indices, const float* weights, glm::vec4& start, glm::vec4& end){
+	// Normal equations of texel = (1 - w) * start + w * end
+	auto startStart = 0.0f;
+	auto startEnd = 0.0f;
+	auto endEnd = 0.0f;
+	glm::vec4 startSum(0.0f);
+	glm::vec4 endSum(0.0f);
+	for (uint32_t texel = 0; texel < 16; texel++) {
+		auto weight = weights[indices[texel]];
+		startStart += (1.0f - weight) * (1.0f - weight);
+		startEnd += (1.0f - weight) * weight;
+		endEnd += weight * weight;
+		for (auto c = firstChannel; c < firstChannel + channelCount; c++) {
+			startSum[c] += (1.0f - weight) * block.channels[c][texel];
+			endSum[c] += weight * block.channels[c][texel];
+		}
+	}
+
+	// Singular when every texel uses the same weight
+	auto determinant = startStart * endEnd - startEnd * startEnd;
+	if (std::abs(determinant) < 1e-6f) {
+		return false;
+	}
+	start = glm::clamp((startSum * endEnd - endSum * startEnd) / determinant, 0.0f, 255.0f);
+	end = glm::clamp((endSum * startStart - startSum * startEnd) / determinant, 0.0f, 255.0f);
+	return true;
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+#include "../Core/ThreadPool.h"
+
+// Block compressed formats written by the encoder, every format encodes 4x4 texel blocks
+enum class BlockFormat {
+	BC1,	// RGB at 4 bits per texel, alpha is dropped
+	BC3,	// RGBA at 8 bits per texel, alpha interpolated separately from colour
+	BC5,	// Red and green at 8 bits per texel, for tangent space normal maps
+	BC7,	// RGBA at 8 bits per texel, highest quality
+};
+
+class BlockCompressor {
+public:
+	BlockCompressor(ThreadPool* threadPool = nullptr);	// Constructor, without a thread pool blocks are encoded on the calling thread
+	~BlockCompressor();	// Destructor
+
+	static constexpr uint32_t BLOCK_EXTENT = 4;				// Texels per side of a block
+	static constexpr uint32_t BLOCK_ROWS_PER_TASK = 8;		// Rows of blocks encoded by one task
+	static constexpr uint32_t REFINE_ITERATIONS = 2;		// Least squares endpoint refinements per block
+
+	// FUNCTIONS
+	std::vector<uint8_t> Compress(const uint8_t* texels, uint32_t width, uint32_t height, BlockFormat format);	// Encode tightly packed RGBA8 texels, partial blocks at edges repeat the last texel
+	static void CompressBlock(const uint8_t* texels, uint32_t stride, BlockFormat format, uint8_t* output);	// Encode 4x4 RGBA8 texels starting at texels, rows stride bytes apart
+	static VkFormat GetVkFormat(BlockFormat format, bool srgb);	// Vulkan format of encoded blocks, BC5 is never sRGB
+	static uint32_t GetBlockSize(BlockFormat format);	// Bytes per encoded block
+private:
+	// Texels of a block as channel planes, so four texels are handled per SIMD instruction
+	struct Block {
+		alignas(16) float channels[4][16];	// RGBA values in [0, 255] per texel
+	};
+
+	// VARIABLES
+	ThreadPool* m_ThreadPool;	// Worker threads encoding block rows, may be null
+
+	// FUNCTIONS
+	static void EncodeBC1(const Block& block, uint8_t* output);	// Colour block with two 565 endpoints and 2 bit indices
+	static void EncodeBC4(const Block& block, uint32_t channel, uint8_t* output);	// Single channel block with two 8 bit endpoints and 3 bit indices, BC3 alpha and BC5 channels
+	static void EncodeBC7(const Block& block, uint8_t* output);	// Mode 6 block, one RGBA subset with 7 bit endpoints, p-bits and 4 bit indices
+	static float FitIndices(const Block& block, uint32_t firstChannel, uint32_t channelCount, const glm::vec4* palette, uint32_t paletteSize, uint8_t* indices);	// Nearest palette entry per texel over channel range, returns squared error
+	static void FitEndpoints(const Block& block, uint32_t firstChannel, uint32_t channelCount, glm::vec4& start, glm::vec4& end);	// Extremes of texels along their principal axis over channel range
+	static bool RefineEndpoints(const Block& block, uint32_t firstChannel, uint32_t channelCount, const uint8_t* indices, const float* weights, glm::vec4& start, glm::vec4& end);	// Least squares endpoints for fixed indices, weights give the share of end per index, false if indices do not constrain them
+};
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+// KTX 2.0 texture container subset, little endian, written by TextureCooker and mapped by TextureFile
+//
+//   identifier
+//   Ktx2Header
+//   Ktx2Index
+//   Ktx2Level[levelCount], most detailed first
+//   data format descriptor
+//   level data, least detailed first
+//
+// Only single layer, single face 2D textures without supercompression are read or written.
+
+constexpr uint8_t KTX2_IDENTIFIER[12] = { 0xab, 'K', 'T', 'X', ' ', '2', '0', 0xbb, '\r', '\n', 0x1a, '\n' };	// «KTX 20»\r\n\x1A\n
+constexpr uint32_t KTX2_SUPERCOMPRESSION_NONE = 0;	// Level data stored as it is uploaded
+
+// Data format descriptor values describing block compressed formats
+constexpr uint32_t KTX2_DFD_VERSION = 2;			// Khronos data format specification 1.3 descriptor block
+constexpr uint32_t KTX2_DFD_MODEL_BC1A = 128;		// BC1 colour model
+constexpr uint32_t KTX2_DFD_MODEL_BC3 = 130;		// BC3 colour model
+constexpr uint32_t KTX2_DFD_MODEL_BC5 = 132;		// BC5 colour model
+constexpr uint32_t KTX2_DFD_MODEL_BC7 = 134;		// BC7 colour model
+constexpr uint32_t KTX2_DFD_PRIMARIES_BT709 = 1;	// sRGB primaries
+constexpr uint32_t KTX2_DFD_TRANSFER_LINEAR = 1;	// Values stored linear
+constexpr uint32_t KTX2_DFD_TRANSFER_SRGB = 2;		// Values stored with sRGB curve
+
+// Follows identifier
+struct Ktx2Header {
+	uint32_t vkFormat;					// VkFormat of level data
+	uint32_t typeSize;					// 1 for block compressed formats
+	uint32_t pixelWidth;				// Width of most detailed level
+	uint32_t pixelHeight;				// Height of most detailed level
+	uint32_t pixelDepth;				// Zero for 2D textures
+	uint32_t layerCount;				// Zero when not an array
+	uint32_t faceCount;					// One when not a cube map
+	uint32_t levelCount;				// Mip levels, zero asks loaders to generate them
+	uint32_t supercompressionScheme;	// KTX2_SUPERCOMPRESSION_NONE
+};
+
+// Follows header, offsets are from start of file
+struct Ktx2Index {
+	uint32_t dfdByteOffset;		// Offset of data format descriptor
+	uint32_t dfdByteLength;		// Bytes of data format descriptor
+	uint32_t kvdByteOffset;		// Offset of key value data
+	uint32_t kvdByteLength;		// Bytes of key value data
+	uint64_t sgdByteOffset;		// Offset of supercompression global data
+	uint64_t sgdByteLength;		// Bytes of supercompression global data
+};
+
+// Level index entry
+struct Ktx2Level {
+	uint64_t byteOffset;				// Offset of level data
+	uint64_t byteLength;				// Bytes of level data
+	uint64_t uncompressedByteLength;	// Bytes of level data once supercompression is undone
+};
+
+static_assert(sizeof(KTX2_IDENTIFIER) + sizeof(Ktx2Header) + sizeof(Ktx2Index) == 80 && sizeof(Ktx2Level) == 24, "KTX2 structs must match the specification!");
+static_assert(std::is_trivially_copyable_v<Ktx2Header> && std::is_trivially_copyable_v<Ktx2Index> && std::is_trivially_copyable_v<Ktx2Level>, "KTX2 structs are written byte for byte!");
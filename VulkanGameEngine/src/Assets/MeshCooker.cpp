@@ -0,0 +1,161 @@
+#include "MeshCooker.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include "MeshSimplifier.h"
+#include "ObjLoader.h"
+
+// Constructor
+MeshCooker::MeshCooker(uint32_t vertexCount, uint64_t layoutHash)
+: m_VertexCount(vertexCount), m_LayoutHash(layoutHash) {
+	// Throw error if mesh is empty
+	if (vertexCount == 0) {
+		throw std::runtime_error("Unable to cook mesh without vertices!");
+	}
+}
+
+// Destructor
+MeshCooker::~MeshCooker(){
+}
+
+// Add vertex stream, bound to the binding matching the order added
+void MeshCooker::AddStream(const void* data, uint32_t stride){
+	// Throw error if there are too many streams
+	if (m_Streams.size() == MESH_FILE_MAX_STREAMS) {
+		throw std::runtime_error("Unable to cook mesh with more than 16 vertex streams!");
+	}
+
+	// Copy stream bytes
+	auto bytes = static_cast<const uint8_t*>(data);
+	m_Streams.emplace_back(bytes, bytes + static_cast<size_t>(stride) * m_VertexCount);
+	m_Strides.emplace_back(stride);
+}
+
+// Append level of detail, most detailed first
+void MeshCooker::AddLod(const std::vector<uint32_t>& indices, float error){
+	// Throw error if an index addresses a missing vertex
+	if (std::any_of(indices.begin(), indices.end(), [this](uint32_t index) { return index >= m_VertexCount; })) {
+		throw std::runtime_error("Unable to cook mesh level of detail with index out of range!");
+	}
+
+	// Append indices behind previous levels
+	m_Lods.push_back({ static_cast<uint32_t>(m_Indices.size()), static_cast<uint32_t>(indices.size()), error, 0 });
+	m_Indices.insert(m_Indices.end(), indices.begin(), indices.end());
+}
+
+// Write container, indices are stored 16 bit when every vertex fits
+void MeshCooker::Write(const std::string& path) const {
+	// Throw error if there is nothing to read vertices from
+	if (m_Streams.empty()) {
+		throw std::runtime_error("Unable to cook mesh without vertex streams!");
+	}
+
+	auto align = [](uint64_t offset) { return (offset + MESH_FILE_ALIGNMENT - 1) / MESH_FILE_ALIGNMENT * MESH_FILE_ALIGNMENT; };
+	bool shortIndices = m_VertexCount <= 65536;
+
+	// Header and tables
+	MeshFileHeader header = {};
+	header.magic = MESH_FILE_MAGIC;
+	header.version = MESH_FILE_VERSION;
+	header.layoutHash = m_LayoutHash;
+	header.vertexCount = m_VertexCount;
+	header.streamCount = static_cast<uint32_t>(m_Streams.size());
+	header.lodCount = static_cast<uint32_t>(m_Lods.size());
+	header.indexType = shortIndices ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32;
+	header.indexCount = static_cast<uint32_t>(m_Indices.size());
+	std::memcpy(header.boundsMin, &m_Bounds.min, sizeof(header.boundsMin));
+	std::memcpy(header.boundsMax, &m_Bounds.max, sizeof(header.boundsMax));
+	std::memcpy(header.boundsCentre, &m_Bounds.centre, sizeof(header.boundsCentre));
+	header.boundsRadius = m_Bounds.radius;
+
+	// Lay out data blocks behind tables
+	uint64_t offset = sizeof(MeshFileHeader) + sizeof(MeshFileStream) * m_Streams.size() + sizeof(MeshFileLod) * m_Lods.size();
+	std::vector<MeshFileStream> streams(m_Streams.size());
+	for (size_t i = 0; i < m_Streams.size(); i++) {
+		offset = align(offset);
+		streams[i] = { m_Strides[i], 0, offset };
+		offset += m_Streams[i].size();
+	}
+	header.indexOffset = align(offset);
+	header.fileSize = header.indexOffset + m_Indices.size() * (shortIndices ? sizeof(uint16_t) : sizeof(uint32_t));
+
+	// Assemble file in memory, padding stays zero
+	std::vector<uint8_t> file(static_cast<size_t>(header.fileSize), 0);
+	auto tables = file.data() + sizeof(MeshFileHeader);
+	std::memcpy(file.data(), &header, sizeof(header));
+	std::memcpy(tables, streams.data(), sizeof(MeshFileStream) * streams.size());
+	std::memcpy(tables + sizeof(MeshFileStream) * streams.size(), m_Lods.data(), sizeof(MeshFileLod) * m_Lods.size());
+	for (size_t i = 0; i < m_Streams.size(); i++) {
+		std::memcpy(file.data() + streams[i].offset, m_Streams[i].data(), m_Streams[i].size());
+	}
+	if (shortIndices) {
+		std::vector<uint16_t> indices(m_Indices.begin(), m_Indices.end());
+		std::memcpy(file.data() + header.indexOffset, indices.data(), indices.size() * sizeof(uint16_t));
+	}
+	else {
+		std::memcpy(file.data() + header.indexOffset, m_Indices.data(), m_Indices.size() * sizeof(uint32_t));
+	}
+
+	// Write file
+	std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+	if (!stream.is_open()) {
+		throw std::runtime_error("Unable to open file " + path);
+	}
+	stream.write(reinterpret_cast<const char*>(file.data()), file.size());
+	if (!stream) {
+		throw std::runtime_error("Unable to write file " + path);
+	}
+}
+
+// Bounding box and sphere around positions
+MeshBounds MeshCooker::ComputeBounds(const std::vector<glm::vec3>& positions){
+	MeshBounds bounds;
+	if (positions.empty()) {
+		return bounds;
+	}
+
+	// Box around all positions
+	bounds.min = bounds.max = positions[0];
+	for (auto& position : positions) {
+		bounds.min = glm::min(bounds.min, position);
+		bounds.max = glm::max(bounds.max, position);
+	}
+
+	// Sphere around box centre reaching the furthest position
+	bounds.centre = (bounds.min + bounds.max) * 0.5f;
+	for (auto& position : positions) {
+		bounds.radius = std::max(bounds.radius, glm::length(position - bounds.centre));
+	}
+	return bounds;
+}
+
+// Cook OBJ file into an optimized single stream Vertex mesh with a level of detail chain
+MeshOptimizationReport MeshCooker::CookObj(const std::string& objPath, const std::string& meshPath, ThreadPool* threadPool){
+	// Parse and deduplicate OBJ
+	ObjLoader loader(threadPool);
+	auto mesh = loader.Load(objPath);
+
+	// Reorder for vertex cache, overdraw and fetch locality
+	auto report = MeshOptimizer::Optimize(mesh.vertices, mesh.indices);
+
+	// Gather positions for bounds and simplification
+	std::vector<glm::vec3> positions(mesh.vertices.size());
+	std::transform(mesh.vertices.begin(), mesh.vertices.end(), positions.begin(), [](const Vertex& vertex) { return vertex.GetPosition(); });
+
+	// Write Vertex stream matching StandardInput
+	MeshCooker cooker(static_cast<uint32_t>(mesh.vertices.size()), StandardInput::DESCRIPTION.hash);
+	cooker.AddStream(mesh.vertices.data(), sizeof(Vertex));
+	cooker.AddLod(mesh.indices);
+
+	// Append coarser levels sharing the vertex stream, each reordered for the vertex cache on its own
+	for (auto& lod : MeshSimplifier::GenerateLodChain(positions, mesh.indices)) {
+		MeshOptimizer::OptimizeVertexCache(lod.indices, static_cast<uint32_t>(mesh.vertices.size()));
+		cooker.AddLod(lod.indices, lod.error);
+	}
+	cooker.SetBounds(ComputeBounds(positions));
+	cooker.Write(meshPath);
+	return report;
+}
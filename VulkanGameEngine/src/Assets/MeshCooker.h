@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <string>
+#include <vector>
+
+#include "../Core/ThreadPool.h"
+#include "../Graphics/Mesh.h"
+#include "MeshFormat.h"
+#include "MeshOptimizer.h"
+
+class MeshCooker {
+public:
+	MeshCooker(uint32_t vertexCount, uint64_t layoutHash);	// Constructor, layout hash is the VertexInputDescription hash streams match
+	~MeshCooker();	// Destructor
+
+	// FUNCTIONS
+	void AddStream(const void* data, uint32_t stride);	// Add vertex stream, bound to the binding matching the order added
+	void AddLod(const std::vector<uint32_t>& indices, float error = 0.0f);	// Append level of detail, most detailed first
+	void Write(const std::string& path) const;	// Write container, indices are stored 16 bit when every vertex fits
+
+	static MeshBounds ComputeBounds(const std::vector<glm::vec3>& positions);	// Bounding box and sphere around positions
+	static MeshOptimizationReport CookObj(const std::string& objPath, const std::string& meshPath, ThreadPool* threadPool = nullptr);	// Cook OBJ file into an optimized single stream Vertex mesh with a level of detail chain
+
+	// SETTERS
+	void SetBounds(const MeshBounds& bounds) { m_Bounds = bounds; }
+private:
+	// VARIABLES
+	uint32_t m_VertexCount;		// Vertices in every stream
+	uint64_t m_LayoutHash;		// Vertex input streams were cooked for
+	MeshBounds m_Bounds = {};	// Object space bounds
+
+	std::vector<std::vector<uint8_t>> m_Streams;	// Vertex bytes per stream
+	std::vector<uint32_t> m_Strides;				// Bytes per vertex per stream
+	std::vector<uint32_t> m_Indices;				// Indices of all levels
+	std::vector<MeshFileLod> m_Lods;				// Levels of detail
+};
@@ -0,0 +1,73 @@
+#include "MeshFile.h"
+
+#include <cstring>
+#include <stdexcept>
+
+// Constructor
+MeshFile::MeshFile(const std::string& path)
+: m_File(std::make_unique<MappedFile>(path)) {
+	auto data = m_File->GetData();
+	auto size = static_cast<uint64_t>(m_File->GetSize());
+	auto fail = [&path](const std::string& reason) { throw std::runtime_error("Unable to load " + path + ", " + reason + "!"); };
+
+	// Check header, mappings are page aligned so tables can be read in place
+	if (size < sizeof(MeshFileHeader)) {
+		fail("file too small");
+	}
+	m_Header = reinterpret_cast<const MeshFileHeader*>(data);
+	if (m_Header->magic != MESH_FILE_MAGIC) {
+		fail("not a cooked mesh");
+	}
+	if (m_Header->version != MESH_FILE_VERSION) {
+		fail("cooked with version " + std::to_string(m_Header->version) + " instead of " + std::to_string(MESH_FILE_VERSION));
+	}
+	if (m_Header->fileSize != size) {
+		fail("file truncated");
+	}
+	if (m_Header->vertexCount == 0 || m_Header->streamCount == 0 || m_Header->streamCount > MESH_FILE_MAX_STREAMS) {
+		fail("invalid vertex streams");
+	}
+
+	// Check tables fit
+	auto streams = reinterpret_cast<const MeshFileStream*>(data + sizeof(MeshFileHeader));
+	auto lods = reinterpret_cast<const MeshFileLod*>(streams + m_Header->streamCount);
+	if (sizeof(MeshFileHeader) + sizeof(MeshFileStream) * m_Header->streamCount + sizeof(MeshFileLod) * static_cast<uint64_t>(m_Header->lodCount) > size) {
+		fail("tables exceed file");
+	}
+
+	// Check every stream lies inside the file and point into mapping
+	for (uint32_t i = 0; i < m_Header->streamCount; i++) {
+		auto streamSize = static_cast<uint64_t>(streams[i].stride) * m_Header->vertexCount;
+		if (streams[i].stride == 0 || streams[i].offset % MESH_FILE_ALIGNMENT != 0 || streams[i].offset + streamSize > size) {
+			fail("vertex stream exceeds file");
+		}
+		m_Streams.push_back({ data + streams[i].offset, streams[i].stride });
+	}
+
+	// Check index data lies inside the file
+	auto indexSize = m_Header->indexType == VK_INDEX_TYPE_UINT16 ? sizeof(uint16_t) : sizeof(uint32_t);
+	if (m_Header->indexType != VK_INDEX_TYPE_UINT16 && m_Header->indexType != VK_INDEX_TYPE_UINT32) {
+		fail("invalid index type");
+	}
+	if (m_Header->indexOffset % MESH_FILE_ALIGNMENT != 0 || m_Header->indexOffset + indexSize * static_cast<uint64_t>(m_Header->indexCount) > size) {
+		fail("index data exceeds file");
+	}
+
+	// Check levels of detail stay inside index data
+	for (uint32_t i = 0; i < m_Header->lodCount; i++) {
+		if (static_cast<uint64_t>(lods[i].firstIndex) + lods[i].indexCount > m_Header->indexCount) {
+			fail("level of detail exceeds index data");
+		}
+		m_Lods.push_back({ lods[i].firstIndex, lods[i].indexCount, lods[i].error });
+	}
+
+	// Copy bounds
+	std::memcpy(&m_Bounds.min, m_Header->boundsMin, sizeof(m_Header->boundsMin));
+	std::memcpy(&m_Bounds.max, m_Header->boundsMax, sizeof(m_Header->boundsMax));
+	std::memcpy(&m_Bounds.centre, m_Header->boundsCentre, sizeof(m_Header->boundsCentre));
+	m_Bounds.radius = m_Header->boundsRadius;
+}
+
+// Destructor
+MeshFile::~MeshFile(){
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+#include "../Core/MappedFile.h"
+#include "../Graphics/Mesh.h"
+#include "MeshFormat.h"
+
+class MeshFile {
+public:
+	MeshFile(const std::string& path);	// Constructor, maps cooked mesh and validates its tables, data is never parsed
+	~MeshFile();	// Destructor
+
+	// FUNCTIONS
+	void Prefetch() const { m_File->Prefetch(0, m_File->GetSize()); }	// Read whole file into memory, so uploading it does not wait on disk
+
+	// GETTERS
+	const uint64_t GetLayoutHash() const { return m_Header->layoutHash; }
+	const uint32_t GetVertexCount() const { return m_Header->vertexCount; }
+	const uint32_t GetIndexCount() const { return m_Header->indexCount; }
+	const VkIndexType GetIndexType() const { return static_cast<VkIndexType>(m_Header->indexType); }
+	const void* GetIndexData() const { return m_File->GetData() + m_Header->indexOffset; }
+	const std::vector<VertexStreamData>& GetStreams() const { return m_Streams; }
+	const std::vector<MeshLod>& GetLods() const { return m_Lods; }
+	const MeshBounds& GetBounds() const { return m_Bounds; }
+	const uint64_t GetSize() const { return m_File->GetSize(); }
+private:
+	// VARIABLES
+	std::unique_ptr<MappedFile> m_File;		// Mapped file, must outlive pointers handed out
+	const MeshFileHeader* m_Header;			// Header at start of mapping
+	std::vector<VertexStreamData> m_Streams;	// Stream pointers into mapping
+	std::vector<MeshLod> m_Lods;			// Levels of detail
+	MeshBounds m_Bounds;					// Object space bounds
+};
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+// Cooked mesh container, little endian, written by MeshCooker and mapped by MeshFile
+//
+//   MeshFileHeader
+//   MeshFileStream[streamCount]
+//   MeshFileLod[lodCount]
+//   vertex stream data, one block per stream
+//   index data, every level of detail back to back
+//
+// Data blocks start at multiples of MESH_FILE_ALIGNMENT so they are copied into staging memory as they are.
+
+constexpr uint32_t MESH_FILE_MAGIC = 0x4d454756;	// "VGEM"
+constexpr uint32_t MESH_FILE_VERSION = 1;			// Bumped on any layout change, older files must be recooked
+constexpr uint64_t MESH_FILE_ALIGNMENT = 256;		// Alignment of data blocks
+constexpr uint32_t MESH_FILE_MAX_STREAMS = 16;		// Most vertex streams a file may hold
+
+// Start of every cooked mesh
+struct MeshFileHeader {
+	uint32_t magic;			// MESH_FILE_MAGIC
+	uint32_t version;		// MESH_FILE_VERSION
+	uint64_t fileSize;		// Bytes in file, detects truncation
+	uint64_t layoutHash;	// VertexInputDescription hash the streams were cooked for
+	uint32_t vertexCount;	// Vertices in every stream
+	uint32_t streamCount;	// Vertex streams
+	uint32_t lodCount;		// Levels of detail
+	uint32_t indexType;		// VkIndexType of index data
+	uint32_t indexCount;	// Indices of all levels
+	uint32_t reserved;		// Zero
+	uint64_t indexOffset;	// Offset of index data
+	float boundsMin[3];		// Smallest corner of bounding box
+	float boundsMax[3];		// Largest corner of bounding box
+	float boundsCentre[3];	// Bounding sphere centre
+	float boundsRadius;		// Bounding sphere radius
+};
+
+// Vertex stream table entry
+struct MeshFileStream {
+	uint32_t stride;	// Bytes per vertex
+	uint32_t reserved;	// Zero
+	uint64_t offset;	// Offset of stream data, stride * vertexCount bytes
+};
+
+// Level of detail table entry, most detailed first
+struct MeshFileLod {
+	uint32_t firstIndex;	// First index of level
+	uint32_t indexCount;	// Indices of level
+	float error;			// Object space error against full detail
+	uint32_t reserved;		// Zero
+};
+
+static_assert(sizeof(MeshFileHeader) == 96 && sizeof(MeshFileStream) == 16 && sizeof(MeshFileLod) == 16, "Mesh file structs must not change size!");
+static_assert(std::is_trivially_copyable_v<MeshFileHeader> && std::is_trivially_copyable_v<MeshFileStream> && std::is_trivially_copyable_v<MeshFileLod>, "Mesh file structs are written byte for byte!");
@@ -0,0 +1,372 @@
+#include "MeshOptimizer.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iomanip>
+#include <numeric>
+#include <sstream>
+
+#include "../Core/Profiler.h"
+
+// Forsyth scoring constants
+constexpr float CACHE_DECAY_POWER = 1.5f;		// Falloff of score with cache position
+constexpr float LAST_TRIANGLE_SCORE = 0.75f;	// Score of vertices of the last triangle, low so strips do not run into dead ends
+constexpr float VALENCE_BOOST_SCALE = 2.0f;		// Weight of remaining triangle count
+constexpr float VALENCE_BOOST_POWER = 0.5f;		// Falloff of remaining triangle count, vertices with few triangles left are finished first
+
+// Run every pass on an indexed Vertex mesh, unreferenced vertices are dropped
+MeshOptimizationReport MeshOptimizer::Optimize(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices, float overdrawThreshold){
+	PROFILE_SCOPE("MeshOptimizer::Optimize");
+
+	MeshOptimizationReport report;
+	auto vertexCount = static_cast<uint32_t>(vertices.size());
+	report.cacheBefore = AnalyzeVertexCache(indices, vertexCount);
+	report.fetchBefore = AnalyzeVertexFetch(indices, vertexCount, sizeof(Vertex));
+
+	// Order triangles for the post-transform cache
+	OptimizeVertexCache(indices, vertexCount);
+
+	// Order cache friendly clusters for overdraw
+	std::vector<glm::vec3> positions(vertices.size());
+	std::transform(vertices.begin(), vertices.end(), positions.begin(), [](const Vertex& vertex) { return vertex.GetPosition(); });
+	OptimizeOverdraw(indices, positions, overdrawThreshold);
+
+	// Order vertices for fetch locality
+	std::vector<uint32_t> remap;
+	vertexCount = OptimizeVertexFetch(indices, vertexCount, remap);
+	vertices = RemapVertices(vertices, remap, vertexCount);
+
+	report.cacheAfter = AnalyzeVertexCache(indices, vertexCount);
+	report.fetchAfter = AnalyzeVertexFetch(indices, vertexCount, sizeof(Vertex));
+	return report;
+}
+
+// Reorder triangles for post-transform cache hits, Forsyth's linear speed algorithm
+void MeshOptimizer::OptimizeVertexCache(std::vector<uint32_t>& indices, uint32_t vertexCount){
+	PROFILE_SCOPE("MeshOptimizer::OptimizeVertexCache");
+
+	auto triangleCount = static_cast<uint32_t>(indices.size() / 3);
+	if (triangleCount == 0) {
+		return;
+	}
+
+	// Live triangles per vertex, packed as [offsets[v], offsets[v] + valence[v]) in adjacency
+	std::vector<uint32_t> valence(vertexCount, 0);
+	for (auto index : indices) {
+		valence[index]++;
+	}
+	std::vector<uint32_t> offsets(vertexCount + 1, 0);
+	std::partial_sum(valence.begin(), valence.end(), offsets.begin() + 1);
+	std::vector<uint32_t> adjacency(indices.size());
+	std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+	for (uint32_t i = 0; i < indices.size(); i++) {
+		adjacency[fill[indices[i]]++] = i / 3;
+	}
+
+	// Initial scores, nothing is cached yet
+	std::vector<int32_t> cachePositions(vertexCount, -1);
+	std::vector<float> vertexScores(vertexCount);
+	for (uint32_t v = 0; v < vertexCount; v++) {
+		vertexScores[v] = VertexScore(valence[v], -1);
+	}
+	std::vector<float> triangleScores(triangleCount);
+	for (uint32_t t = 0; t < triangleCount; t++) {
+		triangleScores[t] = vertexScores[indices[t * 3]] + vertexScores[indices[t * 3 + 1]] + vertexScores[indices[t * 3 + 2]];
+	}
+
+	// Changes score of vertex and every live triangle using it
+	auto rescore = [&](uint32_t v) {
+		auto score = VertexScore(valence[v], cachePositions[v]);
+		auto difference = score - vertexScores[v];
+		vertexScores[v] = score;
+		for (uint32_t i = offsets[v]; i < offsets[v] + valence[v]; i++) {
+			triangleScores[adjacency[i]] += difference;
+		}
+	};
+
+	std::vector<uint8_t> emitted(triangleCount, 0);
+	std::vector<uint32_t> result;
+	result.reserve(indices.size());
+	std::vector<uint32_t> cache, nextCache;
+	cache.reserve(OPTIMIZE_CACHE_SIZE + 3);
+	nextCache.reserve(OPTIMIZE_CACHE_SIZE + 3);
+	uint32_t scanCursor = 0;
+	int64_t best = -1;
+
+	for (uint32_t emittedCount = 0; emittedCount < triangleCount; emittedCount++) {
+		// No cached vertex has live triangles, continue with the next unemitted triangle in input order
+		if (best < 0) {
+			while (emitted[scanCursor]) {
+				scanCursor++;
+			}
+			best = scanCursor;
+		}
+
+		// Emit triangle and remove it from adjacency of its vertices
+		auto triangle = &indices[best * 3];
+		emitted[best] = 1;
+		for (uint32_t k = 0; k < 3; k++) {
+			auto v = triangle[k];
+			result.emplace_back(v);
+			auto begin = adjacency.begin() + offsets[v];
+			auto end = begin + valence[v];
+			*std::find(begin, end, static_cast<uint32_t>(best)) = *(end - 1);
+			valence[v]--;
+		}
+
+		// Move triangle vertices to front of LRU cache
+		nextCache.clear();
+		for (uint32_t k = 0; k < 3; k++) {
+			if (std::find(nextCache.begin(), nextCache.end(), triangle[k]) == nextCache.end()) {
+				nextCache.emplace_back(triangle[k]);
+			}
+		}
+		for (auto v : cache) {
+			if (v != triangle[0] && v != triangle[1] && v != triangle[2]) {
+				nextCache.emplace_back(v);
+			}
+		}
+
+		// Rescore vertices falling out of cache
+		for (size_t i = OPTIMIZE_CACHE_SIZE; i < nextCache.size(); i++) {
+			cachePositions[nextCache[i]] = -1;
+			rescore(nextCache[i]);
+		}
+		nextCache.resize(std::min<size_t>(nextCache.size(), OPTIMIZE_CACHE_SIZE));
+		std::swap(cache, nextCache);
+
+		// Rescore cached vertices, their triangles are the candidates for the next step
+		for (uint32_t i = 0; i < cache.size(); i++) {
+			cachePositions[cache[i]] = static_cast<int32_t>(i);
+			rescore(cache[i]);
+		}
+
+		// Pick best live triangle touching the cache
+		best = -1;
+		auto bestScore = -1.0f;
+		for (auto v : cache) {
+			for (uint32_t i = offsets[v]; i < offsets[v] + valence[v]; i++) {
+				if (triangleScores[adjacency[i]] > bestScore) {
+					bestScore = triangleScores[adjacency[i]];
+					best = adjacency[i];
+				}
+			}
+		}
+	}
+
+	indices.swap(result);
+}
+
+// Sort cache friendly clusters outside in so occluders draw first, Tipsy style
+void MeshOptimizer::OptimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<glm::vec3>& positions, float threshold){
+	PROFILE_SCOPE("MeshOptimizer::OptimizeOverdraw");
+
+	auto triangleCount = static_cast<uint32_t>(indices.size() / 3);
+	if (triangleCount == 0) {
+		return;
+	}
+
+	// FIFO cache simulated with timestamps, counts misses of a triangle
+	std::vector<uint32_t> timestamps(positions.size(), 0);
+	uint32_t time = ANALYZE_CACHE_SIZE + 1;
+	auto misses = [&](uint32_t t) {
+		uint32_t count = 0;
+		for (uint32_t k = 0; k < 3; k++) {
+			auto v = indices[t * 3 + k];
+			if (time - timestamps[v] > ANALYZE_CACHE_SIZE) {
+				timestamps[v] = time++;
+				count++;
+			}
+		}
+		return count;
+	};
+
+	// Hard boundaries where all three vertices miss, the optimized order restarts there anyway
+	std::vector<uint32_t> hardClusters;
+	uint32_t totalMisses = 0;
+	for (uint32_t t = 0; t < triangleCount; t++) {
+		auto count = misses(t);
+		if (count == 3) {
+			hardClusters.emplace_back(t);
+		}
+		totalMisses += count;
+	}
+	hardClusters.emplace_back(triangleCount);
+
+	// Soft boundaries inside hard clusters once their ACMR from a cold cache is close to the whole mesh's
+	auto targetAcmr = threshold * totalMisses / triangleCount;
+	std::vector<uint32_t> clusters;
+	for (size_t c = 0; c + 1 < hardClusters.size(); c++) {
+		auto start = hardClusters[c];
+		auto end = hardClusters[c + 1];
+		clusters.emplace_back(start);
+
+		time += ANALYZE_CACHE_SIZE + 1;
+		uint32_t clusterMisses = 0;
+		for (auto t = start; t < end; t++) {
+			clusterMisses += misses(t);
+			if (t + 1 < end && static_cast<float>(clusterMisses) / (t - start + 1) <= targetAcmr) {
+				clusters.emplace_back(t + 1);
+				time += ANALYZE_CACHE_SIZE + 1;
+				clusterMisses = 0;
+				start = t + 1;
+			}
+		}
+	}
+	clusters.emplace_back(triangleCount);
+
+	// Mesh centroid from referenced vertices
+	glm::dvec3 meshCentroid(0.0);
+	for (auto index : indices) {
+		meshCentroid += glm::dvec3(positions[index]);
+	}
+	auto centre = glm::vec3(meshCentroid / static_cast<double>(indices.size()));
+
+	// Sort key of cluster, how far its area weighted centroid lies out along its average normal
+	auto clusterCount = clusters.size() - 1;
+	std::vector<float> keys(clusterCount);
+	for (size_t c = 0; c < clusterCount; c++) {
+		glm::vec3 centroid(0.0f), normal(0.0f);
+		float area = 0.0f;
+		for (auto t = clusters[c]; t < clusters[c + 1]; t++) {
+			auto& p0 = positions[indices[t * 3]];
+			auto& p1 = positions[indices[t * 3 + 1]];
+			auto& p2 = positions[indices[t * 3 + 2]];
+			auto cross = glm::cross(p1 - p0, p2 - p0);
+			auto triangleArea = glm::length(cross);
+			centroid += (p0 + p1 + p2) * (triangleArea / 3.0f);
+			normal += cross;
+			area += triangleArea;
+		}
+		auto normalLength = glm::length(normal);
+		keys[c] = area > 0.0f && normalLength > 0.0f ? glm::dot(centroid / area - centre, normal / normalLength) : 0.0f;
+	}
+
+	// Draw outermost clusters first
+	std::vector<uint32_t> order(clusterCount);
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(), [&keys](uint32_t a, uint32_t b) { return keys[a] > keys[b]; });
+
+	std::vector<uint32_t> result;
+	result.reserve(indices.size());
+	for (auto c : order) {
+		result.insert(result.end(), indices.begin() + clusters[c] * 3, indices.begin() + clusters[c + 1] * 3);
+	}
+	indices.swap(result);
+}
+
+// Renumber vertices in order of first use, returns referenced vertex count
+uint32_t MeshOptimizer::OptimizeVertexFetch(std::vector<uint32_t>& indices, uint32_t vertexCount, std::vector<uint32_t>& remap){
+	PROFILE_SCOPE("MeshOptimizer::OptimizeVertexFetch");
+
+	remap.assign(vertexCount, UNUSED_VERTEX);
+	uint32_t next = 0;
+	for (auto& index : indices) {
+		if (remap[index] == UNUSED_VERTEX) {
+			remap[index] = next++;
+		}
+		index = remap[index];
+	}
+	return next;
+}
+
+// Simulate FIFO post-transform cache
+VertexCacheStats MeshOptimizer::AnalyzeVertexCache(const std::vector<uint32_t>& indices, uint32_t vertexCount, uint32_t cacheSize){
+	VertexCacheStats stats;
+	auto triangleCount = indices.size() / 3;
+	if (triangleCount == 0) {
+		return stats;
+	}
+
+	// Timestamps of vertex entering cache, older than cache size means evicted
+	std::vector<uint32_t> timestamps(vertexCount, 0);
+	std::vector<uint8_t> referenced(vertexCount, 0);
+	uint32_t time = cacheSize + 1;
+	uint32_t referencedCount = 0;
+	for (auto index : indices) {
+		if (time - timestamps[index] > cacheSize) {
+			timestamps[index] = time++;
+			stats.transformedVertices++;
+		}
+		if (!referenced[index]) {
+			referenced[index] = 1;
+			referencedCount++;
+		}
+	}
+
+	stats.acmr = static_cast<float>(stats.transformedVertices) / triangleCount;
+	stats.atvr = static_cast<float>(stats.transformedVertices) / referencedCount;
+	return stats;
+}
+
+// Simulate FIFO vertex memory cache
+VertexFetchStats MeshOptimizer::AnalyzeVertexFetch(const std::vector<uint32_t>& indices, uint32_t vertexCount, uint32_t vertexStride){
+	VertexFetchStats stats;
+	if (indices.empty()) {
+		return stats;
+	}
+
+	// Timestamps of line entering cache, older than cache size means evicted
+	auto lineCount = (static_cast<uint64_t>(vertexCount) * vertexStride + FETCH_CACHE_LINE - 1) / FETCH_CACHE_LINE;
+	std::vector<uint32_t> timestamps(static_cast<size_t>(lineCount), 0);
+	std::vector<uint8_t> referenced(vertexCount, 0);
+	uint32_t time = FETCH_CACHE_LINES + 1;
+	uint64_t referencedBytes = 0;
+	for (auto index : indices) {
+		// Fetch every line vertex touches
+		auto first = static_cast<uint64_t>(index) * vertexStride / FETCH_CACHE_LINE;
+		auto last = (static_cast<uint64_t>(index) * vertexStride + vertexStride - 1) / FETCH_CACHE_LINE;
+		for (auto line = first; line <= last; line++) {
+			if (time - timestamps[line] > FETCH_CACHE_LINES) {
+				timestamps[line] = time++;
+				stats.bytesFetched += FETCH_CACHE_LINE;
+			}
+		}
+		if (!referenced[index]) {
+			referenced[index] = 1;
+			referencedBytes += vertexStride;
+		}
+	}
+
+	stats.overfetch = static_cast<float>(static_cast<double>(stats.bytesFetched) / referencedBytes);
+	return stats;
+}
+
+// Single line summary of ACMR, ATVR and overfetch before and after
+std::string MeshOptimizer::FormatReport(const MeshOptimizationReport& report){
+	std::ostringstream stream;
+	stream << std::fixed << std::setprecision(3);
+	stream << "ACMR " << report.cacheBefore.acmr << " -> " << report.cacheAfter.acmr;
+	stream << ", ATVR " << report.cacheBefore.atvr << " -> " << report.cacheAfter.atvr;
+	stream << ", overfetch " << report.fetchBefore.overfetch << " -> " << report.fetchAfter.overfetch;
+	return stream.str();
+}
+
+// Forsyth score of vertex, higher is emitted sooner
+float MeshOptimizer::VertexScore(uint32_t valence, int32_t cachePosition){
+	// Score tables, cache positions and small valences cover nearly every lookup
+	static const auto cacheScores = []() {
+		std::array<float, OPTIMIZE_CACHE_SIZE> scores = {};
+		for (uint32_t i = 0; i < OPTIMIZE_CACHE_SIZE; i++) {
+			scores[i] = i < 3 ? LAST_TRIANGLE_SCORE : std::pow(1.0f - static_cast<float>(i - 3) / (OPTIMIZE_CACHE_SIZE - 3), CACHE_DECAY_POWER);
+		}
+		return scores;
+	}();
+	static const auto valenceScores = []() {
+		std::array<float, 64> scores = {};
+		for (uint32_t i = 1; i < scores.size(); i++) {
+			scores[i] = VALENCE_BOOST_SCALE * std::pow(static_cast<float>(i), -VALENCE_BOOST_POWER);
+		}
+		return scores;
+	}();
+
+	// Finished vertices never attract triangles
+	if (valence == 0) {
+		return -1.0f;
+	}
+
+	auto score = cachePosition >= 0 ? cacheScores[cachePosition] : 0.0f;
+	score += valence < valenceScores.size() ? valenceScores[valence] : VALENCE_BOOST_SCALE * std::pow(static_cast<float>(valence), -VALENCE_BOOST_POWER);
+	return score;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <string>
+#include <vector>
+
+#include "../Graphics/Vertex.h"
+
+// Post-transform cache efficiency of an index buffer
+struct VertexCacheStats {
+	uint32_t transformedVertices = 0;	// Vertex shader invocations with a simulated FIFO cache
+	float acmr = 0.0f;					// Average cache miss ratio, transformed vertices per triangle, 0.5 is ideal for grids
+	float atvr = 0.0f;					// Average transformed to vertex ratio, transformed vertices per referenced vertex, 1 is ideal
+};
+
+// Pre-transform fetch efficiency of an index buffer
+struct VertexFetchStats {
+	uint64_t bytesFetched = 0;	// Bytes read from vertex memory with a simulated cache
+	float overfetch = 0.0f;		// Bytes fetched per byte of referenced vertices, 1 is ideal
+};
+
+// Statistics around an optimization run
+struct MeshOptimizationReport {
+	VertexCacheStats cacheBefore;	// Cache efficiency of input order
+	VertexCacheStats cacheAfter;	// Cache efficiency of optimized order
+	VertexFetchStats fetchBefore;	// Fetch efficiency of input order
+	VertexFetchStats fetchAfter;	// Fetch efficiency of optimized order
+};
+
+class MeshOptimizer {
+public:
+	static constexpr uint32_t OPTIMIZE_CACHE_SIZE = 32;		// LRU cache size vertex cache optimization targets
+	static constexpr uint32_t ANALYZE_CACHE_SIZE = 16;		// FIFO cache size statistics and overdraw clustering simulate
+	static constexpr uint32_t FETCH_CACHE_LINE = 64;		// Bytes per simulated vertex memory cache line
+	static constexpr uint32_t FETCH_CACHE_LINES = 64;		// Lines held by simulated vertex memory cache
+	static constexpr float DEFAULT_OVERDRAW_THRESHOLD = 1.05f;	// Cluster ACMR allowed relative to whole mesh when splitting for overdraw
+	static constexpr uint32_t UNUSED_VERTEX = UINT32_MAX;		// Remap entry of a vertex no triangle references
+
+	// FUNCTIONS
+	static MeshOptimizationReport Optimize(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices, float overdrawThreshold = DEFAULT_OVERDRAW_THRESHOLD);	// Run every pass on an indexed Vertex mesh, unreferenced vertices are dropped
+	static void OptimizeVertexCache(std::vector<uint32_t>& indices, uint32_t vertexCount);	// Reorder triangles for post-transform cache hits, Forsyth's linear speed algorithm
+	static void OptimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<glm::vec3>& positions, float threshold = DEFAULT_OVERDRAW_THRESHOLD);	// Sort cache friendly clusters outside in so occluders draw first, Tipsy style
+	static uint32_t OptimizeVertexFetch(std::vector<uint32_t>& indices, uint32_t vertexCount, std::vector<uint32_t>& remap);	// Renumber vertices in order of first use, returns referenced vertex count
+	static VertexCacheStats AnalyzeVertexCache(const std::vector<uint32_t>& indices, uint32_t vertexCount, uint32_t cacheSize = ANALYZE_CACHE_SIZE);	// Simulate FIFO post-transform cache
+	static VertexFetchStats AnalyzeVertexFetch(const std::vector<uint32_t>& indices, uint32_t vertexCount, uint32_t vertexStride);	// Simulate FIFO vertex memory cache
+	static std::string FormatReport(const MeshOptimizationReport& report);	// Single line summary of ACMR, ATVR and overfetch before and after
+
+	// Reorder vertices with remap table from OptimizeVertexFetch, unreferenced vertices are dropped
+	template<typename VertexType>
+	static std::vector<VertexType> RemapVertices(const std::vector<VertexType>& vertices, const std::vector<uint32_t>& remap, uint32_t vertexCount) {
+		// Invert remap so vertices are appended in their new order
+		std::vector<uint32_t> order(vertexCount);
+		for (uint32_t i = 0; i < remap.size(); i++) {
+			if (remap[i] != UNUSED_VERTEX) {
+				order[remap[i]] = i;
+			}
+		}
+
+		std::vector<VertexType> remapped;
+		remapped.reserve(vertexCount);
+		for (auto index : order) {
+			remapped.emplace_back(vertices[index]);
+		}
+		return remapped;
+	}
+private:
+	// FUNCTIONS
+	static float VertexScore(uint32_t valence, int32_t cachePosition);	// Forsyth score of vertex, higher is emitted sooner
+};
@@ -0,0 +1,353 @@
+#include "MeshSimplifier.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <tuple>
+
+#include "../Core/Profiler.h"
+
+// Constructor
+MeshSimplifier::MeshSimplifier(const std::vector<glm::vec3>& positions, const std::vector<uint32_t>& indices)
+: m_Positions(positions) {
+	WeldPositions();
+
+	// Keep triangles with three distinct positions, degenerate ones carry no area to preserve
+	m_Indices.reserve(indices.size());
+	for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+		auto w0 = m_Welds[indices[i]], w1 = m_Welds[indices[i + 1]], w2 = m_Welds[indices[i + 2]];
+		if (w0 != w1 && w1 != w2 && w0 != w2) {
+			m_Indices.insert(m_Indices.end(), indices.begin() + i, indices.begin() + i + 3);
+		}
+	}
+
+	LockBoundaries();
+	ComputeQuadrics();
+}
+
+// Destructor
+MeshSimplifier::~MeshSimplifier(){
+}
+
+// Collapse edges until target reached or no collapse stays below max error, returns error of result
+float MeshSimplifier::Simplify(uint32_t targetIndexCount, float maxError){
+	PROFILE_SCOPE("MeshSimplifier::Simplify");
+
+	// Each pass collapses an independent set of edges, repeat until none are left
+	while (m_Indices.size() > targetIndexCount) {
+		if (CollapsePass(targetIndexCount, maxError) == 0) {
+			break;
+		}
+	}
+	return m_Error;
+}
+
+// Successively coarser levels, full detail is not included
+std::vector<SimplifiedLod> MeshSimplifier::GenerateLodChain(const std::vector<glm::vec3>& positions, const std::vector<uint32_t>& indices, uint32_t maxLods, float ratio){
+	PROFILE_SCOPE("MeshSimplifier::GenerateLodChain");
+
+	// Continue simplifying the same mesh so quadrics and errors accumulate across levels
+	MeshSimplifier simplifier(positions, indices);
+	std::vector<SimplifiedLod> lods;
+	auto previousCount = static_cast<uint32_t>(indices.size());
+	while (lods.size() + 1 < maxLods) {
+		// Stop once levels get too small to be worth a draw
+		auto target = static_cast<uint32_t>(previousCount / 3 * ratio) * 3;
+		if (target / 3 < MIN_LOD_TRIANGLES) {
+			break;
+		}
+
+		// Stop once locked borders and seams keep the mesh from shrinking
+		auto error = simplifier.Simplify(target);
+		auto& simplified = simplifier.GetIndices();
+		if (simplified.size() > previousCount * MIN_LOD_REDUCTION) {
+			break;
+		}
+
+		lods.push_back({ simplified, error });
+		previousCount = static_cast<uint32_t>(simplified.size());
+	}
+	return lods;
+}
+
+// Map vertices sharing a position onto the first of them
+void MeshSimplifier::WeldPositions(){
+	// Sort vertices by position, equal positions end up next to each other
+	std::vector<uint32_t> order(m_Positions.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b) {
+		auto& pa = m_Positions[a];
+		auto& pb = m_Positions[b];
+		return std::tie(pa.x, pa.y, pa.z, a) < std::tie(pb.x, pb.y, pb.z, b);
+	});
+
+	// First vertex of each run of equal positions is its weld
+	m_Welds.resize(m_Positions.size());
+	for (size_t i = 0; i < order.size(); i++) {
+		m_Welds[order[i]] = i > 0 && m_Positions[order[i]] == m_Positions[order[i - 1]] ? m_Welds[order[i - 1]] : order[i];
+	}
+}
+
+// Lock welded vertices on open edges or with more than one vertex
+void MeshSimplifier::LockBoundaries(){
+	auto vertexCount = m_Positions.size();
+	m_Locked.assign(vertexCount, 0);
+
+	// Attribute seams, a welded vertex standing for several vertices could not pick one to collapse onto
+	for (uint32_t v = 0; v < vertexCount; v++) {
+		if (m_Welds[v] != v) {
+			m_Locked[m_Welds[v]] = 1;
+		}
+	}
+
+	// Directed edges leaving each welded vertex, packed as [offsets[w], offsets[w + 1]) in targets
+	std::vector<uint32_t> offsets(vertexCount + 1, 0);
+	for (auto index : m_Indices) {
+		offsets[m_Welds[index] + 1]++;
+	}
+	std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+	std::vector<uint32_t> targets(m_Indices.size());
+	std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+	for (size_t i = 0; i < m_Indices.size(); i += 3) {
+		for (size_t k = 0; k < 3; k++) {
+			targets[fill[m_Welds[m_Indices[i + k]]]++] = m_Welds[m_Indices[i + (k + 1) % 3]];
+		}
+	}
+
+	// Edge without its opposite belongs to one triangle only, both ends lie on a border
+	for (uint32_t a = 0; a < vertexCount; a++) {
+		for (auto i = offsets[a]; i < offsets[a + 1]; i++) {
+			auto b = targets[i];
+			if (std::find(targets.begin() + offsets[b], targets.begin() + offsets[b + 1], a) == targets.begin() + offsets[b + 1]) {
+				m_Locked[a] = 1;
+				m_Locked[b] = 1;
+			}
+		}
+	}
+}
+
+// Accumulate area weighted triangle planes per welded vertex
+void MeshSimplifier::ComputeQuadrics(){
+	m_Quadrics.assign(m_Positions.size(), Quadric());
+	for (size_t i = 0; i < m_Indices.size(); i += 3) {
+		// Plane through triangle, weighted by area so slivers barely count
+		glm::dvec3 p0(m_Positions[m_Indices[i]]), p1(m_Positions[m_Indices[i + 1]]), p2(m_Positions[m_Indices[i + 2]]);
+		auto normal = glm::cross(p1 - p0, p2 - p0);
+		auto length = glm::length(normal);
+		if (length == 0.0) {
+			continue;
+		}
+		normal /= length;
+
+		Quadric plane;
+		plane.AddPlane(normal, -glm::dot(normal, p0), length * 0.5);
+		for (size_t k = 0; k < 3; k++) {
+			m_Quadrics[m_Welds[m_Indices[i + k]]].Add(plane);
+		}
+	}
+}
+
+// Collapse independent cheapest edges, returns collapses done
+uint32_t MeshSimplifier::CollapsePass(uint32_t targetIndexCount, float maxError){
+	PROFILE_SCOPE("MeshSimplifier::CollapsePass");
+
+	auto vertexCount = static_cast<uint32_t>(m_Positions.size());
+	BuildAdjacency();
+
+	// Cheapest valid collapse of each unlocked vertex onto a neighbour, an unlocked vertex is its own weld
+	std::vector<uint32_t> targets(vertexCount, UINT32_MAX);
+	std::vector<double> costs(vertexCount, DBL_MAX);
+	std::vector<uint32_t> removals(vertexCount, 0);
+	std::vector<std::pair<double, uint32_t>> options;
+	for (uint32_t from = 0; from < vertexCount; from++) {
+		if (m_Locked[from] || m_Welds[from] != from || m_Offsets[from] == m_Offsets[from + 1]) {
+			continue;
+		}
+
+		// Cost of moving onto every neighbour
+		options.clear();
+		for (auto i = m_Offsets[from]; i < m_Offsets[from + 1]; i++) {
+			for (size_t k = 0; k < 3; k++) {
+				auto to = m_Indices[m_Adjacency[i] * 3 + k];
+				if (to != from && std::none_of(options.begin(), options.end(), [to](const std::pair<double, uint32_t>& option) { return option.second == to; })) {
+					auto quadric = m_Quadrics[from];
+					quadric.Add(m_Quadrics[m_Welds[to]]);
+					options.emplace_back(quadric.Evaluate(m_Positions[to]), to);
+				}
+			}
+		}
+
+		// Keep cheapest that neither flips nor pinches the surface
+		std::sort(options.begin(), options.end());
+		for (auto& option : options) {
+			if (CheckCollapse(from, option.second, removals[from])) {
+				costs[from] = option.first;
+				targets[from] = option.second;
+				break;
+			}
+		}
+	}
+
+	// Cheapest collapses first, errors are compared squared
+	auto maxCost = static_cast<double>(maxError) * maxError;
+	std::vector<uint32_t> order;
+	for (uint32_t v = 0; v < vertexCount; v++) {
+		if (targets[v] != UINT32_MAX && costs[v] <= maxCost) {
+			order.emplace_back(v);
+		}
+	}
+	std::sort(order.begin(), order.end(), [&costs](uint32_t a, uint32_t b) { return costs[a] < costs[b]; });
+
+	// Only collapses as cheap as the cheapest of those still needed, each removing about two triangles, so cheaper ones freed up by the next pass win over expensive ones now
+	auto needed = (m_Indices.size() - std::min<size_t>(m_Indices.size(), targetIndexCount) + 5) / 6;
+	if (needed < order.size()) {
+		auto limit = costs[order[std::max<size_t>(needed, 1) - 1]];
+		order.erase(std::upper_bound(order.begin(), order.end(), limit, [&costs](double cost, uint32_t v) { return cost < costs[v]; }), order.end());
+	}
+
+	// Collapse while one-rings stay disjoint, so checks made against the current triangles remain valid
+	std::vector<uint8_t> touched(vertexCount, 0);
+	std::vector<uint32_t> remap(vertexCount);
+	std::iota(remap.begin(), remap.end(), 0);
+	auto indexCount = m_Indices.size();
+	uint32_t collapses = 0;
+	for (auto from : order) {
+		auto to = targets[from];
+		auto weld = m_Welds[to];
+		if (touched[from] || touched[weld]) {
+			continue;
+		}
+
+		// Freeze one-ring for rest of pass
+		for (auto i = m_Offsets[from]; i < m_Offsets[from + 1]; i++) {
+			auto triangle = &m_Indices[m_Adjacency[i] * 3];
+			for (size_t k = 0; k < 3; k++) {
+				touched[m_Welds[triangle[k]]] = 1;
+			}
+		}
+
+		// Collapse and merge quadrics
+		remap[from] = to;
+		m_Quadrics[weld].Add(m_Quadrics[from]);
+		m_Error = std::max(m_Error, static_cast<float>(std::sqrt(costs[from])));
+		collapses++;
+
+		// Stop once target is reached
+		indexCount -= removals[from] * 3;
+		if (indexCount <= targetIndexCount) {
+			break;
+		}
+	}
+
+	// Apply collapses and drop triangles that lost an edge
+	size_t write = 0;
+	for (size_t i = 0; i < m_Indices.size(); i += 3) {
+		auto i0 = remap[m_Indices[i]], i1 = remap[m_Indices[i + 1]], i2 = remap[m_Indices[i + 2]];
+		if (m_Welds[i0] != m_Welds[i1] && m_Welds[i1] != m_Welds[i2] && m_Welds[i0] != m_Welds[i2]) {
+			m_Indices[write++] = i0;
+			m_Indices[write++] = i1;
+			m_Indices[write++] = i2;
+		}
+	}
+	m_Indices.resize(write);
+	return collapses;
+}
+
+// Rebuild triangles around each welded vertex
+void MeshSimplifier::BuildAdjacency(){
+	m_Offsets.assign(m_Positions.size() + 1, 0);
+	for (auto index : m_Indices) {
+		m_Offsets[m_Welds[index] + 1]++;
+	}
+	std::partial_sum(m_Offsets.begin(), m_Offsets.end(), m_Offsets.begin());
+	m_Adjacency.resize(m_Indices.size());
+	std::vector<uint32_t> fill(m_Offsets.begin(), m_Offsets.end() - 1);
+	for (uint32_t i = 0; i < m_Indices.size(); i++) {
+		m_Adjacency[fill[m_Welds[m_Indices[i]]]++] = i / 3;
+	}
+}
+
+// Welded vertices sharing a triangle with welded vertex
+void MeshSimplifier::GatherNeighbours(uint32_t weld, std::vector<uint32_t>& neighbours) const {
+	neighbours.clear();
+	for (auto i = m_Offsets[weld]; i < m_Offsets[weld + 1]; i++) {
+		for (size_t k = 0; k < 3; k++) {
+			auto neighbour = m_Welds[m_Indices[m_Adjacency[i] * 3 + k]];
+			if (neighbour != weld && std::find(neighbours.begin(), neighbours.end(), neighbour) == neighbours.end()) {
+				neighbours.emplace_back(neighbour);
+			}
+		}
+	}
+}
+
+// Check collapse keeps surface valid, counts triangles it removes
+bool MeshSimplifier::CheckCollapse(uint32_t from, uint32_t to, uint32_t& removed){
+	auto weld = m_Welds[to];
+
+	// Reject collapse if a remaining triangle around vertex would flip
+	removed = 0;
+	for (auto i = m_Offsets[from]; i < m_Offsets[from + 1]; i++) {
+		auto triangle = &m_Indices[m_Adjacency[i] * 3];
+		if (m_Welds[triangle[0]] == weld || m_Welds[triangle[1]] == weld || m_Welds[triangle[2]] == weld) {
+			removed++;
+			continue;
+		}
+
+		glm::vec3 before[3], after[3];
+		for (size_t k = 0; k < 3; k++) {
+			before[k] = m_Positions[triangle[k]];
+			after[k] = triangle[k] == from ? m_Positions[to] : before[k];
+		}
+		auto normalBefore = glm::cross(before[1] - before[0], before[2] - before[0]);
+		auto normalAfter = glm::cross(after[1] - after[0], after[2] - after[0]);
+		if (glm::dot(normalBefore, normalAfter) <= 0.0f) {
+			return false;
+		}
+	}
+
+	// Reject collapse if ends share neighbours beyond the triangles on their edge, it would pinch the surface into a fin
+	GatherNeighbours(from, m_FromNeighbours);
+	GatherNeighbours(weld, m_ToNeighbours);
+	auto shared = std::count_if(m_FromNeighbours.begin(), m_FromNeighbours.end(), [this](uint32_t neighbour) {
+		return std::find(m_ToNeighbours.begin(), m_ToNeighbours.end(), neighbour) != m_ToNeighbours.end();
+	});
+	return shared == removed;
+}
+
+// Add plane n.p + d = 0
+void MeshSimplifier::Quadric::AddPlane(const glm::dvec3& normal, double distance, double planeWeight){
+	a00 += planeWeight * normal.x * normal.x;
+	a01 += planeWeight * normal.x * normal.y;
+	a02 += planeWeight * normal.x * normal.z;
+	a03 += planeWeight * normal.x * distance;
+	a11 += planeWeight * normal.y * normal.y;
+	a12 += planeWeight * normal.y * normal.z;
+	a13 += planeWeight * normal.y * distance;
+	a22 += planeWeight * normal.z * normal.z;
+	a23 += planeWeight * normal.z * distance;
+	a33 += planeWeight * distance * distance;
+	weight += planeWeight;
+}
+
+// Add quadric of other vertex
+void MeshSimplifier::Quadric::Add(const Quadric& other){
+	a00 += other.a00; a01 += other.a01; a02 += other.a02; a03 += other.a03;
+	a11 += other.a11; a12 += other.a12; a13 += other.a13;
+	a22 += other.a22; a23 += other.a23;
+	a33 += other.a33;
+	weight += other.weight;
+}
+
+// Weighted mean squared distance of position to planes
+double MeshSimplifier::Quadric::Evaluate(const glm::vec3& position) const {
+	if (weight == 0.0) {
+		return 0.0;
+	}
+
+	double x = position.x, y = position.y, z = position.z;
+	auto distance = a00 * x * x + 2.0 * (a01 * x * y + a02 * x * z + a03 * x)
+		+ a11 * y * y + 2.0 * (a12 * y * z + a13 * y)
+		+ a22 * z * z + 2.0 * a23 * z
+		+ a33;
+	return std::max(distance, 0.0) / weight;
+}
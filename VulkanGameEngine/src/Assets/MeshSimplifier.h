@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cfloat>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+// Simplified level of detail of a mesh
+struct SimplifiedLod {
+	std::vector<uint32_t> indices;	// Triangles of level, indexing the original vertices
+	float error = 0.0f;				// Object space error against full detail
+};
+
+// Quadric error metric edge collapse, vertices collapse onto a neighbour so every level shares the original vertex buffer
+class MeshSimplifier {
+public:
+	MeshSimplifier(const std::vector<glm::vec3>& positions, const std::vector<uint32_t>& indices);	// Constructor, positions are indexed by vertex
+	~MeshSimplifier();	// Destructor
+
+	static constexpr uint32_t MAX_LODS = 8;				// Most levels generated including full detail
+	static constexpr float DEFAULT_LOD_RATIO = 0.5f;	// Triangles kept per level relative to the previous one
+	static constexpr uint32_t MIN_LOD_TRIANGLES = 64;	// Levels below this are not worth a draw of their own
+	static constexpr float MIN_LOD_REDUCTION = 0.9f;	// Chain stops once a level keeps more than this share of the previous one
+
+	// FUNCTIONS
+	float Simplify(uint32_t targetIndexCount, float maxError = FLT_MAX);	// Collapse edges until target reached or no collapse stays below max error, returns error of result
+	static std::vector<SimplifiedLod> GenerateLodChain(const std::vector<glm::vec3>& positions, const std::vector<uint32_t>& indices, uint32_t maxLods = MAX_LODS, float ratio = DEFAULT_LOD_RATIO);	// Successively coarser levels, full detail is not included
+
+	// GETTERS
+	const std::vector<uint32_t>& GetIndices() const { return m_Indices; }
+	const float GetError() const { return m_Error; }
+private:
+	// Sum of squared distances to weighted planes, symmetric 4x4 matrix stored as its upper triangle
+	struct Quadric {
+		double a00 = 0.0, a01 = 0.0, a02 = 0.0, a03 = 0.0;
+		double a11 = 0.0, a12 = 0.0, a13 = 0.0;
+		double a22 = 0.0, a23 = 0.0;
+		double a33 = 0.0;
+		double weight = 0.0;	// Sum of plane weights
+
+		void AddPlane(const glm::dvec3& normal, double distance, double planeWeight);	// Add plane n.p + d = 0
+		void Add(const Quadric& other);	// Add quadric of other vertex
+		double Evaluate(const glm::vec3& position) const;	// Weighted mean squared distance of position to planes
+	};
+
+	// VARIABLES
+	std::vector<glm::vec3> m_Positions;	// Vertex positions
+	std::vector<uint32_t> m_Welds;		// First vertex with equal position, vertices split by attributes share topology through it
+	std::vector<uint8_t> m_Locked;		// Per welded vertex, set on borders and attribute seams which are never collapsed away
+	std::vector<Quadric> m_Quadrics;	// Per welded vertex
+	std::vector<uint32_t> m_Indices;	// Current triangles
+	float m_Error = 0.0f;				// Largest collapse error so far
+
+	std::vector<uint32_t> m_Offsets;		// Triangles around welded vertex w are [m_Offsets[w], m_Offsets[w + 1]) in m_Adjacency
+	std::vector<uint32_t> m_Adjacency;		// Triangle indices grouped by welded vertex
+	std::vector<uint32_t> m_FromNeighbours;	// Scratch neighbours of collapsing vertex
+	std::vector<uint32_t> m_ToNeighbours;	// Scratch neighbours of collapse target
+
+	// FUNCTIONS
+	void WeldPositions();		// Map vertices sharing a position onto the first of them
+	void LockBoundaries();		// Lock welded vertices on open edges or with more than one vertex
+	void ComputeQuadrics();		// Accumulate area weighted triangle planes per welded vertex
+	uint32_t CollapsePass(uint32_t targetIndexCount, float maxError);	// Collapse independent cheapest edges, returns collapses done
+	void BuildAdjacency();		// Rebuild triangles around each welded vertex
+	void GatherNeighbours(uint32_t weld, std::vector<uint32_t>& neighbours) const;	// Welded vertices sharing a triangle with welded vertex
+	bool CheckCollapse(uint32_t from, uint32_t to, uint32_t& removed);	// Check collapse keeps surface valid, counts triangles it removes
+};
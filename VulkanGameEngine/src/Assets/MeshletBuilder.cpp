@@ -0,0 +1,198 @@
+#include "MeshletBuilder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+#include "../Core/Profiler.h"
+
+// Cone spread past which a cluster faces too many ways to ever be backfacing
+constexpr float MIN_CONE_SPREAD = 0.1f;
+
+// Split triangles into clusters grown over shared vertices, index order should already be cache optimized
+MeshletData MeshletBuilder::Build(const std::vector<uint32_t>& indices, const std::vector<glm::vec3>& positions, uint32_t maxVertices, uint32_t maxTriangles){
+	PROFILE_SCOPE("MeshletBuilder::Build");
+
+	// Throw error if limits do not fit 8 bit local indices
+	if (maxVertices < 3 || maxVertices > 255 || maxTriangles == 0) {
+		throw std::runtime_error("Unable to build meshlets, vertex limit must be in [3, 255] and triangle limit above zero!");
+	}
+
+	auto vertexCount = static_cast<uint32_t>(positions.size());
+	auto triangleCount = static_cast<uint32_t>(indices.size() / 3);
+
+	// Triangles around each vertex, packed as [offsets[v], offsets[v + 1]) in adjacency
+	std::vector<uint32_t> offsets(vertexCount + 1, 0);
+	for (auto index : indices) {
+		offsets[index + 1]++;
+	}
+	std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+	std::vector<uint32_t> adjacency(triangleCount * 3);
+	std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+	for (uint32_t i = 0; i < triangleCount * 3; i++) {
+		adjacency[fill[indices[i]]++] = i / 3;
+	}
+
+	MeshletData data;
+	data.vertices.reserve(indices.size() / 2);
+	data.triangles.reserve(indices.size());
+	std::vector<uint8_t> localIndices(vertexCount, UINT8_MAX);	// Position of vertex in current cluster
+	std::vector<uint8_t> used(triangleCount, 0);
+	Meshlet current = {};
+
+	// Close current cluster and start an empty one
+	auto finish = [&]() {
+		if (current.triangleCount == 0) {
+			return;
+		}
+		for (auto i = current.vertexOffset; i < current.vertexOffset + current.vertexCount; i++) {
+			localIndices[data.vertices[i]] = UINT8_MAX;
+		}
+		data.meshlets.emplace_back(current);
+		current = { static_cast<uint32_t>(data.vertices.size()), static_cast<uint32_t>(data.triangles.size()), 0, 0 };
+	};
+
+	// Best unused triangle around vertex, the one with most corners already in cluster
+	int64_t best = -1;
+	uint32_t bestShared = 0;
+	auto consider = [&](uint32_t vertex) {
+		for (auto i = offsets[vertex]; i < offsets[vertex + 1]; i++) {
+			auto triangle = adjacency[i];
+			if (used[triangle]) {
+				continue;
+			}
+			uint32_t shared = 0;
+			for (uint32_t k = 0; k < 3; k++) {
+				shared += localIndices[indices[triangle * 3 + k]] != UINT8_MAX;
+			}
+			if (best < 0 || shared > bestShared || (shared == bestShared && triangle < best)) {
+				best = triangle;
+				bestShared = shared;
+			}
+		}
+	};
+
+	uint32_t scanCursor = 0;
+	int64_t lastTriangle = -1;
+	for (uint32_t emitted = 0; emitted < triangleCount; emitted++) {
+		// Grow from last triangle, then from anywhere in cluster, else continue in index order
+		best = -1;
+		if (lastTriangle >= 0) {
+			for (uint32_t k = 0; k < 3; k++) {
+				consider(indices[lastTriangle * 3 + k]);
+			}
+			for (auto i = current.vertexOffset; best < 0 && i < current.vertexOffset + current.vertexCount; i++) {
+				consider(data.vertices[i]);
+			}
+		}
+		if (best < 0) {
+			while (used[scanCursor]) {
+				scanCursor++;
+			}
+			best = scanCursor;
+		}
+
+		// Start new cluster if triangle does not fit
+		auto triangle = &indices[best * 3];
+		uint32_t newVertices = 0;
+		for (uint32_t k = 0; k < 3; k++) {
+			bool repeated = (k > 0 && triangle[k] == triangle[0]) || (k > 1 && triangle[k] == triangle[1]);
+			newVertices += localIndices[triangle[k]] == UINT8_MAX && !repeated;
+		}
+		if (current.vertexCount + newVertices > maxVertices || current.triangleCount == maxTriangles) {
+			finish();
+		}
+
+		// Add triangle, giving new corners a local index
+		for (uint32_t k = 0; k < 3; k++) {
+			if (localIndices[triangle[k]] == UINT8_MAX) {
+				localIndices[triangle[k]] = static_cast<uint8_t>(current.vertexCount++);
+				data.vertices.emplace_back(triangle[k]);
+			}
+			data.triangles.emplace_back(localIndices[triangle[k]]);
+		}
+		current.triangleCount++;
+		used[best] = 1;
+		lastTriangle = best;
+	}
+	finish();
+
+	// Culling bounds per cluster
+	data.bounds.reserve(data.meshlets.size());
+	for (auto& meshlet : data.meshlets) {
+		data.bounds.emplace_back(ComputeBounds(data, meshlet, positions));
+	}
+	return data;
+}
+
+// Bounding sphere and normal cone of cluster
+MeshletBounds MeshletBuilder::ComputeBounds(const MeshletData& data, const Meshlet& meshlet, const std::vector<glm::vec3>& positions){
+	MeshletBounds bounds;
+	auto corner = [&](uint32_t triangle, uint32_t k) {
+		return positions[data.vertices[meshlet.vertexOffset + data.triangles[meshlet.triangleOffset + triangle * 3 + k]]];
+	};
+
+	// Sphere around box centre reaching the furthest vertex
+	auto min = positions[data.vertices[meshlet.vertexOffset]];
+	auto max = min;
+	for (auto i = meshlet.vertexOffset; i < meshlet.vertexOffset + meshlet.vertexCount; i++) {
+		min = glm::min(min, positions[data.vertices[i]]);
+		max = glm::max(max, positions[data.vertices[i]]);
+	}
+	bounds.centre = (min + max) * 0.5f;
+	for (auto i = meshlet.vertexOffset; i < meshlet.vertexOffset + meshlet.vertexCount; i++) {
+		bounds.radius = std::max(bounds.radius, glm::length(positions[data.vertices[i]] - bounds.centre));
+	}
+	bounds.coneApex = bounds.centre;
+
+	// Unit normals of triangles with area, front faces wound counter-clockwise in object space as in OBJ files
+	std::vector<glm::vec3> normals;
+	normals.reserve(meshlet.triangleCount);
+	glm::vec3 axis(0.0f);
+	for (uint32_t t = 0; t < meshlet.triangleCount; t++) {
+		auto normal = glm::cross(corner(t, 1) - corner(t, 0), corner(t, 2) - corner(t, 0));
+		auto length = glm::length(normal);
+		normals.emplace_back(length > 0.0f ? normal / length : glm::vec3(0.0f));
+		axis += normals.back();
+	}
+
+	// Clusters without a dominant facing are never backface culled
+	auto axisLength = glm::length(axis);
+	if (axisLength == 0.0f) {
+		return bounds;
+	}
+	axis /= axisLength;
+	auto minDot = 1.0f;
+	for (auto& normal : normals) {
+		if (normal != glm::vec3(0.0f)) {
+			minDot = std::min(minDot, glm::dot(axis, normal));
+		}
+	}
+	if (minDot <= MIN_CONE_SPREAD) {
+		return bounds;
+	}
+
+	// Move apex back along axis until every triangle plane lies in front of it
+	auto maxT = 0.0f;
+	for (uint32_t t = 0; t < meshlet.triangleCount; t++) {
+		if (normals[t] != glm::vec3(0.0f)) {
+			maxT = std::max(maxT, glm::dot(bounds.centre - corner(t, 0), normals[t]) / glm::dot(axis, normals[t]));
+		}
+	}
+	bounds.coneApex = bounds.centre - axis * maxT;
+	bounds.coneAxis = axis;
+	bounds.coneCutoff = std::sqrt(1.0f - minDot * minDot);
+	return bounds;
+}
+
+// Mesh indices of every cluster back to back, each cluster starting at its triangleOffset
+std::vector<uint32_t> MeshletBuilder::Flatten(const MeshletData& data){
+	std::vector<uint32_t> indices(data.triangles.size());
+	for (auto& meshlet : data.meshlets) {
+		for (auto i = meshlet.triangleOffset; i < meshlet.triangleOffset + meshlet.triangleCount * 3; i++) {
+			indices[i] = data.vertices[meshlet.vertexOffset + data.triangles[i]];
+		}
+	}
+	return indices;
+}
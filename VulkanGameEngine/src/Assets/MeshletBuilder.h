@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+// Cluster of triangles sharing a small vertex set
+struct Meshlet {
+	uint32_t vertexOffset;		// First entry in MeshletData::vertices
+	uint32_t triangleOffset;	// First entry in MeshletData::triangles, three per triangle
+	uint32_t vertexCount;		// Unique vertices of cluster
+	uint32_t triangleCount;		// Triangles of cluster
+};
+
+// Culling bounds of a cluster in object space
+struct MeshletBounds {
+	glm::vec3 centre = glm::vec3(0.0f);		// Bounding sphere centre
+	float radius = 0.0f;					// Bounding sphere radius
+	glm::vec3 coneApex = glm::vec3(0.0f);	// Apex of normal cone, viewers inside the cone behind it see only back faces
+	glm::vec3 coneAxis = glm::vec3(0.0f);	// Average facing of cluster
+	float coneCutoff = 1.0f;				// Cluster is backfacing if dot(normalize(coneApex - camera), coneAxis) >= coneCutoff, 1 never culls
+};
+
+// Clusters of an indexed mesh
+struct MeshletData {
+	std::vector<Meshlet> meshlets;			// Clusters
+	std::vector<uint32_t> vertices;			// Mesh vertex index per cluster vertex
+	std::vector<uint8_t> triangles;			// Cluster local vertex index per triangle corner
+	std::vector<MeshletBounds> bounds;		// Culling bounds per cluster
+};
+
+class MeshletBuilder {
+public:
+	static constexpr uint32_t MAX_VERTICES = 64;	// Cluster vertex limit
+	static constexpr uint32_t MAX_TRIANGLES = 124;	// Cluster triangle limit, keeps local indices of a cluster within 372 bytes
+
+	// FUNCTIONS
+	static MeshletData Build(const std::vector<uint32_t>& indices, const std::vector<glm::vec3>& positions, uint32_t maxVertices = MAX_VERTICES, uint32_t maxTriangles = MAX_TRIANGLES);	// Split triangles into clusters grown over shared vertices, index order should already be cache optimized
+	static MeshletBounds ComputeBounds(const MeshletData& data, const Meshlet& meshlet, const std::vector<glm::vec3>& positions);	// Bounding sphere and normal cone of cluster
+	static std::vector<uint32_t> Flatten(const MeshletData& data);	// Mesh indices of every cluster back to back, each cluster starting at its triangleOffset
+};
@@ -0,0 +1,285 @@
+#define TINYOBJLOADER_IMPLEMENTATION
+#include "ObjLoader.h"
+
+#include <algorithm>
+#include <fstream>
+#include <istream>
+#include <stdexcept>
+#include <streambuf>
+
+#include "../Core/Profiler.h"
+
+// Read only stream buffer over a slice of memory, lets tinyobjloader parse without copying
+class MemoryBuffer : public std::streambuf {
+public:
+	MemoryBuffer(const char* begin, const char* end) {
+		auto data = const_cast<char*>(begin);
+		setg(data, data, data + (end - begin));
+	}
+};
+
+// Constructor
+ObjLoader::ObjLoader(ThreadPool* threadPool)
+: m_ThreadPool(threadPool) {
+}
+
+// Destructor
+ObjLoader::~ObjLoader(){
+}
+
+// Parse OBJ file into deduplicated indexed triangles, polygons are fan triangulated
+ObjMesh ObjLoader::Load(const std::string& path){
+	PROFILE_SCOPE("ObjLoader::Load");
+
+	// Read whole file, slices are parsed straight from memory
+	auto text = ReadFile(path);
+
+	// Parse slices in parallel
+	auto chunks = SplitChunks(text, false);
+	RunChunks(chunks, [&path](Chunk& chunk) { ParseChunk(chunk, path); });
+
+	// Negative indices count back from attributes of their own slice, parse as a single slice instead
+	if (chunks.size() > 1 && std::any_of(chunks.begin(), chunks.end(), [](const Chunk& chunk) { return chunk.relativeIndices; })) {
+		chunks = SplitChunks(text, true);
+		ParseChunk(chunks[0], path);
+	}
+
+	// Concatenate attributes so faces can reference any slice
+	auto attributes = MergeAttributes(chunks);
+
+	// Triangulate faces and hash their corners in parallel
+	RunChunks(chunks, [&attributes](Chunk& chunk) { TriangulateChunk(chunk, attributes); });
+
+	// Merge equal vertices
+	auto mesh = Deduplicate(chunks, attributes);
+
+	// Throw error if there is nothing to draw
+	if (mesh.indices.empty()) {
+		throw std::runtime_error("Unable to load " + path + ", file has no faces!");
+	}
+	return mesh;
+}
+
+// Run function on every chunk, in parallel if a thread pool exists
+void ObjLoader::RunChunks(std::vector<Chunk>& chunks, const std::function<void(Chunk&)>& function){
+	// Run serially without workers or with a single slice
+	if (!m_ThreadPool || chunks.size() == 1) {
+		for (auto& chunk : chunks) {
+			function(chunk);
+		}
+		return;
+	}
+
+	// Queue a task per slice, Wait rethrows the first task error
+	for (auto& chunk : chunks) {
+		auto target = &chunk;
+		m_ThreadPool->Enqueue([target, &function]() { function(*target); });
+	}
+	m_ThreadPool->Wait();
+}
+
+// Split text into line aligned slices
+std::vector<ObjLoader::Chunk> ObjLoader::SplitChunks(const std::string& text, bool single) const {
+	// Enough slices to keep every worker busy, none smaller than MIN_CHUNK_SIZE
+	size_t chunkCount = 1;
+	if (!single && m_ThreadPool) {
+		chunkCount = std::clamp<size_t>(text.size() / MIN_CHUNK_SIZE, 1, static_cast<size_t>(m_ThreadPool->GetThreadCount()) * CHUNKS_PER_THREAD);
+	}
+
+	// Cut at even offsets, each moved past the next line break so no line is split
+	std::vector<Chunk> chunks;
+	auto begin = text.data();
+	auto end = text.data() + text.size();
+	for (size_t i = 0; i < chunkCount && (begin != end || chunks.empty()); i++) {
+		auto chunkEnd = end;
+		if (i + 1 < chunkCount) {
+			chunkEnd = std::find(std::max(begin, text.data() + text.size() * (i + 1) / chunkCount), end, '\n');
+			chunkEnd = chunkEnd == end ? end : chunkEnd + 1;
+		}
+
+		chunks.emplace_back();
+		chunks.back().begin = begin;
+		chunks.back().end = chunkEnd;
+		begin = chunkEnd;
+	}
+	return chunks;
+}
+
+// Read whole file into memory
+std::string ObjLoader::ReadFile(const std::string& path){
+	// Open file in binary
+	std::ifstream file(path, std::ios::ate | std::ios::binary);
+
+	// Check if file was able to open
+	if (!file.is_open()) {
+		throw std::runtime_error("Unable to open file " + path);
+	}
+
+	// Get filesize and read contents
+	std::string text(static_cast<size_t>(file.tellg()), '\0');
+	file.seekg(0);
+	file.read(&text[0], text.size());
+	return text;
+}
+
+// Parse slice with tinyobjloader
+void ObjLoader::ParseChunk(Chunk& chunk, const std::string& path){
+	PROFILE_SCOPE("ObjLoader::ParseChunk");
+
+	// Look for negative face indices, only face lines are scanned past their first character
+	for (auto line = chunk.begin; line < chunk.end && !chunk.relativeIndices;) {
+		auto lineEnd = std::find(line, chunk.end, '\n');
+		auto first = std::find_if(line, lineEnd, [](char c) { return c != ' ' && c != '\t'; });
+		if (first + 1 < lineEnd && first[0] == 'f' && (first[1] == ' ' || first[1] == '\t')) {
+			chunk.relativeIndices = std::find(first, lineEnd, '-') != lineEnd;
+		}
+		line = lineEnd + (lineEnd != chunk.end ? 1 : 0);
+	}
+
+	// Parse without triangulating, which would need positions of other slices
+	MemoryBuffer buffer(chunk.begin, chunk.end);
+	std::istream stream(&buffer);
+	std::vector<tinyobj::material_t> materials;
+	std::string warning, error;
+	if (!tinyobj::LoadObj(&chunk.attributes, &chunk.shapes, &materials, &warning, &error, &stream, nullptr, false, true)) {
+		throw std::runtime_error("Unable to parse " + path + ", " + error);
+	}
+}
+
+// Fan triangulate faces of slice and hash their corners
+void ObjLoader::TriangulateChunk(Chunk& chunk, const Attributes& attributes){
+	PROFILE_SCOPE("ObjLoader::TriangulateChunk");
+
+	auto positionCount = attributes.positions.size() / 3;
+	auto texcoordCount = attributes.texcoords.size() / 2;
+
+	for (auto& shape : chunk.shapes) {
+		// Convert corners of shape, checking indices against every slice's attributes
+		std::vector<Corner> corners(shape.mesh.indices.size());
+		for (size_t i = 0; i < corners.size(); i++) {
+			auto& index = shape.mesh.indices[i];
+			if (index.vertex_index < 0 || static_cast<size_t>(index.vertex_index) >= positionCount || (index.texcoord_index >= 0 && static_cast<size_t>(index.texcoord_index) >= texcoordCount)) {
+				throw std::runtime_error("Unable to load OBJ, face index out of range!");
+			}
+			corners[i].position = static_cast<uint32_t>(index.vertex_index);
+			corners[i].texcoord = index.texcoord_index;
+			corners[i].hash = MakeVertex(attributes, corners[i]).Hash();
+		}
+
+		// Fan out from first corner of each face, exact for convex polygons
+		size_t first = 0;
+		for (auto faceSize : shape.mesh.num_face_vertices) {
+			for (size_t k = 1; k + 1 < faceSize; k++) {
+				chunk.corners.emplace_back(corners[first]);
+				chunk.corners.emplace_back(corners[first + k]);
+				chunk.corners.emplace_back(corners[first + k + 1]);
+			}
+			first += faceSize;
+		}
+	}
+
+	// Faces are no longer needed
+	std::vector<tinyobj::shape_t>().swap(chunk.shapes);
+}
+
+// Concatenate attributes of slices in file order
+ObjLoader::Attributes ObjLoader::MergeAttributes(std::vector<Chunk>& chunks){
+	PROFILE_SCOPE("ObjLoader::MergeAttributes");
+
+	// Reserve total sizes
+	Attributes attributes;
+	size_t positionSize = 0, texcoordSize = 0;
+	for (auto& chunk : chunks) {
+		positionSize += chunk.attributes.vertices.size();
+		texcoordSize += chunk.attributes.texcoords.size();
+	}
+	attributes.positions.reserve(positionSize);
+	attributes.colours.reserve(positionSize);
+	attributes.texcoords.reserve(texcoordSize);
+
+	// Append each slice and release its copy
+	for (auto& chunk : chunks) {
+		auto& source = chunk.attributes;
+		attributes.positions.insert(attributes.positions.end(), source.vertices.begin(), source.vertices.end());
+		attributes.texcoords.insert(attributes.texcoords.end(), source.texcoords.begin(), source.texcoords.end());
+
+		// Vertex colours are padded with white by tinyobjloader, guard against a short array anyway
+		source.colors.resize(source.vertices.size(), 1.0f);
+		attributes.colours.insert(attributes.colours.end(), source.colors.begin(), source.colors.end());
+		source = tinyobj::attrib_t();
+	}
+	return attributes;
+}
+
+// Merge equal vertices with an open addressing table
+ObjMesh ObjLoader::Deduplicate(const std::vector<Chunk>& chunks, const Attributes& attributes){
+	PROFILE_SCOPE("ObjLoader::Deduplicate");
+
+	ObjMesh mesh;
+	size_t cornerCount = 0;
+	for (auto& chunk : chunks) {
+		cornerCount += chunk.corners.size();
+	}
+	mesh.indices.reserve(cornerCount);
+
+	// Power of two table sized for roughly one vertex per position, linear probing
+	size_t capacity = 16;
+	while (capacity < attributes.positions.size() / 3 * 2) {
+		capacity *= 2;
+	}
+	std::vector<uint32_t> slots(capacity, EMPTY_SLOT);
+	std::vector<uint64_t> hashes;	// Hash per unique vertex, rehashes without rebuilding vertices
+
+	for (auto& chunk : chunks) {
+		for (auto& corner : chunk.corners) {
+			// Double table at half load so probes stay short
+			if ((mesh.vertices.size() + 1) * 2 > capacity) {
+				capacity *= 2;
+				slots.assign(capacity, EMPTY_SLOT);
+				for (uint32_t i = 0; i < hashes.size(); i++) {
+					auto slot = hashes[i] & (capacity - 1);
+					while (slots[slot] != EMPTY_SLOT) {
+						slot = (slot + 1) & (capacity - 1);
+					}
+					slots[slot] = i;
+				}
+			}
+
+			// Probe until an equal vertex or an empty slot is found
+			auto vertex = MakeVertex(attributes, corner);
+			auto slot = corner.hash & (capacity - 1);
+			auto index = EMPTY_SLOT;
+			while (slots[slot] != EMPTY_SLOT) {
+				auto candidate = slots[slot];
+				if (hashes[candidate] == corner.hash && mesh.vertices[candidate] == vertex) {
+					index = candidate;
+					break;
+				}
+				slot = (slot + 1) & (capacity - 1);
+			}
+
+			// Insert new vertex into empty slot
+			if (index == EMPTY_SLOT) {
+				index = static_cast<uint32_t>(mesh.vertices.size());
+				slots[slot] = index;
+				mesh.vertices.emplace_back(vertex);
+				hashes.emplace_back(corner.hash);
+			}
+			mesh.indices.emplace_back(index);
+		}
+	}
+	return mesh;
+}
+
+// Build vertex referenced by corner
+Vertex ObjLoader::MakeVertex(const Attributes& attributes, const Corner& corner){
+	auto position = &attributes.positions[corner.position * 3];
+	auto colour = &attributes.colours[corner.position * 3];
+
+	// OBJ texture coordinates start at the bottom, Vulkan samples from the top
+	glm::vec2 uv(0.0f);
+	if (corner.texcoord >= 0) {
+		uv = glm::vec2(attributes.texcoords[corner.texcoord * 2], 1.0f - attributes.texcoords[corner.texcoord * 2 + 1]);
+	}
+	return Vertex(glm::vec3(position[0], position[1], position[2]), glm::vec3(colour[0], colour[1], colour[2]), uv);
+}
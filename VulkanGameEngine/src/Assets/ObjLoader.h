@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <tinyobjloader/tiny_obj_loader.h>
+#include <vector>
+
+#include "../Core/ThreadPool.h"
+#include "../Graphics/Vertex.h"
+
+// Indexed triangle mesh ready for Graphics::AddMesh
+struct ObjMesh {
+	std::vector<Vertex> vertices;	// Unique vertices in order of first use
+	std::vector<uint32_t> indices;	// Triangle list indices into vertices
+};
+
+class ObjLoader {
+public:
+	ObjLoader(ThreadPool* threadPool = nullptr);	// Constructor, without a thread pool files are parsed on the calling thread
+	~ObjLoader();	// Destructor
+
+	static constexpr size_t MIN_CHUNK_SIZE = 4 * 1024 * 1024;	// Smallest slice of a file parsed by one task
+	static constexpr uint32_t CHUNKS_PER_THREAD = 2;			// Slices per worker so uneven slices still balance
+
+	// FUNCTIONS
+	ObjMesh Load(const std::string& path);	// Parse OBJ file into deduplicated indexed triangles, polygons are fan triangulated
+private:
+	// Face corner referencing merged attributes
+	struct Corner {
+		uint32_t position;	// Position and colour index
+		int32_t texcoord;	// Texture coordinate index, -1 if none
+		uint64_t hash;		// Hash of vertex built from corner
+	};
+
+	// Line aligned slice of a file parsed independently, faces use absolute indices so slices only share attribute arrays
+	struct Chunk {
+		const char* begin = nullptr;			// First byte of slice
+		const char* end = nullptr;				// One past last byte of slice
+		bool relativeIndices = false;			// True if faces use negative indices, which only resolve inside the slice defining them
+		tinyobj::attrib_t attributes;			// Attributes defined in slice
+		std::vector<tinyobj::shape_t> shapes;	// Faces defined in slice
+		std::vector<Corner> corners;			// Triangulated face corners
+	};
+
+	// Attributes of all slices concatenated in file order
+	struct Attributes {
+		std::vector<float> positions;	// xyz per position
+		std::vector<float> colours;		// rgb per position, white if file has none
+		std::vector<float> texcoords;	// uv per texture coordinate
+	};
+
+	static constexpr uint32_t EMPTY_SLOT = UINT32_MAX;	// Marks unused slot of deduplication table
+
+	// VARIABLES
+	ThreadPool* m_ThreadPool;	// Worker threads, null parses serially
+
+	// FUNCTIONS
+	void RunChunks(std::vector<Chunk>& chunks, const std::function<void(Chunk&)>& function);	// Run function on every chunk, in parallel if a thread pool exists
+	std::vector<Chunk> SplitChunks(const std::string& text, bool single) const;	// Split text into line aligned slices
+	static std::string ReadFile(const std::string& path);	// Read whole file into memory
+	static void ParseChunk(Chunk& chunk, const std::string& path);	// Parse slice with tinyobjloader
+	static void TriangulateChunk(Chunk& chunk, const Attributes& attributes);	// Fan triangulate faces of slice and hash their corners
+	static Attributes MergeAttributes(std::vector<Chunk>& chunks);	// Concatenate attributes of slices in file order
+	static ObjMesh Deduplicate(const std::vector<Chunk>& chunks, const Attributes& attributes);	// Merge equal vertices with an open addressing table
+	static Vertex MakeVertex(const Attributes& attributes, const Corner& corner);	// Build vertex referenced by corner
+};
@@ -0,0 +1,179 @@
+#include "TextureCooker.h"
+
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include "../Core/Profiler.h"
+#include "../Graphics/Image.h"
+#include "TextureLoader.h"
+
+// Constructor
+TextureCooker::TextureCooker(VkExtent2D extent, VkFormat format)
+: m_Extent(extent), m_Format(format) {
+	// Throw error if level sizes cannot be checked
+	if (extent.width == 0 || extent.height == 0 || Image::GetBlockSize(format) == 0) {
+		throw std::runtime_error("Unable to cook texture of unsupported format or empty extent!");
+	}
+}
+
+// Destructor
+TextureCooker::~TextureCooker(){
+}
+
+// Append tightly packed mip level, most detailed first
+void TextureCooker::AddLevel(const std::vector<uint8_t>& data){
+	// Throw error if level does not match its extent
+	auto level = static_cast<uint32_t>(m_Levels.size());
+	if (level == Image::GetMipLevelCount(m_Extent) || data.size() != Image::GetLevelSize(m_Format, m_Extent, level)) {
+		throw std::runtime_error("Unable to cook texture level of wrong size!");
+	}
+	m_Levels.push_back(data);
+}
+
+// Write KTX2 container with a data format descriptor for BC formats
+void TextureCooker::Write(const std::string& path) const {
+	// Throw error if there is nothing to sample
+	if (m_Levels.empty()) {
+		throw std::runtime_error("Unable to cook texture without levels!");
+	}
+
+	auto align = [](uint64_t offset) { return (offset + LEVEL_ALIGNMENT - 1) / LEVEL_ALIGNMENT * LEVEL_ALIGNMENT; };
+	auto descriptor = CreateDataFormatDescriptor();
+
+	// Header
+	Ktx2Header header = {};
+	header.vkFormat = m_Format;
+	header.typeSize = 1;
+	header.pixelWidth = m_Extent.width;
+	header.pixelHeight = m_Extent.height;
+	header.faceCount = 1;
+	header.levelCount = static_cast<uint32_t>(m_Levels.size());
+	header.supercompressionScheme = KTX2_SUPERCOMPRESSION_NONE;
+
+	// Descriptor follows level index
+	Ktx2Index index = {};
+	uint64_t offset = sizeof(KTX2_IDENTIFIER) + sizeof(Ktx2Header) + sizeof(Ktx2Index) + sizeof(Ktx2Level) * m_Levels.size();
+	index.dfdByteOffset = descriptor.empty() ? 0 : static_cast<uint32_t>(offset);
+	index.dfdByteLength = static_cast<uint32_t>(descriptor.size() * sizeof(uint32_t));
+	offset += index.dfdByteLength;
+
+	// Lay out level data smallest first, as the specification asks so streaming readers get low detail early
+	std::vector<Ktx2Level> levels(m_Levels.size());
+	for (size_t level = m_Levels.size(); level-- > 0;) {
+		offset = align(offset);
+		levels[level] = { offset, m_Levels[level].size(), m_Levels[level].size() };
+		offset += m_Levels[level].size();
+	}
+
+	// Assemble file in memory, padding stays zero
+	std::vector<uint8_t> file(static_cast<size_t>(offset), 0);
+	auto position = file.data();
+	std::memcpy(position, KTX2_IDENTIFIER, sizeof(KTX2_IDENTIFIER));
+	std::memcpy(position += sizeof(KTX2_IDENTIFIER), &header, sizeof(header));
+	std::memcpy(position += sizeof(header), &index, sizeof(index));
+	std::memcpy(position += sizeof(index), levels.data(), sizeof(Ktx2Level) * levels.size());
+	std::memcpy(position += sizeof(Ktx2Level) * levels.size(), descriptor.data(), index.dfdByteLength);
+	for (size_t level = 0; level < m_Levels.size(); level++) {
+		std::memcpy(file.data() + levels[level].byteOffset, m_Levels[level].data(), m_Levels[level].size());
+	}
+
+	// Write file
+	std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+	if (!stream.is_open()) {
+		throw std::runtime_error("Unable to open file " + path);
+	}
+	stream.write(reinterpret_cast<const char*>(file.data()), file.size());
+	if (!stream) {
+		throw std::runtime_error("Unable to write file " + path);
+	}
+}
+
+// Decode image, generate its mip chain and block compress every level, BC5 data is kept linear
+TextureCookReport TextureCooker::CookImage(const std::string& imagePath, const std::string& ktxPath, BlockFormat format, ThreadPool* threadPool){
+	PROFILE_SCOPE("TextureCooker::CookImage");
+
+	// Decode and box filter mip chain, two channel textures hold data such as normals so are never sRGB
+	TextureLoader loader(threadPool);
+	auto texture = loader.Load(imagePath, format != BlockFormat::BC5);
+	TextureLoader::GenerateMips(texture);
+
+	// Compress levels one after another, blocks within a level are spread over the workers
+	VkExtent2D extent = { texture.width, texture.height };
+	auto cookedFormat = BlockCompressor::GetVkFormat(format, texture.format == VK_FORMAT_R8G8B8A8_SRGB);
+	BlockCompressor compressor(threadPool);
+	TextureCooker cooker(extent, cookedFormat);
+	TextureCookReport report;
+	for (uint32_t level = 0; level < texture.levels.size(); level++) {
+		auto levelExtent = Image::GetMipExtent(extent, level);
+		cooker.AddLevel(compressor.Compress(texture.levels[level].data(), levelExtent.width, levelExtent.height, format));
+		report.sourceBytes += texture.levels[level].size();
+		report.cookedBytes += cooker.m_Levels.back().size();
+	}
+	cooker.Write(ktxPath);
+
+	// Fill report
+	report.width = extent.width;
+	report.height = extent.height;
+	report.levels = static_cast<uint32_t>(texture.levels.size());
+	report.format = cookedFormat;
+	return report;
+}
+
+// Basic descriptor block for BC formats, empty for formats without one
+std::vector<uint32_t> TextureCooker::CreateDataFormatDescriptor() const {
+	// Colour model and channels per format, BC3 and BC5 store two 64 bit halves
+	struct Sample { uint32_t channel; uint32_t bitOffset; uint32_t bitLength; };
+	uint32_t model = 0;
+	std::vector<Sample> samples;
+	bool srgb = false;
+	switch (m_Format) {
+	case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+		srgb = true;
+		[[fallthrough]];
+	case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+		model = KTX2_DFD_MODEL_BC1A;
+		samples = { { 0, 0, 64 } };
+		break;
+	case VK_FORMAT_BC3_SRGB_BLOCK:
+		srgb = true;
+		[[fallthrough]];
+	case VK_FORMAT_BC3_UNORM_BLOCK:
+		model = KTX2_DFD_MODEL_BC3;
+		samples = { { 15, 0, 64 }, { 0, 64, 64 } };
+		break;
+	case VK_FORMAT_BC5_UNORM_BLOCK:
+		model = KTX2_DFD_MODEL_BC5;
+		samples = { { 0, 0, 64 }, { 1, 64, 64 } };
+		break;
+	case VK_FORMAT_BC7_SRGB_BLOCK:
+		srgb = true;
+		[[fallthrough]];
+	case VK_FORMAT_BC7_UNORM_BLOCK:
+		model = KTX2_DFD_MODEL_BC7;
+		samples = { { 0, 0, 128 } };
+		break;
+	default:
+		return {};
+	}
+
+	// Total size, then descriptor block header of 6 words and 4 words per sample
+	auto words = 1 + 6 + 4 * samples.size();
+	std::vector<uint32_t> descriptor(words, 0);
+	descriptor[0] = static_cast<uint32_t>(words * sizeof(uint32_t));
+	descriptor[1] = 0;
+	descriptor[2] = KTX2_DFD_VERSION | (static_cast<uint32_t>((6 + 4 * samples.size()) * sizeof(uint32_t)) << 16);
+	descriptor[3] = model | (KTX2_DFD_PRIMARIES_BT709 << 8) | ((srgb ? KTX2_DFD_TRANSFER_SRGB : KTX2_DFD_TRANSFER_LINEAR) << 16);
+	descriptor[4] = (BlockCompressor::BLOCK_EXTENT - 1) | ((BlockCompressor::BLOCK_EXTENT - 1) << 8);
+	descriptor[5] = Image::GetBlockSize(m_Format);
+
+	// Samples cover the whole block, values span the full unsigned range
+	for (size_t i = 0; i < samples.size(); i++) {
+		auto sample = descriptor.data() + 7 + i * 4;
+		sample[0] = samples[i].bitOffset | ((samples[i].bitLength - 1) << 16) | (samples[i].channel << 24);
+		sample[1] = 0;
+		sample[2] = 0;
+		sample[3] = 0xFFFFFFFF;
+	}
+	return descriptor;
+}
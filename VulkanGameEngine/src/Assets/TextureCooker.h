@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+#include "../Core/ThreadPool.h"
+#include "BlockCompressor.h"
+#include "Ktx2Format.h"
+
+// Sizes of a cooked texture
+struct TextureCookReport {
+	uint32_t width = 0;				// Width of most detailed level
+	uint32_t height = 0;			// Height of most detailed level
+	uint32_t levels = 0;			// Mip levels written
+	VkFormat format = VK_FORMAT_UNDEFINED;	// Format of written levels
+	uint64_t sourceBytes = 0;		// Bytes of RGBA8 mip chain before compression
+	uint64_t cookedBytes = 0;		// Bytes of compressed mip chain
+};
+
+class TextureCooker {
+public:
+	TextureCooker(VkExtent2D extent, VkFormat format);	// Constructor, format must be one Image knows the block layout of
+	~TextureCooker();	// Destructor
+
+	static constexpr uint64_t LEVEL_ALIGNMENT = 16;	// Alignment of level data, a multiple of every block size
+
+	// FUNCTIONS
+	void AddLevel(const std::vector<uint8_t>& data);	// Append tightly packed mip level, most detailed first
+	void Write(const std::string& path) const;	// Write KTX2 container with a data format descriptor for BC formats
+
+	static TextureCookReport CookImage(const std::string& imagePath, const std::string& ktxPath, BlockFormat format, ThreadPool* threadPool = nullptr);	// Decode image, generate its mip chain and block compress every level, BC5 data is kept linear
+private:
+	// VARIABLES
+	VkExtent2D m_Extent;						// Extent of most detailed level
+	VkFormat m_Format;							// Format of level data
+	std::vector<std::vector<uint8_t>> m_Levels;	// Level bytes, most detailed first
+
+	// FUNCTIONS
+	std::vector<uint32_t> CreateDataFormatDescriptor() const;	// Basic descriptor block for BC formats, empty for formats without one
+};
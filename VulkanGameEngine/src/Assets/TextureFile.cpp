@@ -0,0 +1,72 @@
+#include "TextureFile.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include "../Graphics/Image.h"
+
+// Constructor
+TextureFile::TextureFile(const std::string& path)
+: m_File(std::make_unique<MappedFile>(path)) {
+	auto data = m_File->GetData();
+	auto size = static_cast<uint64_t>(m_File->GetSize());
+	auto fail = [&path](const std::string& reason) { throw std::runtime_error("Unable to load " + path + ", " + reason + "!"); };
+
+	// Check identifier, mappings are page aligned so header and index can be read in place
+	if (size < sizeof(KTX2_IDENTIFIER) + sizeof(Ktx2Header) + sizeof(Ktx2Index)) {
+		fail("file too small");
+	}
+	if (std::memcmp(data, KTX2_IDENTIFIER, sizeof(KTX2_IDENTIFIER)) != 0) {
+		fail("not a KTX2 texture");
+	}
+
+	// Check header describes a plain 2D texture the uploader knows the layout of
+	m_Header = reinterpret_cast<const Ktx2Header*>(data + sizeof(KTX2_IDENTIFIER));
+	auto format = static_cast<VkFormat>(m_Header->vkFormat);
+	auto blockSize = Image::GetBlockSize(format);
+	if (blockSize == 0) {
+		fail("unsupported format " + std::to_string(m_Header->vkFormat));
+	}
+	if (m_Header->pixelWidth == 0 || m_Header->pixelHeight == 0 || m_Header->pixelDepth != 0 || m_Header->layerCount > 1 || m_Header->faceCount != 1) {
+		fail("not a 2D texture");
+	}
+	if (m_Header->supercompressionScheme != KTX2_SUPERCOMPRESSION_NONE) {
+		fail("supercompressed");
+	}
+
+	// Check level index fits, a level count of zero still stores level 0
+	auto extent = GetExtent();
+	auto levelCount = std::max(m_Header->levelCount, 1u);
+	if (levelCount > Image::GetMipLevelCount(extent)) {
+		fail("more levels than a full mip chain");
+	}
+	auto levels = reinterpret_cast<const Ktx2Level*>(data + sizeof(KTX2_IDENTIFIER) + sizeof(Ktx2Header) + sizeof(Ktx2Index));
+	if (sizeof(KTX2_IDENTIFIER) + sizeof(Ktx2Header) + sizeof(Ktx2Index) + sizeof(Ktx2Level) * static_cast<uint64_t>(levelCount) > size) {
+		fail("level index exceeds file");
+	}
+
+	// Check every level is tightly packed, aligned to its blocks and inside the file, and point into mapping
+	auto alignment = blockSize % 4 == 0 ? blockSize : 4;
+	for (uint32_t level = 0; level < levelCount; level++) {
+		if (levels[level].byteLength != Image::GetLevelSize(format, extent, level)) {
+			fail("level " + std::to_string(level) + " has wrong size");
+		}
+		if (levels[level].byteOffset % alignment != 0 || levels[level].byteOffset + levels[level].byteLength > size) {
+			fail("level " + std::to_string(level) + " exceeds file");
+		}
+		m_Levels.push_back(data + levels[level].byteOffset);
+	}
+}
+
+// Destructor
+TextureFile::~TextureFile(){
+}
+
+// Read levels from first level down into memory, so uploading them does not wait on disk
+void TextureFile::Prefetch(uint32_t firstLevel) const {
+	for (auto level = firstLevel; level < m_Levels.size(); level++) {
+		auto offset = static_cast<const uint8_t*>(m_Levels[level]) - m_File->GetData();
+		m_File->Prefetch(static_cast<size_t>(offset), static_cast<size_t>(Image::GetLevelSize(GetFormat(), GetExtent(), level)));
+	}
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+#include "../Core/MappedFile.h"
+#include "Ktx2Format.h"
+
+class TextureFile {
+public:
+	TextureFile(const std::string& path);	// Constructor, maps KTX2 texture and validates its level index, data is never parsed
+	~TextureFile();	// Destructor
+
+	// FUNCTIONS
+	void Prefetch(uint32_t firstLevel = 0) const;	// Read levels from first level down into memory, so uploading them does not wait on disk
+
+	// GETTERS
+	const VkFormat GetFormat() const { return static_cast<VkFormat>(m_Header->vkFormat); }
+	const VkExtent2D GetExtent() const { return { m_Header->pixelWidth, m_Header->pixelHeight }; }
+	const std::vector<const void*>& GetLevels() const { return m_Levels; }
+	const uint32_t GetLevelCount() const { return static_cast<uint32_t>(m_Levels.size()); }
+	const uint64_t GetSize() const { return m_File->GetSize(); }
+private:
+	// VARIABLES
+	std::unique_ptr<MappedFile> m_File;		// Mapped file, must outlive pointers handed out
+	const Ktx2Header* m_Header;				// Header behind identifier
+	std::vector<const void*> m_Levels;		// Level pointers into mapping, most detailed first
+};
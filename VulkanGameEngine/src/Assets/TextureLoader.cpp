@@ -0,0 +1,131 @@
+#define STB_IMAGE_IMPLEMENTATION
+#include "TextureLoader.h"
+
+#include <algorithm>
+#include <stb/stb_image.h>
+#include <stdexcept>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TEXTURE_LOADER_SSE2
+#endif
+
+#include "../Core/Profiler.h"
+#include "../Graphics/Image.h"
+
+// Constructor
+TextureLoader::TextureLoader(ThreadPool* threadPool)
+: m_ThreadPool(threadPool) {
+}
+
+// Destructor
+TextureLoader::~TextureLoader(){
+}
+
+// Decode PNG, JPEG, TGA or BMP file into RGBA8 texels, colour textures are sRGB, data textures such as normal maps are not
+TextureData TextureLoader::Load(const std::string& path, bool srgb){
+	PROFILE_SCOPE("TextureLoader::Load");
+
+	// Decode with every image expanded to four channels, the layout GPUs sample natively
+	int width = 0;
+	int height = 0;
+	int channels = 0;
+	auto pixels = stbi_load(path.c_str(), &width, &height, &channels, STBI_rgb_alpha);
+	if (!pixels) {
+		throw std::runtime_error("Unable to load " + path + ", " + stbi_failure_reason() + "!");
+	}
+
+	// Copy texels into level 0 and release decoder memory
+	TextureData texture;
+	texture.width = static_cast<uint32_t>(width);
+	texture.height = static_cast<uint32_t>(height);
+	texture.format = srgb ? VK_FORMAT_R8G8B8A8_SRGB : VK_FORMAT_R8G8B8A8_UNORM;
+	texture.levels.emplace_back(pixels, pixels + static_cast<size_t>(width) * height * 4);
+	stbi_image_free(pixels);
+	return texture;
+}
+
+// Decode files in parallel, one task per file
+std::vector<TextureData> TextureLoader::LoadAll(const std::vector<std::string>& paths, bool srgb){
+	PROFILE_SCOPE("TextureLoader::LoadAll");
+	std::vector<TextureData> textures(paths.size());
+
+	// Decode serially without workers or with a single file
+	if (!m_ThreadPool || paths.size() == 1) {
+		for (size_t i = 0; i < paths.size(); i++) {
+			textures[i] = Load(paths[i], srgb);
+		}
+		return textures;
+	}
+
+	// Queue a task per file, stb_image keeps no shared state, Wait rethrows the first task error
+	for (size_t i = 0; i < paths.size(); i++) {
+		auto target = &textures[i];
+		auto path = &paths[i];
+		m_ThreadPool->Enqueue([this, target, path, srgb]() { *target = Load(*path, srgb); });
+	}
+	m_ThreadPool->Wait();
+	return textures;
+}
+
+// Box filter RGBA8 level 0 into a full mip chain on the CPU, used when the GPU cannot blit the format
+void TextureLoader::GenerateMips(TextureData& texture){
+	PROFILE_SCOPE("TextureLoader::GenerateMips");
+
+	// Throw error if there is no 8 bit RGBA level to filter
+	if (texture.levels.empty() || Image::GetBlockSize(texture.format) != 4 || Image::GetBlockExtent(texture.format) != 1) {
+		throw std::runtime_error("Unable to generate mips, texture has no RGBA8 level!");
+	}
+
+	// Filter each level from the one before, averages are taken on stored values so sRGB levels are slightly darkened
+	VkExtent2D extent = { texture.width, texture.height };
+	auto levelCount = Image::GetMipLevelCount(extent);
+	texture.levels.resize(1);
+	for (uint32_t level = 1; level < levelCount; level++) {
+		auto sourceExtent = Image::GetMipExtent(extent, level - 1);
+		auto levelExtent = Image::GetMipExtent(extent, level);
+		texture.levels.emplace_back(static_cast<size_t>(levelExtent.width) * levelExtent.height * 4);
+		Downsample(texture.levels[level - 1].data(), sourceExtent.width, sourceExtent.height, texture.levels[level].data(), levelExtent.width, levelExtent.height);
+	}
+}
+
+// Average 2x2 RGBA8 texels into one, edges of odd or 1 texel wide levels are clamped
+void TextureLoader::Downsample(const uint8_t* source, uint32_t sourceWidth, uint32_t sourceHeight, uint8_t* destination, uint32_t width, uint32_t height){
+	for (uint32_t y = 0; y < height; y++) {
+		auto row0 = source + static_cast<size_t>(std::min(y * 2, sourceHeight - 1)) * sourceWidth * 4;
+		auto row1 = source + static_cast<size_t>(std::min(y * 2 + 1, sourceHeight - 1)) * sourceWidth * 4;
+		auto output = destination + static_cast<size_t>(y) * width * 4;
+		uint32_t x = 0;
+
+#ifdef TEXTURE_LOADER_SSE2
+		// Two output texels from four source texels of both rows, widened to 16 bits so sums do not overflow
+		if (sourceWidth >= 2) {
+			auto zero = _mm_setzero_si128();
+			auto rounding = _mm_set1_epi16(2);
+			for (; x + 2 <= width && x * 2 + 4 <= sourceWidth; x += 2) {
+				auto top = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + x * 8));
+				auto bottom = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + x * 8));
+
+				// Column sums of texels 0 and 1 in low half, 2 and 3 in high half
+				auto low = _mm_add_epi16(_mm_unpacklo_epi8(top, zero), _mm_unpacklo_epi8(bottom, zero));
+				auto high = _mm_add_epi16(_mm_unpackhi_epi8(top, zero), _mm_unpackhi_epi8(bottom, zero));
+
+				// Add horizontal neighbours, round and divide by four
+				low = _mm_add_epi16(low, _mm_srli_si128(low, 8));
+				high = _mm_add_epi16(high, _mm_srli_si128(high, 8));
+				auto sum = _mm_srli_epi16(_mm_add_epi16(_mm_unpacklo_epi64(low, high), rounding), 2);
+				_mm_storel_epi64(reinterpret_cast<__m128i*>(output + x * 4), _mm_packus_epi16(sum, zero));
+			}
+		}
+#endif
+
+		// Remaining texels, clamped at right edge
+		for (; x < width; x++) {
+			auto x0 = std::min(x * 2, sourceWidth - 1) * 4;
+			auto x1 = std::min(x * 2 + 1, sourceWidth - 1) * 4;
+			for (uint32_t c = 0; c < 4; c++) {
+				output[x * 4 + c] = static_cast<uint8_t>((row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c] + 2) >> 2);
+			}
+		}
+	}
+}
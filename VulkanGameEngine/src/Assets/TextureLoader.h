@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+#include "../Core/ThreadPool.h"
+
+// Decoded texture ready for Graphics::AddTexture
+struct TextureData {
+	uint32_t width = 0;									// Width of most detailed level
+	uint32_t height = 0;								// Height of most detailed level
+	VkFormat format = VK_FORMAT_R8G8B8A8_SRGB;			// Format of texels
+	std::vector<std::vector<uint8_t>> levels;			// Tightly packed texels per mip level, most detailed first, a single level gets its mips generated
+};
+
+class TextureLoader {
+public:
+	TextureLoader(ThreadPool* threadPool = nullptr);	// Constructor, without a thread pool files are decoded on the calling thread
+	~TextureLoader();	// Destructor
+
+	// FUNCTIONS
+	TextureData Load(const std::string& path, bool srgb = true);	// Decode PNG, JPEG, TGA or BMP file into RGBA8 texels, colour textures are sRGB, data textures such as normal maps are not
+	std::vector<TextureData> LoadAll(const std::vector<std::string>& paths, bool srgb = true);	// Decode files in parallel, one task per file
+	static void GenerateMips(TextureData& texture);	// Box filter RGBA8 level 0 into a full mip chain on the CPU, used when the GPU cannot blit the format
+private:
+	// VARIABLES
+	ThreadPool* m_ThreadPool;	// Worker threads decoding files, may be null
+
+	// FUNCTIONS
+	static void Downsample(const uint8_t* source, uint32_t sourceWidth, uint32_t sourceHeight, uint8_t* destination, uint32_t width, uint32_t height);	// Average 2x2 RGBA8 texels into one, edges of odd or 1 texel wide levels are clamped
+};
@@ -0,0 +1,100 @@
+#include "MappedFile.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#ifdef _WIN32
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Constructor
+MappedFile::MappedFile(const std::string& path)
+: m_Path(path) {
+#ifdef _WIN32
+	// Open file, hinting the cache manager that it is read front to back
+	m_File = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (m_File == INVALID_HANDLE_VALUE) {
+		m_File = nullptr;
+		throw std::runtime_error("Unable to open file " + path);
+	}
+
+	// Get file size, empty files cannot be mapped
+	LARGE_INTEGER size;
+	GetFileSizeEx(m_File, &size);
+	m_Size = static_cast<size_t>(size.QuadPart);
+	if (m_Size == 0) {
+		return;
+	}
+
+	// Map whole file read only
+	m_Mapping = CreateFileMappingA(m_File, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (m_Mapping) {
+		m_Data = static_cast<const uint8_t*>(MapViewOfFile(m_Mapping, FILE_MAP_READ, 0, 0, 0));
+	}
+	if (!m_Data) {
+		if (m_Mapping) CloseHandle(m_Mapping);
+		CloseHandle(m_File);
+		throw std::runtime_error("Unable to map file " + path);
+	}
+#else
+	// Open file
+	m_File = open(path.c_str(), O_RDONLY);
+	if (m_File < 0) {
+		throw std::runtime_error("Unable to open file " + path);
+	}
+
+	// Get file size, empty files cannot be mapped
+	struct stat status;
+	fstat(m_File, &status);
+	m_Size = static_cast<size_t>(status.st_size);
+	if (m_Size == 0) {
+		return;
+	}
+
+	// Map whole file read only, pages are read front to back
+	auto data = mmap(nullptr, m_Size, PROT_READ, MAP_PRIVATE, m_File, 0);
+	if (data == MAP_FAILED) {
+		close(m_File);
+		throw std::runtime_error("Unable to map file " + path);
+	}
+	madvise(data, m_Size, MADV_SEQUENTIAL);
+	m_Data = static_cast<const uint8_t*>(data);
+#endif
+}
+
+// Destructor
+MappedFile::~MappedFile(){
+#ifdef _WIN32
+	// Unmap view and close handles
+	if (m_Data) UnmapViewOfFile(m_Data);
+	if (m_Mapping) CloseHandle(m_Mapping);
+	if (m_File) CloseHandle(m_File);
+#else
+	// Unmap and close file
+	if (m_Data) munmap(const_cast<uint8_t*>(m_Data), m_Size);
+	if (m_File >= 0) close(m_File);
+#endif
+}
+
+// Read range into memory on the calling thread, so later copies do not fault on disk reads
+void MappedFile::Prefetch(size_t offset, size_t size) const {
+	// Clamp range to mapping
+	if (!m_Data || offset >= m_Size) {
+		return;
+	}
+	size = std::min(size, m_Size - offset);
+
+	// Touch one byte per page, volatile so the reads are not optimized away
+	volatile uint8_t sink = 0;
+	for (size_t position = 0; position < size; position += PAGE_SIZE) {
+		sink = sink + m_Data[offset + position];
+	}
+	sink = sink + m_Data[offset + size - 1];
+}
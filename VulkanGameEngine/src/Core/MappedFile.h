@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+class MappedFile {
+public:
+	MappedFile(const std::string& path);	// Constructor, maps whole file read only
+	~MappedFile();	// Destructor
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	static constexpr size_t PAGE_SIZE = 4096;	// Stride pages are touched at, the smallest page size of supported platforms
+
+	// FUNCTIONS
+	void Prefetch(size_t offset, size_t size) const;	// Read range into memory on the calling thread, so later copies do not fault on disk reads
+
+	// GETTERS
+	const uint8_t* GetData() const { return m_Data; }
+	const size_t GetSize() const { return m_Size; }
+	const std::string& GetPath() const { return m_Path; }
+private:
+	// VARIABLES
+	std::string m_Path;				// Path of mapped file
+	const uint8_t* m_Data = nullptr;	// First byte of mapping, null for empty files
+	size_t m_Size = 0;				// Bytes mapped
+#ifdef _WIN32
+	void* m_File = nullptr;			// File handle
+	void* m_Mapping = nullptr;		// File mapping handle
+#else
+	int m_File = -1;				// File descriptor
+#endif
+};
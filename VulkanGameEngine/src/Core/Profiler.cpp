@@ -0,0 +1,141 @@
+#include "Profiler.h"
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+
+// Buffer of calling thread, set on first recorded zone
+static thread_local void* t_ThreadBuffer = nullptr;
+
+// Name of calling thread, applied to its buffer once created
+static thread_local std::string t_ThreadName;
+
+// Process wide profiler
+Profiler& Profiler::Get(){
+	static Profiler profiler;
+	return profiler;
+}
+
+// Nanoseconds since profiler epoch
+uint64_t Profiler::Now(){
+	static const auto epoch = std::chrono::steady_clock::now();
+	return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count());
+}
+
+// Append finished zone to calling thread's buffer, lock free
+void Profiler::RecordZone(const char* name, uint64_t start, uint64_t end){
+	auto buffer = GetThreadBuffer();
+
+	// Drop zone if collector has not caught up
+	auto head = buffer->head.load(std::memory_order_relaxed);
+	if (head - buffer->tail.load(std::memory_order_acquire) >= THREAD_BUFFER_SIZE) {
+		buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	// Write zone, then publish it to the collector
+	buffer->zones[head & (THREAD_BUFFER_SIZE - 1)] = { name, start, end };
+	buffer->head.store(head + 1, std::memory_order_release);
+}
+
+// Name calling thread in exported traces
+void Profiler::SetThreadName(const std::string& name){
+	// Remember name so threads that never record zones do not allocate a buffer
+	t_ThreadName = name;
+	if (!t_ThreadBuffer) return;
+
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	static_cast<ThreadBuffer*>(t_ThreadBuffer)->threadName = name;
+}
+
+// Drain all thread buffers, call regularly so buffers do not overflow
+void Profiler::Collect(){
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	for (auto& buffer : m_Buffers) {
+		// Copy zones published since last collection
+		auto tail = buffer->tail.load(std::memory_order_relaxed);
+		auto head = buffer->head.load(std::memory_order_acquire);
+		for (auto i = tail; i < head; i++) {
+			if (m_Collected.size() >= MAX_COLLECTED_ZONES) {
+				m_CollectDropped++;
+				continue;
+			}
+			m_Collected.push_back({ buffer->zones[i & (THREAD_BUFFER_SIZE - 1)], buffer->threadId });
+		}
+
+		// Hand slots back to owning thread
+		buffer->tail.store(head, std::memory_order_release);
+	}
+}
+
+// Collect and write zones as Chrome trace JSON, clears collected zones
+bool Profiler::WriteChromeTrace(const std::string& path){
+	Collect();
+
+	// Open trace file
+	std::ofstream file(path, std::ios::trunc);
+	if (!file.is_open()) {
+		return false;
+	}
+
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+	// Thread name metadata
+	bool first = true;
+	for (auto& buffer : m_Buffers) {
+		if (buffer->threadName.empty()) continue;
+		file << (first ? "" : ",") << "\n{\"ph\":\"M\",\"pid\":0,\"tid\":" << buffer->threadId << ",\"name\":\"thread_name\",\"args\":{\"name\":\"";
+		for (auto c : buffer->threadName) {
+			if (c == '"' || c == '\\') file << '\\';
+			file << c;
+		}
+		file << "\"}}";
+		first = false;
+	}
+
+	// Complete events, timestamps in microseconds
+	char line[96];
+	for (auto& collected : m_Collected) {
+		file << (first ? "" : ",") << "\n{\"ph\":\"X\",\"pid\":0,\"tid\":" << collected.threadId << ",\"name\":\"";
+		for (auto c = collected.zone.name; *c; c++) {
+			if (*c == '"' || *c == '\\') file << '\\';
+			file << *c;
+		}
+		std::snprintf(line, sizeof(line), "\",\"ts\":%.3f,\"dur\":%.3f}", collected.zone.start / 1000.0, (collected.zone.end - collected.zone.start) / 1000.0);
+		file << line;
+		first = false;
+	}
+	file << "\n]}\n";
+	m_Collected.clear();
+
+	return file.good();
+}
+
+// Zones dropped because a buffer or the collected list was full
+const uint64_t Profiler::GetDroppedZones() const{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	auto dropped = m_CollectDropped;
+	for (auto& buffer : m_Buffers) {
+		dropped += buffer->dropped.load(std::memory_order_relaxed);
+	}
+	return dropped;
+}
+
+// Buffer of calling thread, created on first use
+Profiler::ThreadBuffer* Profiler::GetThreadBuffer(){
+	// Fast path, thread already registered
+	if (t_ThreadBuffer) {
+		return static_cast<ThreadBuffer*>(t_ThreadBuffer);
+	}
+
+	// Register new buffer, owned by profiler so it outlives its thread
+	auto buffer = std::make_unique<ThreadBuffer>();
+	buffer->zones.resize(THREAD_BUFFER_SIZE);
+	buffer->threadName = t_ThreadName;
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	buffer->threadId = static_cast<uint32_t>(m_Buffers.size());
+	t_ThreadBuffer = buffer.get();
+	m_Buffers.emplace_back(std::move(buffer));
+	return static_cast<ThreadBuffer*>(t_ThreadBuffer);
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Profile enclosing scope under name, name must be a string literal or otherwise outlive the profiler
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
+#define PROFILE_FUNCTION() PROFILE_SCOPE(__FUNCTION__)
+
+class Profiler {
+public:
+	static Profiler& Get();	// Process wide profiler
+	static uint64_t Now();	// Nanoseconds since profiler epoch
+
+	static constexpr uint32_t THREAD_BUFFER_SIZE = 16384;		// Zones buffered per thread between collections, power of two
+	static constexpr size_t MAX_COLLECTED_ZONES = 1 << 20;		// Zones kept for export before new ones are dropped
+
+	// FUNCTIONS
+	void RecordZone(const char* name, uint64_t start, uint64_t end);	// Append finished zone to calling thread's buffer, lock free
+	void SetThreadName(const std::string& name);	// Name calling thread in exported traces
+	void Collect();	// Drain all thread buffers, call regularly so buffers do not overflow
+	bool WriteChromeTrace(const std::string& path);	// Collect and write zones as Chrome trace JSON, clears collected zones
+
+	// GETTERS
+	const bool IsEnabled() const { return m_Enabled.load(std::memory_order_relaxed); }
+	const uint64_t GetDroppedZones() const;
+
+	// SETTERS
+	void SetEnabled(bool enabled) { m_Enabled.store(enabled, std::memory_order_relaxed); }
+private:
+	Profiler() = default;	// Constructor
+
+	// Finished zone
+	struct Zone {
+		const char* name;	// Zone name
+		uint64_t start;		// Start in nanoseconds since epoch
+		uint64_t end;		// End in nanoseconds since epoch
+	};
+
+	// Zone exported with its thread
+	struct CollectedZone {
+		Zone zone;			// Finished zone
+		uint32_t threadId;	// Profiler thread id
+	};
+
+	// Single producer single consumer ring owned by one thread
+	struct ThreadBuffer {
+		uint32_t threadId = 0;				// Profiler thread id
+		std::string threadName;				// Name shown in traces, guarded by profiler mutex
+		std::vector<Zone> zones;			// Ring storage
+		std::atomic<uint64_t> head = 0;		// Zones written, only advanced by owning thread
+		std::atomic<uint64_t> tail = 0;		// Zones read, only advanced by collector
+		std::atomic<uint64_t> dropped = 0;	// Zones lost because ring was full
+	};
+
+	// VARIABLES
+	std::atomic<bool> m_Enabled = false;	// Zones are only recorded while enabled
+
+	mutable std::mutex m_Mutex;			// Guards buffer list, collection and export
+	std::vector<std::unique_ptr<ThreadBuffer>> m_Buffers;	// Buffers of every thread that recorded zones
+	std::vector<CollectedZone> m_Collected;	// Zones drained from buffers awaiting export
+	uint64_t m_CollectDropped = 0;		// Zones lost because collected list was full
+
+	// FUNCTIONS
+	ThreadBuffer* GetThreadBuffer();	// Buffer of calling thread, created on first use
+};
+
+// Scoped CPU zone, recorded when leaving scope
+class ProfileScope {
+public:
+	ProfileScope(const char* name)	// Constructor
+	: m_Name(name), m_Active(Profiler::Get().IsEnabled()) {
+		if (m_Active) m_Start = Profiler::Now();
+	}
+	~ProfileScope() {	// Destructor
+		if (m_Active) Profiler::Get().RecordZone(m_Name, m_Start, Profiler::Now());
+	}
+	ProfileScope(const ProfileScope&) = delete;
+	ProfileScope& operator=(const ProfileScope&) = delete;
+private:
+	// VARIABLES
+	const char* m_Name;		// Zone name
+	bool m_Active;			// True if profiler was enabled when scope started
+	uint64_t m_Start = 0;	// Start in nanoseconds since epoch
+};
@@ -0,0 +1,98 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <string>
+
+#include "Profiler.h"
+
+// Constructor
+ThreadPool::ThreadPool(uint32_t threadCount){
+	// Default to one thread per hardware core
+	if (threadCount == 0) {
+		threadCount = std::max(1u, std::thread::hardware_concurrency());
+	}
+
+	// Start workers
+	for (uint32_t i = 0; i < threadCount; i++) {
+		m_Threads.emplace_back([this, i]() {
+			// Name worker in profiler traces
+			Profiler::Get().SetThreadName("Worker " + std::to_string(i));
+			WorkerLoop();
+		});
+	}
+}
+
+// Destructor
+ThreadPool::~ThreadPool(){
+	// Tell workers to exit once queue is drained
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Stopping = true;
+	}
+	m_TaskAvailable.notify_all();
+
+	// Join workers
+	for (auto& thread : m_Threads) {
+		thread.join();
+	}
+}
+
+// Queue task for any worker
+void ThreadPool::Enqueue(std::function<void()> task){
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Tasks.push(std::move(task));
+	}
+	m_TaskAvailable.notify_one();
+}
+
+// Block until all queued tasks finished, rethrows first task exception
+void ThreadPool::Wait(){
+	std::unique_lock<std::mutex> lock(m_Mutex);
+	m_TasksFinished.wait(lock, [this]() { return m_Tasks.empty() && m_RunningTasks == 0; });
+
+	// Hand task exception to caller
+	if (m_Exception) {
+		auto exception = m_Exception;
+		m_Exception = nullptr;
+		std::rethrow_exception(exception);
+	}
+}
+
+// Run tasks until stopping
+void ThreadPool::WorkerLoop(){
+	while (true) {
+		// Wait for task
+		std::function<void()> task;
+		{
+			std::unique_lock<std::mutex> lock(m_Mutex);
+			m_TaskAvailable.wait(lock, [this]() { return m_Stopping || !m_Tasks.empty(); });
+			if (m_Stopping && m_Tasks.empty()) {
+				return;
+			}
+			task = std::move(m_Tasks.front());
+			m_Tasks.pop();
+			m_RunningTasks++;
+		}
+
+		// Run task, keeping first exception for Wait
+		try {
+			task();
+		}
+		catch (...) {
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			if (!m_Exception) {
+				m_Exception = std::current_exception();
+			}
+		}
+
+		// Wake waiters if this was the last task
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_RunningTasks--;
+			if (m_Tasks.empty() && m_RunningTasks == 0) {
+				m_TasksFinished.notify_all();
+			}
+		}
+	}
+}
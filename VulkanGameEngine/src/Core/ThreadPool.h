@@ -0,0 +1,35 @@
+#pragma once
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+class ThreadPool {
+public:
+	ThreadPool(uint32_t threadCount = 0);	// Constructor, zero uses one thread per hardware core
+	~ThreadPool();	// Destructor
+
+	// FUNCTIONS
+	void Enqueue(std::function<void()> task);	// Queue task for any worker
+	void Wait();	// Block until all queued tasks finished, rethrows first task exception
+
+	// GETTERS
+	const uint32_t GetThreadCount() const { return static_cast<uint32_t>(m_Threads.size()); }
+private:
+	// VARIABLES
+	std::vector<std::thread> m_Threads;				// Worker threads
+	std::queue<std::function<void()>> m_Tasks;		// Tasks waiting for a worker
+	std::mutex m_Mutex;								// Guards tasks and counters
+	std::condition_variable m_TaskAvailable;		// Signalled when task queued or stopping
+	std::condition_variable m_TasksFinished;		// Signalled when last running task finished
+	uint32_t m_RunningTasks = 0;					// Tasks taken by workers but not finished
+	bool m_Stopping = false;						// True when workers should exit
+	std::exception_ptr m_Exception;					// First exception thrown by a task
+
+	// FUNCTIONS
+	void WorkerLoop();	// Run tasks until stopping
+};
@@ -0,0 +1,275 @@
+#include "BindlessTable.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+// Constructor
+BindlessTable::BindlessTable(Device* device, PhysicalDevice* physicalDevice, MemoryAllocator* allocator, UploadManager* uploadManager, uint32_t framesInFlight)
+: m_Device(device), m_Bindless(device->GetDescriptorIndexing()) {
+	// Clamp slots to what a single stage may access, combined image samplers count as both samplers and sampled images
+	auto limits = physicalDevice->GetProperties().limits;
+	if (m_Bindless) {
+		auto indexingLimits = physicalDevice->GetDescriptorIndexingProperties();
+		m_TextureCapacity = std::min({ MAX_TEXTURES, indexingLimits.maxPerStageDescriptorUpdateAfterBindSamplers, indexingLimits.maxPerStageDescriptorUpdateAfterBindSampledImages,
+			indexingLimits.maxDescriptorSetUpdateAfterBindSamplers, indexingLimits.maxDescriptorSetUpdateAfterBindSampledImages });
+		m_BufferCapacity = std::min({ MAX_BUFFERS, indexingLimits.maxPerStageDescriptorUpdateAfterBindStorageBuffers, indexingLimits.maxDescriptorSetUpdateAfterBindStorageBuffers });
+	}
+	else {
+		m_TextureCapacity = std::min({ FALLBACK_MAX_TEXTURES, limits.maxPerStageDescriptorSamplers, limits.maxPerStageDescriptorSampledImages,
+			limits.maxDescriptorSetSamplers, limits.maxDescriptorSetSampledImages });
+		m_BufferCapacity = std::min({ FALLBACK_MAX_BUFFERS, limits.maxPerStageDescriptorStorageBuffers, limits.maxDescriptorSetStorageBuffers });
+	}
+	m_TextureSlots.capacity = m_TextureCapacity;
+	m_BufferSlots.capacity = m_BufferCapacity;
+
+	// Create default resources, uploaded with the first flush before any frame samples them
+	TextureData white;
+	white.width = 1;
+	white.height = 1;
+	white.format = VK_FORMAT_R8G8B8A8_UNORM;
+	white.levels = { { 255, 255, 255, 255 } };
+	m_DefaultTexture = std::make_unique<Texture>(m_Device, physicalDevice, allocator, uploadManager, white);
+	ResourceIndices zeroes;
+	m_DefaultBuffer = std::make_unique<Buffer>(m_Device, allocator, sizeof(zeroes), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, &zeroes);
+
+	// Every slot starts at the default resources, slot 0 stays there for draws without resources
+	m_TextureInfos.resize(m_TextureCapacity, { m_DefaultTexture->GetSampler(), m_DefaultTexture->GetImageView(), VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL });
+	m_BufferInfos.resize(m_BufferCapacity, { m_DefaultBuffer->GetBuffer(), 0, VK_WHOLE_SIZE });
+	m_TextureSlots.used = 1;
+	m_BufferSlots.used = 1;
+
+	// Create layout and a set per frame in flight, frames still in flight may read any slot so a set is only written once its frame finished
+	CreateDescriptorSetLayout();
+	CreateDescriptorSets(framesInFlight);
+}
+
+// Destructor
+BindlessTable::~BindlessTable(){
+	// Destroy pool, freeing its sets
+	vkDestroyDescriptorPool(m_Device->GetDevice(), m_DescriptorPool, nullptr);
+
+	// Destroy descriptor set layout
+	vkDestroyDescriptorSetLayout(m_Device->GetDevice(), m_DescriptorSetLayout, nullptr);
+}
+
+// Write texture into a free slot and return its index
+uint32_t BindlessTable::AddTexture(Texture* texture){
+	auto slot = AllocateSlot(m_TextureSlots, "texture");
+	m_TextureInfos[slot] = { texture->GetSampler(), texture->GetImageView(), VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL };
+	WriteTexture(slot);
+	return slot;
+}
+
+// Write storage buffer into a free slot and return its index
+uint32_t BindlessTable::AddBuffer(Buffer* buffer){
+	auto slot = AllocateSlot(m_BufferSlots, "buffer");
+	m_BufferInfos[slot] = { buffer->GetBuffer(), 0, VK_WHOLE_SIZE };
+	WriteBuffer(slot);
+	return slot;
+}
+
+// Point slot at texture in place, indices taken before stay valid, caller keeps the previous texture alive until frames in flight finished
+void BindlessTable::SetTexture(uint32_t index, Texture* texture){
+	// Throw error if slot was never handed out
+	if (index == 0 || index >= m_TextureSlots.used) {
+		throw std::runtime_error("Unable to set texture slot not in table!");
+	}
+
+	// Slot keeps its index, only the descriptor it holds changes
+	m_TextureInfos[index] = { texture->GetSampler(), texture->GetImageView(), VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL };
+	WriteTexture(index);
+}
+
+// Point slot back at the default texture and free it, caller ensures no frame in flight reads it
+void BindlessTable::RemoveTexture(uint32_t index){
+	// Throw error if slot was never handed out
+	if (index == 0 || index >= m_TextureSlots.used) {
+		throw std::runtime_error("Unable to remove texture slot not in table!");
+	}
+
+	// Sets must not keep the view of a destroyed texture
+	m_TextureInfos[index] = m_TextureInfos[0];
+	WriteTexture(index);
+	m_TextureSlots.freeSlots.emplace_back(index);
+}
+
+// Point slot back at the default buffer and free it, caller ensures no frame in flight reads it
+void BindlessTable::RemoveBuffer(uint32_t index){
+	// Throw error if slot was never handed out
+	if (index == 0 || index >= m_BufferSlots.used) {
+		throw std::runtime_error("Unable to remove buffer slot not in table!");
+	}
+
+	// Sets must not keep a destroyed buffer
+	m_BufferInfos[index] = m_BufferInfos[0];
+	WriteBuffer(index);
+	m_BufferSlots.freeSlots.emplace_back(index);
+}
+
+// Write slots changed since frame's set was last used, caller ensures the frame's previous submission finished
+void BindlessTable::Update(uint32_t frame){
+	// Bring frame's set up to date now nothing reads it
+	auto& textureSlots = m_DirtyTextures[frame];
+	auto& bufferSlots = m_DirtyBuffers[frame];
+	WriteSlots(m_DescriptorSets[frame], textureSlots, bufferSlots);
+	textureSlots.clear();
+	bufferSlots.clear();
+}
+
+// Bind frame's set as set 0, stays bound across pipelines sharing the table layout
+void BindlessTable::Bind(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, uint32_t frame) const{
+	auto set = m_DescriptorSets[frame];
+	vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, 1, &set, 0, nullptr);
+}
+
+// Push slots read by following draws
+void BindlessTable::Push(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, const ResourceIndices& indices){
+	vkCmdPushConstants(commandBuffer, pipelineLayout, STAGES, 0, sizeof(ResourceIndices), &indices);
+}
+
+// Create layout with an array binding per resource type
+void BindlessTable::CreateDescriptorSetLayout(){
+	// Texture and storage buffer arrays, shaders size them with specialization constants matching the capacities
+	VkDescriptorSetLayoutBinding bindings[2] = {};
+	bindings[TEXTURE_BINDING].binding = TEXTURE_BINDING;
+	bindings[TEXTURE_BINDING].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+	bindings[TEXTURE_BINDING].descriptorCount = m_TextureCapacity;
+	bindings[TEXTURE_BINDING].stageFlags = STAGES;
+	bindings[BUFFER_BINDING].binding = BUFFER_BINDING;
+	bindings[BUFFER_BINDING].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+	bindings[BUFFER_BINDING].descriptorCount = m_BufferCapacity;
+	bindings[BUFFER_BINDING].stageFlags = STAGES;
+
+	// Slots may be written while the set is bound and only slots draws read need to be valid
+	VkDescriptorBindingFlagsEXT bindingFlags[2] = {};
+	bindingFlags[TEXTURE_BINDING] = VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT | VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT_EXT | VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT;
+	bindingFlags[BUFFER_BINDING] = bindingFlags[TEXTURE_BINDING];
+	VkDescriptorSetLayoutBindingFlagsCreateInfoEXT bindingFlagsInfo = {};
+	bindingFlagsInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO_EXT;
+	bindingFlagsInfo.bindingCount = 2;
+	bindingFlagsInfo.pBindingFlags = bindingFlags;
+
+	// Descriptor set layout creation info, flags are only valid with descriptor indexing
+	VkDescriptorSetLayoutCreateInfo descriptorSetLayoutInfo = {};
+	descriptorSetLayoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+	descriptorSetLayoutInfo.pNext = m_Bindless ? &bindingFlagsInfo : nullptr;
+	descriptorSetLayoutInfo.flags = m_Bindless ? VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT_EXT : 0;
+	descriptorSetLayoutInfo.bindingCount = 2;
+	descriptorSetLayoutInfo.pBindings = bindings;
+
+	// Create descriptor set layout
+	if (vkCreateDescriptorSetLayout(m_Device->GetDevice(), &descriptorSetLayoutInfo, nullptr, &m_DescriptorSetLayout) != VK_SUCCESS) {
+		throw std::runtime_error("Unable to create bindless descriptor set layout!");
+	}
+}
+
+// Create pool and sets, every slot points at the default resources
+void BindlessTable::CreateDescriptorSets(uint32_t setCount){
+	// Pool holding every slot of every set
+	VkDescriptorPoolSize poolSizes[2] = {};
+	poolSizes[0].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+	poolSizes[0].descriptorCount = m_TextureCapacity * setCount;
+	poolSizes[1].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+	poolSizes[1].descriptorCount = m_BufferCapacity * setCount;
+
+	// Descriptor pool creation info
+	VkDescriptorPoolCreateInfo poolInfo = {};
+	poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+	poolInfo.flags = m_Bindless ? VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT_EXT : 0;
+	poolInfo.maxSets = setCount;
+	poolInfo.poolSizeCount = 2;
+	poolInfo.pPoolSizes = poolSizes;
+
+	// Create descriptor pool
+	if (vkCreateDescriptorPool(m_Device->GetDevice(), &poolInfo, nullptr, &m_DescriptorPool) != VK_SUCCESS) {
+		throw std::runtime_error("Unable to create bindless descriptor pool!");
+	}
+
+	// Allocate sets
+	std::vector<VkDescriptorSetLayout> layouts(setCount, m_DescriptorSetLayout);
+	VkDescriptorSetAllocateInfo allocateInfo = {};
+	allocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+	allocateInfo.descriptorPool = m_DescriptorPool;
+	allocateInfo.descriptorSetCount = setCount;
+	allocateInfo.pSetLayouts = layouts.data();
+	m_DescriptorSets.resize(setCount);
+	if (vkAllocateDescriptorSets(m_Device->GetDevice(), &allocateInfo, m_DescriptorSets.data()) != VK_SUCCESS) {
+		throw std::runtime_error("Unable to allocate bindless descriptor sets!");
+	}
+
+	// Write every slot once, sets without partially bound descriptors must be fully valid
+	std::vector<uint32_t> textureSlots(m_TextureCapacity);
+	std::vector<uint32_t> bufferSlots(m_BufferCapacity);
+	for (uint32_t slot = 0; slot < m_TextureCapacity; slot++) textureSlots[slot] = slot;
+	for (uint32_t slot = 0; slot < m_BufferCapacity; slot++) bufferSlots[slot] = slot;
+	for (auto set : m_DescriptorSets) {
+		WriteSlots(set, textureSlots, bufferSlots);
+	}
+	m_DirtyTextures.resize(setCount);
+	m_DirtyBuffers.resize(setCount);
+}
+
+// Queue texture slot for every set, each set receives it once its frame finished
+void BindlessTable::WriteTexture(uint32_t slot){
+	for (auto& dirty : m_DirtyTextures) {
+		dirty.emplace_back(slot);
+	}
+}
+
+// Queue buffer slot for every set, each set receives it once its frame finished
+void BindlessTable::WriteBuffer(uint32_t slot){
+	for (auto& dirty : m_DirtyBuffers) {
+		dirty.emplace_back(slot);
+	}
+}
+
+// Write current descriptors of slots into set
+void BindlessTable::WriteSlots(VkDescriptorSet set, const std::vector<uint32_t>& textureSlots, const std::vector<uint32_t>& bufferSlots){
+	// One write per slot, slots written twice simply take their current descriptor twice
+	std::vector<VkWriteDescriptorSet> writes;
+	writes.reserve(textureSlots.size() + bufferSlots.size());
+	for (auto slot : textureSlots) {
+		VkWriteDescriptorSet write = {};
+		write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		write.dstSet = set;
+		write.dstBinding = TEXTURE_BINDING;
+		write.dstArrayElement = slot;
+		write.descriptorCount = 1;
+		write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+		write.pImageInfo = &m_TextureInfos[slot];
+		writes.emplace_back(write);
+	}
+	for (auto slot : bufferSlots) {
+		VkWriteDescriptorSet write = {};
+		write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		write.dstSet = set;
+		write.dstBinding = BUFFER_BINDING;
+		write.dstArrayElement = slot;
+		write.descriptorCount = 1;
+		write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+		write.pBufferInfo = &m_BufferInfos[slot];
+		writes.emplace_back(write);
+	}
+
+	// Update set
+	if (!writes.empty()) {
+		vkUpdateDescriptorSets(m_Device->GetDevice(), static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+	}
+}
+
+// Take a free slot, throws if binding is full
+uint32_t BindlessTable::AllocateSlot(SlotList& slots, const char* type){
+	// Reuse freed slot
+	if (!slots.freeSlots.empty()) {
+		auto slot = slots.freeSlots.back();
+		slots.freeSlots.pop_back();
+		return slot;
+	}
+
+	// Throw error if every slot is taken
+	if (slots.used == slots.capacity) {
+		throw std::runtime_error("Unable to add " + std::string(type) + ", bindless table is full!");
+	}
+	return slots.used++;
+}
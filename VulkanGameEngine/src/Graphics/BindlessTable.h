@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+#include "Buffer.h"
+#include "Device.h"
+#include "PhysicalDevice.h"
+#include "Texture.h"
+
+// Table slots a draw reads, pushed as push constants before the draw
+struct ResourceIndices {
+	uint32_t texture = 0;		// Texture slot sampled, slot 0 is opaque white
+	uint32_t buffer = 0;		// Storage buffer slot read, slot 0 is zeroed
+	uint32_t padding[2] = {};	// Pads range to 16 bytes
+};
+
+// Single descriptor set every graphics pipeline shares, textures and storage buffers are referenced by slot index instead of being bound per draw
+class BindlessTable {
+public:
+	BindlessTable(Device* device, PhysicalDevice* physicalDevice, MemoryAllocator* allocator, UploadManager* uploadManager, uint32_t framesInFlight);	// Constructor, falls back to small fully written sets if the device lacks descriptor indexing
+	~BindlessTable();	// Destructor
+
+	static constexpr uint32_t TEXTURE_BINDING = 0;			// Binding of combined image sampler array
+	static constexpr uint32_t BUFFER_BINDING = 1;			// Binding of storage buffer array
+	static constexpr uint32_t MAX_TEXTURES = 4096;			// Texture slots with descriptor indexing, clamped to update after bind limits
+	static constexpr uint32_t MAX_BUFFERS = 1024;			// Storage buffer slots with descriptor indexing, clamped to update after bind limits
+	static constexpr uint32_t FALLBACK_MAX_TEXTURES = 256;	// Texture slots without descriptor indexing, every slot is written so keep it small
+	static constexpr uint32_t FALLBACK_MAX_BUFFERS = 64;	// Storage buffer slots without descriptor indexing
+	static constexpr VkShaderStageFlags STAGES = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;	// Stages table and push constants are visible to
+
+	// FUNCTIONS
+	uint32_t AddTexture(Texture* texture);	// Write texture into a free slot and return its index
+	uint32_t AddBuffer(Buffer* buffer);		// Write storage buffer into a free slot and return its index
+	void SetTexture(uint32_t index, Texture* texture);	// Point slot at texture in place, indices taken before stay valid, caller keeps the previous texture alive until frames in flight finished
+	void RemoveTexture(uint32_t index);		// Point slot back at the default texture and free it, caller ensures no frame in flight reads it
+	void RemoveBuffer(uint32_t index);		// Point slot back at the default buffer and free it, caller ensures no frame in flight reads it
+	void Update(uint32_t frame);			// Write slots changed since frame's set was last used, caller ensures the frame's previous submission finished
+	void Bind(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, uint32_t frame) const;	// Bind frame's set as set 0, stays bound across pipelines sharing the table layout
+	static void Push(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, const ResourceIndices& indices);	// Push slots read by following draws
+
+	// GETTERS
+	const VkDescriptorSetLayout GetDescriptorSetLayout() const { return m_DescriptorSetLayout; }
+	const VkPushConstantRange GetPushConstantRange() const { return { STAGES, 0, sizeof(ResourceIndices) }; }
+	const uint32_t GetTextureCapacity() const { return m_TextureCapacity; }
+	const uint32_t GetBufferCapacity() const { return m_BufferCapacity; }
+	const bool GetBindless() const { return m_Bindless; }
+private:
+	// Slots of one binding, freed slots are reused first
+	struct SlotList {
+		uint32_t capacity = 0;				// Slots in binding
+		uint32_t used = 0;					// Slots handed out at least once
+		std::vector<uint32_t> freeSlots;	// Freed slots
+	};
+
+	// VARIABLES
+	Device* m_Device;					// Vulkan device
+	bool m_Bindless;					// True if sets are update after bind and partially bound, allowing larger slot arrays
+
+	VkDescriptorSetLayout m_DescriptorSetLayout = VK_NULL_HANDLE;	// Layout of set 0 of every graphics pipeline
+	VkDescriptorPool m_DescriptorPool = VK_NULL_HANDLE;				// Pool of table sets
+	std::vector<VkDescriptorSet> m_DescriptorSets;					// One set per frame in flight
+	uint32_t m_TextureCapacity;										// Texture slots
+	uint32_t m_BufferCapacity;										// Storage buffer slots
+
+	std::unique_ptr<Texture> m_DefaultTexture;	// Opaque white texture unused texture slots point at
+	std::unique_ptr<Buffer> m_DefaultBuffer;	// Zeroed storage buffer unused buffer slots point at
+	std::vector<VkDescriptorImageInfo> m_TextureInfos;	// Current descriptor of every texture slot
+	std::vector<VkDescriptorBufferInfo> m_BufferInfos;	// Current descriptor of every buffer slot
+	SlotList m_TextureSlots;							// Texture slot allocation
+	SlotList m_BufferSlots;								// Buffer slot allocation
+	std::vector<std::vector<uint32_t>> m_DirtyTextures;	// Texture slots each set has yet to receive
+	std::vector<std::vector<uint32_t>> m_DirtyBuffers;	// Buffer slots each set has yet to receive
+
+	// FUNCTIONS
+	void CreateDescriptorSetLayout();	// Create layout with an array binding per resource type
+	void CreateDescriptorSets(uint32_t setCount);	// Create pool and sets, every slot points at the default resources
+	void WriteTexture(uint32_t slot);	// Queue texture slot for every set, each set receives it once its frame finished
+	void WriteBuffer(uint32_t slot);	// Queue buffer slot for every set, each set receives it once its frame finished
+	void WriteSlots(VkDescriptorSet set, const std::vector<uint32_t>& textureSlots, const std::vector<uint32_t>& bufferSlots);	// Write current descriptors of slots into set
+	static uint32_t AllocateSlot(SlotList& slots, const char* type);	// Take a free slot, throws if binding is full
+};
@@ -7,8 +7,8 @@
 #include <stdexcept>
 
 // Constructor
-Buffer::Buffer(Device* device, PhysicalDevice* physicalDevice, VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, const void* data)
-: m_Size(size), m_Device(device), m_PhysicalDevice(physicalDevice) {
+Buffer::Buffer(Device* device, MemoryAllocator* allocator, VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, const void* data)
+: m_Size(size), m_Device(device), m_Allocator(allocator) {
 	// Query queue families
 	auto graphicsFamily = m_Device->GetGraphicsFamily();
 	auto presentFamily = m_Device->GetPresentFamily();
@@ -29,29 +29,16 @@ Buffer::Buffer(Device* device, PhysicalDevice* physicalDevice, VkDeviceSize size
 		throw std::runtime_error("Unable to create buffer!");
 	}
 
-	// Get memory requirements
-	VkMemoryRequirements memRequirements;
-	vkGetBufferMemoryRequirements(m_Device->GetDevice(), m_Buffer, &memRequirements);
-
-	// Memory allocation info
-	VkMemoryAllocateInfo allocInfo = {};
-	allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-	allocInfo.allocationSize = memRequirements.size;
-	allocInfo.memoryTypeIndex = FindMemoryType(memRequirements.memoryTypeBits, properties);
-
-	// Allocate memory
-	if (vkAllocateMemory(m_Device->GetDevice(), &allocInfo, nullptr, &m_BufferMemory) != VK_SUCCESS) {
-		throw std::runtime_error("Unable to allocate buffer memory!");
-	}
+	// Allocate memory from shared block and bind buffer to it
+	m_Allocation = m_Allocator->AllocateBuffer(m_Buffer, properties);
 
 	// Check if data has been passed, copy the data
-	void* mapped;
-	MapMemory(&mapped);
-	std::memcpy(mapped, data, size);
-	UnmapMemory();
-
-	// Bind buffer to memory
-	vkBindBufferMemory(m_Device->GetDevice(), m_Buffer, m_BufferMemory, 0);
+	if (data != nullptr) {
+		if (m_Allocation.mapped == nullptr) {
+			throw std::runtime_error("Unable to copy data to buffer that is not host visible!");
+		}
+		std::memcpy(m_Allocation.mapped, data, size);
+	}
 }
 
 // Destructor
@@ -59,42 +46,13 @@ Buffer::~Buffer(){
 	// Destroy buffer
 	std::cout << "Destroyed Buffer" << std::endl;
 	vkDestroyBuffer(m_Device->GetDevice(), m_Buffer, nullptr);
-	vkFreeMemory(m_Device->GetDevice(), m_BufferMemory, nullptr);
+	m_Allocator->Free(m_Allocation);
 }
 
-// Bind buffer
+// Bind buffer as vertex buffer
 void Buffer::Bind(VkCommandBuffer commandBuffer){
 	VkBuffer buffers[] = { m_Buffer };
 	VkDeviceSize offsets[] = { 0 };
 	vkCmdBindVertexBuffers(commandBuffer, 0, 1, buffers, offsets);
 }
 
-// Draw buffer
-void Buffer::Draw(VkCommandBuffer commandBuffer){
-	vkCmdDraw(commandBuffer, 3, 1, 0, 0);
-}
-
-// Map data to memory
-void Buffer::MapMemory(void** data) const{
-	vkMapMemory(m_Device->GetDevice(), m_BufferMemory, 0, m_Size, 0, data);
-}
-
-// Unmap data from memory
-void Buffer::UnmapMemory() const{
-	vkUnmapMemory(m_Device->GetDevice(), m_BufferMemory);
-}
-
-uint32_t Buffer::FindMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties){
-	// Query physical device properties
-	auto memProperties = m_PhysicalDevice->GetMemoryProperties();
-
-	// Loop through memory types
-	for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++) {
-		if ((typeFilter & (1 << i)) && (memProperties.memoryTypes[i].propertyFlags & properties) == properties) {
-			return i;
-		}
-	}
-
-	// If nothing found throw error
-	throw std::runtime_error("Unable to find suitable memory type!");
-}
@@ -3,34 +3,30 @@
 #include <vulkan/vulkan.h>
 
 #include "Device.h"
-#include "PhysicalDevice.h"
+#include "MemoryAllocator.h"
 
 class Graphics;
 
 class Buffer {
 public:
-	Buffer(Device* device, PhysicalDevice* physicalDevice, VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, const void *data);	// Constructor
+	Buffer(Device* device, MemoryAllocator* allocator, VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, const void *data);	// Constructor
 	~Buffer();	// Destructor
 
 	// FUNCTIONS
-	void Bind(VkCommandBuffer commandBuffer);	// Bind buffer
-	void Draw(VkCommandBuffer commandBuffer);	// Draw buffer
-	void MapMemory(void** data) const;	// Map data to memory
-	void UnmapMemory() const;			// Unmap data from memory
+	void Bind(VkCommandBuffer commandBuffer);	// Bind buffer as vertex buffer
 
 	// GETTERS
 	const VkDeviceSize GetSize() const { return m_Size; }
 	const VkBuffer GetBuffer() const { return m_Buffer; }
-	const VkDeviceMemory GetBufferMemory() const { return m_BufferMemory; }
+	const VkDeviceMemory GetBufferMemory() const { return m_Allocation.memory; }
+	const VkDeviceSize GetMemoryOffset() const { return m_Allocation.offset; }
+	void* GetMappedData() const { return m_Allocation.mapped; }
 private:
 	// VARIABLES
-	Device* m_Device;
-	PhysicalDevice* m_PhysicalDevice;
+	Device* m_Device;					// Vulkan device
+	MemoryAllocator* m_Allocator;		// Device memory allocator
 
 	VkDeviceSize m_Size;				// Buffer memory size
 	VkBuffer m_Buffer = VK_NULL_HANDLE; // Vulkan buffer
-	VkDeviceMemory m_BufferMemory = VK_NULL_HANDLE;	// Buffer memory
-
-	// FUNCTIONS
-	uint32_t FindMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties);
+	Allocation m_Allocation;			// Buffer memory
 };
\ No newline at end of file
@@ -0,0 +1,210 @@
+#include "ClusteredMesh.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "../Assets/MeshletBuilder.h"
+#include "../Core/Profiler.h"
+
+// Frustum planes of view projection with Vulkan's [0, 1] depth, cone culling off
+ClusterCullView ClusterCullView::FromViewProjection(const glm::mat4& viewProjection){
+	// Rows of view projection, glm matrices are column major
+	glm::vec4 rows[4];
+	for (int i = 0; i < 4; i++) {
+		rows[i] = glm::vec4(viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i]);
+	}
+
+	// Left, right, bottom, top, near and far planes, normalized so sphere radii compare directly
+	ClusterCullView view = {};
+	view.planes[0] = rows[3] + rows[0];
+	view.planes[1] = rows[3] - rows[0];
+	view.planes[2] = rows[3] + rows[1];
+	view.planes[3] = rows[3] - rows[1];
+	view.planes[4] = rows[2];
+	view.planes[5] = rows[3] - rows[2];
+	for (auto& plane : view.planes) {
+		auto length = glm::length(glm::vec3(plane));
+		if (length > 0.0f) {
+			plane /= length;
+		}
+	}
+	return view;
+}
+
+// Constructor
+ClusteredMesh::ClusteredMesh(Device* device, MemoryAllocator* allocator, UploadManager* uploadManager, ComputePipeline* cullPipeline, const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices, uint32_t framesInFlight)
+: m_Device(device), m_CullPipeline(cullPipeline) {
+	PROFILE_SCOPE("ClusteredMesh");
+
+	// Throw error if there is nothing to cluster
+	if (indices.size() < 3) {
+		throw std::runtime_error("Unable to create clustered mesh without triangles!");
+	}
+
+	// Split mesh into clusters
+	std::vector<glm::vec3> positions(vertices.size());
+	std::transform(vertices.begin(), vertices.end(), positions.begin(), [](const Vertex& vertex) { return vertex.GetPosition(); });
+	auto meshlets = MeshletBuilder::Build(indices, positions);
+	auto clusterIndices = MeshletBuilder::Flatten(meshlets);
+	m_ClusterCount = static_cast<uint32_t>(meshlets.meshlets.size());
+	m_IndexCount = static_cast<uint32_t>(clusterIndices.size());
+
+	// Culling data per cluster
+	std::vector<GpuCluster> clusters(m_ClusterCount);
+	for (uint32_t i = 0; i < m_ClusterCount; i++) {
+		auto& bounds = meshlets.bounds[i];
+		clusters[i] = {};
+		clusters[i].sphere = glm::vec4(bounds.centre, bounds.radius);
+		clusters[i].cone = glm::vec4(bounds.coneAxis, bounds.coneCutoff);
+		clusters[i].coneApex = bounds.coneApex;
+		clusters[i].firstIndex = meshlets.meshlets[i].triangleOffset;
+		clusters[i].triangleCount = meshlets.meshlets[i].triangleCount;
+	}
+
+	// Create vertex buffer, indices only exist on the GPU
+	m_Mesh = std::make_unique<Mesh>(m_Device, allocator, uploadManager, vertices);
+
+	// Create device local cluster and source index buffers and queue uploads
+	auto clusterSize = sizeof(clusters[0]) * clusters.size();
+	m_ClusterBuffer = std::make_unique<Buffer>(m_Device, allocator, clusterSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, nullptr);
+	uploadManager->UploadBuffer(m_ClusterBuffer.get(), clusters.data(), clusterSize);
+	auto indexSize = sizeof(clusterIndices[0]) * clusterIndices.size();
+	m_SourceIndexBuffer = std::make_unique<Buffer>(m_Device, allocator, indexSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, nullptr);
+	uploadManager->UploadBuffer(m_SourceIndexBuffer.get(), clusterIndices.data(), indexSize);
+
+	// Output buffers per frame in flight, written by cull and read by draw of the same frame
+	for (uint32_t i = 0; i < framesInFlight; i++) {
+		m_IndexBuffers.emplace_back(std::make_unique<Buffer>(m_Device, allocator, indexSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, nullptr));
+		m_DrawBuffers.emplace_back(std::make_unique<Buffer>(m_Device, allocator, sizeof(VkDrawIndexedIndirectCommand), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, nullptr));
+	}
+	CreateDescriptorSets(framesInFlight);
+}
+
+// Destructor
+ClusteredMesh::~ClusteredMesh(){
+	// Destroy descriptor pool, freeing its sets
+	vkDestroyDescriptorPool(m_Device->GetDevice(), m_DescriptorPool, nullptr);
+}
+
+// Descriptor bindings of cluster_cull.comp
+std::vector<VkDescriptorSetLayoutBinding> ClusteredMesh::GetCullBindings(){
+	// Clusters, source indices, output indices and draw command, all storage buffers
+	std::vector<VkDescriptorSetLayoutBinding> bindings(4);
+	for (uint32_t i = 0; i < bindings.size(); i++) {
+		bindings[i] = {};
+		bindings[i].binding = i;
+		bindings[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+		bindings[i].descriptorCount = 1;
+		bindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+	}
+	return bindings;
+}
+
+// Record cull of clusters into index buffer of frame, outside of render pass
+void ClusteredMesh::RecordCull(VkCommandBuffer commandBuffer, uint32_t frame, ClusterCullView view){
+	// Reset draw command, index count is accumulated by visible clusters
+	auto drawBuffer = m_DrawBuffers[frame]->GetBuffer();
+	VkDrawIndexedIndirectCommand command = { 0, 1, 0, 0, 0 };
+	vkCmdUpdateBuffer(commandBuffer, drawBuffer, 0, sizeof(command), &command);
+
+	// Cull pass reads and atomically adds to reset command
+	VkBufferMemoryBarrier resetBarrier = {};
+	resetBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+	resetBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+	resetBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+	resetBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	resetBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	resetBarrier.buffer = drawBuffer;
+	resetBarrier.offset = 0;
+	resetBarrier.size = VK_WHOLE_SIZE;
+	vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0, nullptr, 1, &resetBarrier, 0, nullptr);
+
+	// Dispatch a workgroup per cluster, up to the workgroup limit
+	view.clusterCount = m_ClusterCount;
+	m_CullPipeline->Bind(commandBuffer);
+	vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_CullPipeline->GetPipelineLayout(), 0, 1, &m_DescriptorSets[frame], 0, nullptr);
+	vkCmdPushConstants(commandBuffer, m_CullPipeline->GetPipelineLayout(), VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(view), &view);
+	vkCmdDispatch(commandBuffer, std::min(m_ClusterCount, MAX_WORKGROUPS), 1, 1);
+
+	// Draw waits for compacted indices and final count
+	VkBufferMemoryBarrier cullBarriers[2] = {};
+	for (auto& barrier : cullBarriers) {
+		barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+		barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+		barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.offset = 0;
+		barrier.size = VK_WHOLE_SIZE;
+	}
+	cullBarriers[0].dstAccessMask = VK_ACCESS_INDEX_READ_BIT;
+	cullBarriers[0].buffer = m_IndexBuffers[frame]->GetBuffer();
+	cullBarriers[1].dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+	cullBarriers[1].buffer = drawBuffer;
+	vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, 0, 0, nullptr, 2, cullBarriers, 0, nullptr);
+}
+
+// Bind vertex buffer and culled index buffer of frame
+void ClusteredMesh::Bind(VkCommandBuffer commandBuffer, uint32_t frame){
+	// Bind vertex buffer
+	m_Mesh->Bind(commandBuffer);
+
+	// Bind compacted indices written by this frame's cull
+	vkCmdBindIndexBuffer(commandBuffer, m_IndexBuffers[frame]->GetBuffer(), 0, VK_INDEX_TYPE_UINT32);
+}
+
+// Draw culled indices of frame with count written by cull
+void ClusteredMesh::Draw(VkCommandBuffer commandBuffer, uint32_t frame){
+	vkCmdDrawIndexedIndirect(commandBuffer, m_DrawBuffers[frame]->GetBuffer(), 0, 1, sizeof(VkDrawIndexedIndirectCommand));
+}
+
+// Create pool and point a set per frame at its buffers
+void ClusteredMesh::CreateDescriptorSets(uint32_t framesInFlight){
+	// Pool holding four storage buffers per frame
+	VkDescriptorPoolSize poolSize = {};
+	poolSize.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+	poolSize.descriptorCount = 4 * framesInFlight;
+
+	// Descriptor pool creation info
+	VkDescriptorPoolCreateInfo poolInfo = {};
+	poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+	poolInfo.maxSets = framesInFlight;
+	poolInfo.poolSizeCount = 1;
+	poolInfo.pPoolSizes = &poolSize;
+
+	// Create descriptor pool
+	if (vkCreateDescriptorPool(m_Device->GetDevice(), &poolInfo, nullptr, &m_DescriptorPool) != VK_SUCCESS) {
+		throw std::runtime_error("Unable to create cluster descriptor pool!");
+	}
+
+	// Allocate a set per frame
+	std::vector<VkDescriptorSetLayout> layouts(framesInFlight, m_CullPipeline->GetDescriptorSetLayout());
+	VkDescriptorSetAllocateInfo allocateInfo = {};
+	allocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+	allocateInfo.descriptorPool = m_DescriptorPool;
+	allocateInfo.descriptorSetCount = framesInFlight;
+	allocateInfo.pSetLayouts = layouts.data();
+	m_DescriptorSets.resize(framesInFlight);
+	if (vkAllocateDescriptorSets(m_Device->GetDevice(), &allocateInfo, m_DescriptorSets.data()) != VK_SUCCESS) {
+		throw std::runtime_error("Unable to allocate cluster descriptor sets!");
+	}
+
+	// Shared inputs and this frame's outputs, in binding order
+	for (uint32_t i = 0; i < framesInFlight; i++) {
+		VkDescriptorBufferInfo bufferInfos[4] = {
+			{ m_ClusterBuffer->GetBuffer(), 0, VK_WHOLE_SIZE },
+			{ m_SourceIndexBuffer->GetBuffer(), 0, VK_WHOLE_SIZE },
+			{ m_IndexBuffers[i]->GetBuffer(), 0, VK_WHOLE_SIZE },
+			{ m_DrawBuffers[i]->GetBuffer(), 0, VK_WHOLE_SIZE },
+		};
+		VkWriteDescriptorSet writes[4] = {};
+		for (uint32_t binding = 0; binding < 4; binding++) {
+			writes[binding].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+			writes[binding].dstSet = m_DescriptorSets[i];
+			writes[binding].dstBinding = binding;
+			writes[binding].descriptorCount = 1;
+			writes[binding].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+			writes[binding].pBufferInfo = &bufferInfos[binding];
+		}
+		vkUpdateDescriptorSets(m_Device->GetDevice(), 4, writes, 0, nullptr);
+	}
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <memory>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+#include "Buffer.h"
+#include "ComputePipeline.h"
+#include "Device.h"
+#include "MemoryAllocator.h"
+#include "Mesh.h"
+#include "UploadManager.h"
+#include "Vertex.h"
+
+// Culling data of a cluster as read by cluster_cull.comp, std430 layout
+struct GpuCluster {
+	glm::vec4 sphere;			// Bounding sphere centre and radius
+	glm::vec4 cone;				// Normal cone axis and cutoff, cutoff of 1 never culls
+	glm::vec3 coneApex;			// Normal cone apex
+	uint32_t firstIndex;		// First index of cluster in source indices
+	uint32_t triangleCount;		// Triangles of cluster
+	uint32_t padding[3];		// Pads cluster to 16 byte std430 alignment
+};
+static_assert(sizeof(GpuCluster) == 64, "GpuCluster must match std430 layout of cluster_cull.comp!");
+
+// Push constants of cluster_cull.comp, view is given in object space
+struct ClusterCullView {
+	glm::vec4 planes[6];		// Frustum planes, inside where dot(plane.xyz, p) + plane.w >= 0
+	glm::vec3 cameraPosition;	// Camera position, only used for cone culling
+	uint32_t clusterCount;		// Clusters of mesh, filled in per mesh
+	uint32_t coneCulling;		// Nonzero if camera position is known
+
+	static ClusterCullView FromViewProjection(const glm::mat4& viewProjection);	// Frustum planes of view projection with Vulkan's [0, 1] depth, cone culling off
+};
+static_assert(sizeof(ClusterCullView) == 116, "ClusterCullView must match push constants of cluster_cull.comp!");
+
+class ClusteredMesh {
+public:
+	static constexpr uint32_t MAX_WORKGROUPS = 65535;	// Guaranteed workgroup count limit, workgroups loop over remaining clusters
+
+	ClusteredMesh(Device* device, MemoryAllocator* allocator, UploadManager* uploadManager, ComputePipeline* cullPipeline, const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices, uint32_t framesInFlight);	// Constructor, indices should already be cache optimized as clusters follow their order
+	~ClusteredMesh();	// Destructor
+
+	// Descriptor bindings of cluster_cull.comp
+	static std::vector<VkDescriptorSetLayoutBinding> GetCullBindings();
+
+	// FUNCTIONS
+	void RecordCull(VkCommandBuffer commandBuffer, uint32_t frame, ClusterCullView view);	// Record cull of clusters into index buffer of frame, outside of render pass
+	void Bind(VkCommandBuffer commandBuffer, uint32_t frame);	// Bind vertex buffer and culled index buffer of frame
+	void Draw(VkCommandBuffer commandBuffer, uint32_t frame);	// Draw culled indices of frame with count written by cull
+
+	// GETTERS
+	Mesh* GetMesh() const { return m_Mesh.get(); }
+	const uint32_t GetClusterCount() const { return m_ClusterCount; }
+	const uint32_t GetIndexCount() const { return m_IndexCount; }
+private:
+	// VARIABLES
+	Device* m_Device;					// Vulkan device
+	ComputePipeline* m_CullPipeline;	// Cull pipeline, owned by graphics
+
+	uint32_t m_ClusterCount;						// Amount of clusters
+	uint32_t m_IndexCount;							// Indices of every cluster
+	std::unique_ptr<Mesh> m_Mesh;					// Vertex buffer, drawn with culled indices
+	std::unique_ptr<Buffer> m_ClusterBuffer;		// Device local cluster culling data
+	std::unique_ptr<Buffer> m_SourceIndexBuffer;	// Device local indices of every cluster back to back
+	std::vector<std::unique_ptr<Buffer>> m_IndexBuffers;	// Compacted indices of visible clusters per frame in flight
+	std::vector<std::unique_ptr<Buffer>> m_DrawBuffers;		// Indirect draw command per frame in flight
+	VkDescriptorPool m_DescriptorPool = VK_NULL_HANDLE;		// Pool of cull descriptor sets
+	std::vector<VkDescriptorSet> m_DescriptorSets;			// Cull descriptor set per frame in flight
+
+	// FUNCTIONS
+	void CreateDescriptorSets(uint32_t framesInFlight);	// Create pool and point a set per frame at its buffers
+};
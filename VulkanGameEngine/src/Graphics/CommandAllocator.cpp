@@ -0,0 +1,52 @@
+#include "CommandAllocator.h"
+
+#include <stdexcept>
+
+// Constructor
+CommandAllocator::CommandAllocator(Device* device, uint32_t queueFamily, uint32_t frameCount, VkCommandPoolCreateFlags flags)
+: m_Device(device) {
+	// Create pool per frame
+	m_Frames.resize(frameCount);
+	for (auto& frame : m_Frames) {
+		frame.commandPool = std::make_unique<CommandPool>(m_Device, queueFamily, flags);
+	}
+}
+
+// Destructor
+CommandAllocator::~CommandAllocator(){
+	// Free command buffers before their pools
+	for (auto& frame : m_Frames) {
+		frame.primaryBuffers.clear();
+		frame.secondaryBuffers.clear();
+	}
+}
+
+// Reset pool of frame, its fence must have signalled
+void CommandAllocator::BeginFrame(uint32_t frameIndex){
+	// Throw error if frame does not exist
+	if (frameIndex >= m_Frames.size()) {
+		throw std::runtime_error("Unable to begin command allocator frame out of range!");
+	}
+
+	// Reset whole pool at once, buffers keep their allocations for reuse
+	m_FrameIndex = frameIndex;
+	auto& frame = m_Frames[m_FrameIndex];
+	frame.commandPool->Reset();
+	frame.primaryUsed = 0;
+	frame.secondaryUsed = 0;
+}
+
+// Hand out command buffer from current frame, reusing earlier allocations
+CommandBuffer* CommandAllocator::Allocate(VkCommandBufferLevel level){
+	// Pick buffers of requested level
+	auto& frame = m_Frames[m_FrameIndex];
+	bool primary = level == VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+	auto& buffers = primary ? frame.primaryBuffers : frame.secondaryBuffers;
+	auto& used = primary ? frame.primaryUsed : frame.secondaryUsed;
+
+	// Only allocate when frame needs more buffers than ever before
+	if (used == buffers.size()) {
+		buffers.emplace_back(std::make_unique<CommandBuffer>(m_Device, frame.commandPool.get(), level));
+	}
+	return buffers[used++].get();
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+#include "CommandBuffer.h"
+#include "CommandPool.h"
+#include "Device.h"
+
+class CommandAllocator {
+public:
+	CommandAllocator(Device* device, uint32_t queueFamily, uint32_t frameCount, VkCommandPoolCreateFlags flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT);	// Constructor, one pool per frame in flight
+	~CommandAllocator();	// Destructor
+
+	// FUNCTIONS
+	void BeginFrame(uint32_t frameIndex);	// Reset pool of frame, its fence must have signalled
+	CommandBuffer* Allocate(VkCommandBufferLevel level = VK_COMMAND_BUFFER_LEVEL_PRIMARY);	// Hand out command buffer from current frame, reusing earlier allocations
+
+	// GETTERS
+	const uint32_t GetFrameCount() const { return static_cast<uint32_t>(m_Frames.size()); }
+	const uint32_t GetFrameIndex() const { return m_FrameIndex; }
+private:
+	// Command pool and buffers of one frame in flight
+	struct Frame {
+		std::unique_ptr<CommandPool> commandPool;						// Pool reset as a whole
+		std::vector<std::unique_ptr<CommandBuffer>> primaryBuffers;		// Primary buffers allocated so far
+		std::vector<std::unique_ptr<CommandBuffer>> secondaryBuffers;	// Secondary buffers allocated so far
+		size_t primaryUsed = 0;		// Primary buffers handed out this frame
+		size_t secondaryUsed = 0;	// Secondary buffers handed out this frame
+	};
+
+	// VARIABLES
+	Device* m_Device;				// Vulkan device
+
+	std::vector<Frame> m_Frames;	// Pools per frame in flight
+	uint32_t m_FrameIndex = 0;		// Frame buffers are handed out from
+};
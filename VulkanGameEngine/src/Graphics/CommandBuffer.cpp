@@ -3,14 +3,14 @@
 #include <stdexcept>
 
 // Constructor
-CommandBuffer::CommandBuffer(Device* device, CommandPool* commandPool)
+CommandBuffer::CommandBuffer(Device* device, CommandPool* commandPool, VkCommandBufferLevel level)
 : m_Device(device), m_CommandPool(commandPool) {
 	// Buffer allocation info
 	auto commandPoolUse = m_CommandPool->GetCommandPool();
 	VkCommandBufferAllocateInfo allocInfo = {};
 	allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
 	allocInfo.commandPool = commandPoolUse;
-	allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+	allocInfo.level = level;
 	allocInfo.commandBufferCount = 1;
 
 	// Create command buffer
@@ -29,7 +29,7 @@ CommandBuffer::~CommandBuffer(){
 }
 
 // Begin command buffer
-void CommandBuffer::Begin(VkCommandBufferUsageFlags usage){
+void CommandBuffer::Begin(VkCommandBufferUsageFlags usage, const VkCommandBufferInheritanceInfo* inheritance){
 	// Return if already running
 	if (m_Running) return;
 
@@ -37,6 +37,7 @@ void CommandBuffer::Begin(VkCommandBufferUsageFlags usage){
 	VkCommandBufferBeginInfo beginInfo = {};
 	beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
 	beginInfo.flags = usage;
+	beginInfo.pInheritanceInfo = inheritance;
 	
 	// Begin command buffer
 	if (vkBeginCommandBuffer(m_CommandBuffer,  &beginInfo) != VK_SUCCESS) {
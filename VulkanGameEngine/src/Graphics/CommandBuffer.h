@@ -5,11 +5,11 @@
 
 class CommandBuffer {
 public:
-	CommandBuffer(Device* device, CommandPool* commandPool);	// Constructor
+	CommandBuffer(Device* device, CommandPool* commandPool, VkCommandBufferLevel level = VK_COMMAND_BUFFER_LEVEL_PRIMARY);	// Constructor
 	~CommandBuffer();	// Destructor
 
 	// FUNCTIONS
-	void Begin(VkCommandBufferUsageFlags usage = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);	// Begin command buffer
+	void Begin(VkCommandBufferUsageFlags usage = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT, const VkCommandBufferInheritanceInfo* inheritance = nullptr);	// Begin command buffer, inheritance required for secondary buffers
 	void End();	// End command buffer
 	void Submit(const VkSemaphore& waitSemaphore, const VkSemaphore& signalSemaphore, VkFence currentFence);	// Submit command buffer
 
@@ -3,14 +3,13 @@
 #include <stdexcept>
 
 // Constructor
-CommandPool::CommandPool(Device* device, PhysicalDevice* physicalDevice)
-: m_Device(device) {
+CommandPool::CommandPool(Device* device, uint32_t queueFamily, VkCommandPoolCreateFlags flags)
+: m_Device(device), m_QueueFamily(queueFamily) {
 	// Command pool creation info
-	auto graphicsFamily = m_Device->GetGraphicsFamily();
 	VkCommandPoolCreateInfo poolInfo = {};
 	poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
-	poolInfo.queueFamilyIndex = graphicsFamily;
-	poolInfo.flags = 0;
+	poolInfo.queueFamilyIndex = m_QueueFamily;
+	poolInfo.flags = flags;
 
 	// Create command pool
 	if (vkCreateCommandPool(m_Device->GetDevice(), &poolInfo, nullptr, &m_CommandPool) != VK_SUCCESS) {
@@ -23,3 +22,11 @@ CommandPool::~CommandPool(){
 	// Destroy command pool
 	vkDestroyCommandPool(m_Device->GetDevice(), m_CommandPool, nullptr);
 }
+
+// Reset every command buffer allocated from pool, none may be pending
+void CommandPool::Reset(){
+	// Reset command pool, keeping its memory for reuse
+	if (vkResetCommandPool(m_Device->GetDevice(), m_CommandPool, 0) != VK_SUCCESS) {
+		throw std::runtime_error("Unable to reset command pool!");
+	}
+}
@@ -1,18 +1,22 @@
 #pragma once
 
 #include "Device.h"
-#include "PhysicalDevice.h"
 
 class CommandPool {
 public:
-	CommandPool(Device* device, PhysicalDevice* physicalDevice);	// Constructor
+	CommandPool(Device* device, uint32_t queueFamily, VkCommandPoolCreateFlags flags = 0);	// Constructor
 	~CommandPool();	// Destructor
 
+	// FUNCTIONS
+	void Reset();	// Reset every command buffer allocated from pool, none may be pending
+
 	// GETTERS
 	const VkCommandPool GetCommandPool() const { return m_CommandPool; }
+	uint32_t GetQueueFamily() const { return m_QueueFamily; }
 private:
 	// VARIABLES
 	Device* m_Device;					// Vulkan device
+	uint32_t m_QueueFamily;				// Queue family command buffers are submitted to
 
 	VkCommandPool m_CommandPool;		// Vulkan command pool
 };
\ No newline at end of file
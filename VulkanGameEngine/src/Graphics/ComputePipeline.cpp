@@ -0,0 +1,72 @@
+#include "ComputePipeline.h"
+
+#include <stdexcept>
+
+// Constructor
+ComputePipeline::ComputePipeline(Device* device, PipelineCache* pipelineCache, const std::string& shaderPath, const std::vector<VkDescriptorSetLayoutBinding>& bindings, uint32_t pushConstantSize)
+: m_Device(device) {
+	// Create shader
+	Shader computeShader(m_Device, VK_SHADER_STAGE_COMPUTE_BIT, shaderPath);
+
+	// Descriptor set layout creation info
+	VkDescriptorSetLayoutCreateInfo descriptorSetLayoutInfo = {};
+	descriptorSetLayoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+	descriptorSetLayoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+	descriptorSetLayoutInfo.pBindings = bindings.data();
+
+	// Create descriptor set layout
+	if (vkCreateDescriptorSetLayout(m_Device->GetDevice(), &descriptorSetLayoutInfo, nullptr, &m_DescriptorSetLayout) != VK_SUCCESS) {
+		throw std::runtime_error("Unable to create compute descriptor set layout!");
+	}
+
+	// Push constant range, omitted if pipeline has none
+	VkPushConstantRange pushConstantRange = {};
+	pushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+	pushConstantRange.offset = 0;
+	pushConstantRange.size = pushConstantSize;
+
+	// Pipeline layout creation info
+	VkPipelineLayoutCreateInfo pipelineLayoutInfo = {};
+	pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+	pipelineLayoutInfo.setLayoutCount = 1;
+	pipelineLayoutInfo.pSetLayouts = &m_DescriptorSetLayout;
+	pipelineLayoutInfo.pushConstantRangeCount = pushConstantSize > 0 ? 1 : 0;
+	pipelineLayoutInfo.pPushConstantRanges = pushConstantSize > 0 ? &pushConstantRange : nullptr;
+
+	// Create pipeline layout
+	if (vkCreatePipelineLayout(m_Device->GetDevice(), &pipelineLayoutInfo, nullptr, &m_PipelineLayout) != VK_SUCCESS) {
+		throw std::runtime_error("Unable to create compute pipeline layout!");
+	}
+
+	// Pipeline creation info
+	VkComputePipelineCreateInfo pipelineInfo = {};
+	pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+	pipelineInfo.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+	pipelineInfo.stage.stage = computeShader.GetShaderStage();
+	pipelineInfo.stage.module = computeShader.GetShaderModule();
+	pipelineInfo.stage.pName = "main";
+	pipelineInfo.layout = m_PipelineLayout;
+	pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
+	pipelineInfo.basePipelineIndex = -1;
+
+	// Create compute pipeline through shared cache
+	if (vkCreateComputePipelines(m_Device->GetDevice(), pipelineCache->GetPipelineCache(), 1, &pipelineInfo, nullptr, &m_ComputePipeline) != VK_SUCCESS) {
+		throw std::runtime_error("Unable to create compute pipeline!");
+	}
+}
+
+// Destructor
+ComputePipeline::~ComputePipeline(){
+	// Destroy compute pipeline
+	vkDestroyPipeline(m_Device->GetDevice(), m_ComputePipeline, nullptr);
+
+	// Destroy pipeline layout and descriptor set layout
+	vkDestroyPipelineLayout(m_Device->GetDevice(), m_PipelineLayout, nullptr);
+	vkDestroyDescriptorSetLayout(m_Device->GetDevice(), m_DescriptorSetLayout, nullptr);
+}
+
+// Bind compute pipeline to command buffer
+void ComputePipeline::Bind(VkCommandBuffer commandBuffer){
+	// Bind compute pipeline
+	vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_ComputePipeline);
+}
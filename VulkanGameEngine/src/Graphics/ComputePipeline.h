@@ -0,0 +1,30 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+#include "Device.h"
+#include "PipelineCache.h"
+#include "Shader.h"
+
+class ComputePipeline {
+public:
+	ComputePipeline(Device* device, PipelineCache* pipelineCache, const std::string& shaderPath, const std::vector<VkDescriptorSetLayoutBinding>& bindings, uint32_t pushConstantSize = 0);	// Constructor, bindings form descriptor set 0, push constants start at offset 0
+	~ComputePipeline();	// Destructor
+
+	// FUNCTIONS
+	void Bind(VkCommandBuffer commandBuffer);	// Bind compute pipeline to command buffer
+
+	// GETTERS
+	const VkPipeline GetComputePipeline() const { return m_ComputePipeline; }
+	const VkPipelineLayout GetPipelineLayout() const { return m_PipelineLayout; }
+	const VkDescriptorSetLayout GetDescriptorSetLayout() const { return m_DescriptorSetLayout; }
+private:
+	// VARIABLES
+	Device* m_Device;			// Vulkan device
+
+	VkPipeline m_ComputePipeline = VK_NULL_HANDLE;				// Vulkan compute pipeline
+	VkPipelineLayout m_PipelineLayout = VK_NULL_HANDLE;			// Vulkan pipeline layout
+	VkDescriptorSetLayout m_DescriptorSetLayout = VK_NULL_HANDLE;	// Layout of descriptor set 0
+};
@@ -37,9 +37,11 @@ void Device::CreateQueueIndices(){
 			m_SupportedQueues |= VK_QUEUE_GRAPHICS_BIT;
 		}
 
-		// Check for presentation support
-		VkBool32 presentSupport;
-		vkGetPhysicalDeviceSurfaceSupportKHR(m_PhysicalDevice->GetPhysicalDevice(), i, m_Surface->GetSurface(), &presentSupport);
+		// Check for presentation support, no surface means headless
+		VkBool32 presentSupport = VK_FALSE;
+		if (m_Surface != nullptr) {
+			vkGetPhysicalDeviceSurfaceSupportKHR(m_PhysicalDevice->GetPhysicalDevice(), i, m_Surface->GetSurface(), &presentSupport);
+		}
 		
 		if (deviceQueueFamilyProperties[i].queueCount > 0 && presentSupport) {
 			presentFamily = i;
@@ -61,16 +63,33 @@ void Device::CreateQueueIndices(){
 		}
 
 		// Break if all found
-		if (graphicsFamily && presentFamily && computeFamily && transferFamily) {
+		if (graphicsFamily && (presentFamily || m_Surface == nullptr) && computeFamily && transferFamily) {
 			break;
 		}
 
 	}
 
+	// Prefer a transfer only family, usually backed by DMA engines, so uploads run beside rendering
+	for (uint32_t i = 0; i < deviceQueueFamilyPropertyCount; i++) {
+		auto flags = deviceQueueFamilyProperties[i].queueFlags;
+		if ((flags & VK_QUEUE_TRANSFER_BIT) && !(flags & VK_QUEUE_GRAPHICS_BIT) && !(flags & VK_QUEUE_COMPUTE_BIT)) {
+			m_TransferFamily = i;
+			break;
+		}
+	}
+
 	// Throw error if graphics family not supported
 	if (!graphicsFamily) {
 		throw std::runtime_error("Failed to find queue family supporting VK_QUEUE_GRAPHICS_BIT!");
 	}
+
+	// Image copies on the transfer family have to be aligned to its granularity
+	m_TransferGranularity = deviceQueueFamilyProperties[m_TransferFamily].minImageTransferGranularity;
+
+	// Without a surface there is nothing to present to, alias present onto graphics
+	if (m_Surface == nullptr) {
+		m_PresentFamily = m_GraphicsFamily;
+	}
 }
 
 // Create logical device with available queue families
@@ -132,6 +151,37 @@ void Device::CreateLogicalDevice(){
 		std::cout << "Selected GPU does not support sampler anisotropy!" << std::endl;
 	}
 
+	// Enable BC texture formats, cooked textures are block compressed
+	if (physicalDeviceFeatures.textureCompressionBC) {
+		enabledFeatures.textureCompressionBC = VK_TRUE;
+	}
+
+	// Enable pipeline statistics queries for GPU profiling
+	if (physicalDeviceFeatures.pipelineStatisticsQuery) {
+		enabledFeatures.pipelineStatisticsQuery = VK_TRUE;
+	}
+
+	// Enable dynamically uniform indexing of texture and storage buffer arrays, resource tables are indexed by push constants
+	enabledFeatures.shaderSampledImageArrayDynamicIndexing = physicalDeviceFeatures.shaderSampledImageArrayDynamicIndexing;
+	enabledFeatures.shaderStorageBufferArrayDynamicIndexing = physicalDeviceFeatures.shaderStorageBufferArrayDynamicIndexing;
+
+	// Enable descriptor indexing if every feature bindless resource tables rely on is present
+	auto supportedIndexing = m_PhysicalDevice->GetDescriptorIndexingFeatures();
+	VkPhysicalDeviceDescriptorIndexingFeaturesEXT indexingFeatures = {};
+	indexingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+	indexingFeatures.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+	indexingFeatures.shaderStorageBufferArrayNonUniformIndexing = VK_TRUE;
+	indexingFeatures.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+	indexingFeatures.descriptorBindingStorageBufferUpdateAfterBind = VK_TRUE;
+	indexingFeatures.descriptorBindingUpdateUnusedWhilePending = VK_TRUE;
+	indexingFeatures.descriptorBindingPartiallyBound = VK_TRUE;
+	m_DescriptorIndexing = supportedIndexing.shaderSampledImageArrayNonUniformIndexing && supportedIndexing.shaderStorageBufferArrayNonUniformIndexing
+		&& supportedIndexing.descriptorBindingSampledImageUpdateAfterBind && supportedIndexing.descriptorBindingStorageBufferUpdateAfterBind
+		&& supportedIndexing.descriptorBindingUpdateUnusedWhilePending && supportedIndexing.descriptorBindingPartiallyBound;
+	if (!m_DescriptorIndexing) {
+		std::cout << "Selected GPU does not support descriptor indexing, falling back to per frame descriptor sets!" << std::endl;
+	}
+
 	// Logical device create info
 	VkDeviceCreateInfo deviceCreateInfo = {};
 	deviceCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
@@ -145,14 +195,20 @@ void Device::CreateLogicalDevice(){
 	else {
 		deviceCreateInfo.enabledLayerCount = 0;
 	}
-	deviceCreateInfo.enabledExtensionCount = static_cast<uint32_t>(Instance::m_DeviceExtensions.size());
-	deviceCreateInfo.ppEnabledExtensionNames = Instance::m_DeviceExtensions.data();
+	auto deviceExtensions = m_Instance->GetDeviceExtensions();
+	if (m_DescriptorIndexing) {
+		deviceExtensions.emplace_back(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME);
+		deviceCreateInfo.pNext = &indexingFeatures;
+	}
+	deviceCreateInfo.enabledExtensionCount = static_cast<uint32_t>(deviceExtensions.size());
+	deviceCreateInfo.ppEnabledExtensionNames = deviceExtensions.data();
 	deviceCreateInfo.pEnabledFeatures = &enabledFeatures;
 
 	// Create logical device
 	if (vkCreateDevice(m_PhysicalDevice->GetPhysicalDevice(), &deviceCreateInfo, nullptr, &m_Device) != VK_SUCCESS) {
 		throw std::runtime_error("Unable to create logical device!");
 	}
+	m_EnabledFeatures = enabledFeatures;
 
 	// Get queues
 	vkGetDeviceQueue(m_Device, m_GraphicsFamily, 0, &m_GraphicsQueue);
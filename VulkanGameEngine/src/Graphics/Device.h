@@ -14,6 +14,7 @@ public:
 	// GETTERS
 	const VkDevice GetDevice() const { return m_Device; }
 	const VkPhysicalDeviceFeatures GetEnabledFeatures() const { return m_EnabledFeatures; }
+	const bool GetDescriptorIndexing() const { return m_DescriptorIndexing; }
 	const VkQueue GetGraphicsQueue() const { return m_GraphicsQueue; }
 	const VkQueue GetPresentQueue() const { return m_PresentQueue; }
 	const VkQueue GetComputeQueue() const { return m_ComputeQueue; }
@@ -22,6 +23,7 @@ public:
 	uint32_t GetPresentFamily() const { return m_PresentFamily; }
 	uint32_t GetComputeFamily() const { return m_ComputeFamily; }
 	uint32_t GetTransferFamily() const { return m_TransferFamily; }
+	const VkExtent3D GetTransferGranularity() const { return m_TransferGranularity; }
 private:
 	// VARIABLES
 	const Instance* m_Instance;					// Vulkan instance object
@@ -30,12 +32,14 @@ private:
 
 	VkDevice m_Device = VK_NULL_HANDLE;	// Vulkan logical device
 	VkPhysicalDeviceFeatures m_EnabledFeatures = {};	// Enabled features
+	bool m_DescriptorIndexing = false;					// True if descriptor indexing is enabled for update after bind, partially bound descriptor arrays
 
 	VkQueueFlags m_SupportedQueues = {};		// List of supported queues
 	uint32_t m_GraphicsFamily = 0;				// Graphics family
 	uint32_t m_PresentFamily = 0;				// Present family
 	uint32_t m_ComputeFamily = 0;				// Compute family
 	uint32_t m_TransferFamily = 0;				// Transfer family
+	VkExtent3D m_TransferGranularity = {};		// Image copy granularity of transfer family, in texel blocks
 
 	VkQueue m_GraphicsQueue = VK_NULL_HANDLE;	// Vulkan graphics queue
 	VkQueue m_PresentQueue = VK_NULL_HANDLE;	// Vulkan present queue
@@ -3,15 +3,15 @@
 #include <stdexcept>
 
 // Constructor
-Framebuffers::Framebuffers(Device* device, RenderPass* renderPass, Swapchain* swapchain)
-: m_Device(device), m_RenderPass(renderPass), m_Swapchain(swapchain) {
+Framebuffers::Framebuffers(Device* device, RenderPass* renderPass, RenderTarget* renderTarget)
+: m_Device(device), m_RenderPass(renderPass), m_RenderTarget(renderTarget) {
 	// Resize framebuffers to fit all images
-	m_Framebuffers.resize(m_Swapchain->GetImageCount());
+	m_Framebuffers.resize(m_RenderTarget->GetImageCount());
 
 	// Loop through swapchain image views
-	for (size_t i = 0; i < m_Swapchain->GetImageCount(); i++) {
+	for (size_t i = 0; i < m_RenderTarget->GetImageCount(); i++) {
 		// Get image view
-		VkImageView imageView = m_Swapchain->GetImageViews()[i];
+		VkImageView imageView = m_RenderTarget->GetImageViews()[i];
 		VkImageView attachments[] = { imageView };
 
 		// Framebuffer creation info
@@ -20,8 +20,8 @@ Framebuffers::Framebuffers(Device* device, RenderPass* renderPass, Swapchain* sw
 		framebufferInfo.renderPass = m_RenderPass->GetRenderPass();
 		framebufferInfo.attachmentCount = 1;
 		framebufferInfo.pAttachments = attachments;
-		framebufferInfo.width = m_Swapchain->GetExtent().width;
-		framebufferInfo.height = m_Swapchain->GetExtent().height;
+		framebufferInfo.width = m_RenderTarget->GetExtent().width;
+		framebufferInfo.height = m_RenderTarget->GetExtent().height;
 		framebufferInfo.layers = 1;
 
 		// Create framebuffer
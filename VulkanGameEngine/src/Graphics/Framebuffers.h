@@ -4,11 +4,11 @@
 
 #include "Device.h"
 #include "RenderPass.h"
-#include "Swapchain.h"
+#include "RenderTarget.h"
 
 class Framebuffers {
 public:
-	Framebuffers(Device* device, RenderPass* renderPass, Swapchain* swapchain);	// Constructor
+	Framebuffers(Device* device, RenderPass* renderPass, RenderTarget* renderTarget);	// Constructor
 	~Framebuffers();	// Destructor
 
 	// GETTERS
@@ -17,7 +17,7 @@ private:
 	// VARIABLES
 	Device* m_Device;			// Vulkan device
 	RenderPass* m_RenderPass;	// Vulkan render pass
-	Swapchain* m_Swapchain;		// Vulkan swapchain
+	RenderTarget* m_RenderTarget;	// Target images rendered into
 
 	std::vector<VkFramebuffer> m_Framebuffers;	// Framebuffers for swapchain
 };
\ No newline at end of file
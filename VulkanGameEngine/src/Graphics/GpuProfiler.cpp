@@ -0,0 +1,212 @@
+#include "GpuProfiler.h"
+
+#include <stdexcept>
+
+// Pipeline statistics counted per region, order matches GpuPipelineStats
+const VkQueryPipelineStatisticFlags pipelineStatisticFlags =
+	VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_VERTICES_BIT |
+	VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_PRIMITIVES_BIT |
+	VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT |
+	VK_QUERY_PIPELINE_STATISTIC_CLIPPING_PRIMITIVES_BIT |
+	VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT;
+
+// Constructor
+GpuProfiler::GpuProfiler(Device* device, PhysicalDevice* physicalDevice, uint32_t frameCount, uint32_t maxRegions)
+: m_Device(device), m_PhysicalDevice(physicalDevice), m_MaxRegions(maxRegions) {
+	// Timestamp ticks are converted to nanoseconds with the device period
+	m_TimestampPeriod = m_PhysicalDevice->GetProperties().limits.timestampPeriod;
+
+	// Valid timestamp bits depend on the queue family
+	uint32_t familyCount = 0;
+	vkGetPhysicalDeviceQueueFamilyProperties(m_PhysicalDevice->GetPhysicalDevice(), &familyCount, nullptr);
+	std::vector<VkQueueFamilyProperties> families(familyCount);
+	vkGetPhysicalDeviceQueueFamilyProperties(m_PhysicalDevice->GetPhysicalDevice(), &familyCount, families.data());
+	auto validBits = families[m_Device->GetGraphicsFamily()].timestampValidBits;
+	m_TimestampsSupported = validBits > 0;
+	m_TimestampMask = validBits >= 64 ? UINT64_MAX : (uint64_t(1) << validBits) - 1;
+
+	// Statistics need the device feature
+	m_PipelineStatsSupported = m_Device->GetEnabledFeatures().pipelineStatisticsQuery == VK_TRUE;
+
+	// Create query pools per frame in flight
+	m_Frames.resize(frameCount);
+	for (auto& frame : m_Frames) {
+		frame.regions.reserve(m_MaxRegions);
+
+		// Timestamp pool, two queries per region
+		if (m_TimestampsSupported) {
+			VkQueryPoolCreateInfo timestampInfo = {};
+			timestampInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+			timestampInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+			timestampInfo.queryCount = m_MaxRegions * 2;
+			if (vkCreateQueryPool(m_Device->GetDevice(), &timestampInfo, nullptr, &frame.timestampPool) != VK_SUCCESS) {
+				throw std::runtime_error("Unable to create timestamp query pool!");
+			}
+		}
+
+		// Statistics pool, one query per region
+		if (m_PipelineStatsSupported) {
+			VkQueryPoolCreateInfo statisticsInfo = {};
+			statisticsInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+			statisticsInfo.queryType = VK_QUERY_TYPE_PIPELINE_STATISTICS;
+			statisticsInfo.queryCount = m_MaxRegions;
+			statisticsInfo.pipelineStatistics = pipelineStatisticFlags;
+			if (vkCreateQueryPool(m_Device->GetDevice(), &statisticsInfo, nullptr, &frame.statisticsPool) != VK_SUCCESS) {
+				throw std::runtime_error("Unable to create pipeline statistics query pool!");
+			}
+		}
+	}
+}
+
+// Destructor
+GpuProfiler::~GpuProfiler(){
+	// Destroy query pools
+	for (auto& frame : m_Frames) {
+		vkDestroyQueryPool(m_Device->GetDevice(), frame.timestampPool, nullptr);
+		vkDestroyQueryPool(m_Device->GetDevice(), frame.statisticsPool, nullptr);
+	}
+}
+
+// Collect results of frame's previous use and record query resets, frame must have retired
+void GpuProfiler::BeginFrame(uint32_t frameIndex, VkCommandBuffer commandBuffer){
+	auto& frame = m_Frames[frameIndex];
+
+	// Fold in results from the last time this frame was recorded
+	CollectResults(frame);
+	frame.regions.clear();
+	m_CurrentFrame = &frame;
+
+	// Queries must be reset before reuse, done on the GPU at the start of the frame
+	if (frame.timestampPool != VK_NULL_HANDLE) {
+		vkCmdResetQueryPool(commandBuffer, frame.timestampPool, 0, m_MaxRegions * 2);
+	}
+	if (frame.statisticsPool != VK_NULL_HANDLE) {
+		vkCmdResetQueryPool(commandBuffer, frame.statisticsPool, 0, m_MaxRegions);
+	}
+}
+
+// Start named region, name must outlive the frame, thread safe
+uint32_t GpuProfiler::BeginRegion(VkCommandBuffer commandBuffer, const char* name, bool pipelineStatistics){
+	// Nothing to measure with
+	if (!m_CurrentFrame || !m_TimestampsSupported) return INVALID_REGION;
+
+	// Reserve region slot
+	uint32_t region;
+	pipelineStatistics = pipelineStatistics && m_PipelineStatsSupported;
+	{
+		std::lock_guard<std::mutex> lock(m_RegionMutex);
+		if (m_CurrentFrame->regions.size() >= m_MaxRegions) return INVALID_REGION;
+		region = static_cast<uint32_t>(m_CurrentFrame->regions.size());
+		m_CurrentFrame->regions.push_back({ name, pipelineStatistics });
+	}
+
+	// Start timestamp once all prior work has started, statistics cover commands until end
+	vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, m_CurrentFrame->timestampPool, region * 2);
+	if (pipelineStatistics) {
+		vkCmdBeginQuery(commandBuffer, m_CurrentFrame->statisticsPool, region, 0);
+	}
+	return region;
+}
+
+// End region in the command buffer it was started in
+void GpuProfiler::EndRegion(VkCommandBuffer commandBuffer, uint32_t region){
+	// Region was never started
+	if (region == INVALID_REGION) return;
+
+	// Statistics flag is only written by the thread that began the region
+	bool pipelineStatistics;
+	{
+		std::lock_guard<std::mutex> lock(m_RegionMutex);
+		pipelineStatistics = m_CurrentFrame->regions[region].pipelineStatistics;
+	}
+
+	// End statistics and write end timestamp once all prior work finished
+	if (pipelineStatistics) {
+		vkCmdEndQuery(commandBuffer, m_CurrentFrame->statisticsPool, region);
+	}
+	vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, m_CurrentFrame->timestampPool, region * 2 + 1);
+}
+
+// Rolling statistics of all regions seen
+std::vector<GpuRegionStats> GpuProfiler::GetRegionStats() const{
+	std::lock_guard<std::mutex> lock(m_HistoryMutex);
+	std::vector<GpuRegionStats> stats;
+	stats.reserve(m_History.size());
+	for (auto& history : m_History) {
+		stats.push_back(history.second.stats);
+	}
+	return stats;
+}
+
+// Rolling statistics of one region, returns false if never seen
+bool GpuProfiler::GetRegionStats(const std::string& name, GpuRegionStats& stats) const{
+	std::lock_guard<std::mutex> lock(m_HistoryMutex);
+	auto historyIt = m_History.find(name);
+	if (historyIt == m_History.end()) {
+		return false;
+	}
+	stats = historyIt->second.stats;
+	return true;
+}
+
+// Read finished queries without blocking and fold them into histories
+void GpuProfiler::CollectResults(Frame& frame){
+	// Nothing recorded
+	auto regionCount = static_cast<uint32_t>(frame.regions.size());
+	if (regionCount == 0) return;
+
+	// Read all timestamps, frame is dropped if any region is unfinished
+	std::vector<uint64_t> timestamps(regionCount * 2);
+	if (vkGetQueryPoolResults(m_Device->GetDevice(), frame.timestampPool, 0, regionCount * 2, timestamps.size() * sizeof(uint64_t), timestamps.data(), sizeof(uint64_t), VK_QUERY_RESULT_64_BIT) != VK_SUCCESS) {
+		return;
+	}
+
+	// Sum regions sharing a name, such as draw slices recorded by several workers, so each name adds one sample per frame
+	std::map<std::string, FrameSample> samples;
+	for (uint32_t i = 0; i < regionCount; i++) {
+		auto& region = frame.regions[i];
+		auto& sample = samples[region.name];
+
+		// Convert ticks to milliseconds, masking bits the queue does not write
+		auto ticks = (timestamps[i * 2 + 1] - timestamps[i * 2]) & m_TimestampMask;
+		sample.durationMs += static_cast<double>(ticks) * m_TimestampPeriod / 1000000.0;
+
+		// Read statistics of this region, skipped if not available yet
+		std::array<uint64_t, PIPELINE_STAT_COUNT> counters = {};
+		if (region.pipelineStatistics && vkGetQueryPoolResults(m_Device->GetDevice(), frame.statisticsPool, i, 1, sizeof(counters), counters.data(), sizeof(counters), VK_QUERY_RESULT_64_BIT) == VK_SUCCESS) {
+			sample.hasPipelineStats = true;
+			sample.pipelineStats.inputVertices += counters[0];
+			sample.pipelineStats.inputPrimitives += counters[1];
+			sample.pipelineStats.vertexInvocations += counters[2];
+			sample.pipelineStats.clippingPrimitives += counters[3];
+			sample.pipelineStats.fragmentInvocations += counters[4];
+		}
+	}
+
+	std::lock_guard<std::mutex> lock(m_HistoryMutex);
+	for (auto& entry : samples) {
+		auto& sample = entry.second;
+		auto& history = m_History[entry.first];
+
+		// Replace oldest sample in rolling window
+		if (history.count == ROLLING_WINDOW) {
+			history.sum -= history.samples[history.next];
+		}
+		else {
+			history.count++;
+		}
+		history.samples[history.next] = sample.durationMs;
+		history.sum += sample.durationMs;
+		history.next = (history.next + 1) % ROLLING_WINDOW;
+
+		// Update statistics
+		history.stats.name = entry.first;
+		history.stats.lastMs = sample.durationMs;
+		history.stats.averageMs = history.sum / history.count;
+		history.stats.sampleCount = history.count;
+		if (sample.hasPipelineStats) {
+			history.stats.hasPipelineStats = true;
+			history.stats.pipelineStats = sample.pipelineStats;
+		}
+	}
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <array>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+#include "Device.h"
+#include "PhysicalDevice.h"
+
+// Pipeline statistics gathered for a region
+struct GpuPipelineStats {
+	uint64_t inputVertices = 0;			// Vertices fetched by input assembly
+	uint64_t inputPrimitives = 0;		// Primitives assembled
+	uint64_t vertexInvocations = 0;		// Vertex shader invocations
+	uint64_t clippingPrimitives = 0;	// Primitives output by clipping
+	uint64_t fragmentInvocations = 0;	// Fragment shader invocations
+};
+
+// Timings of a named region
+struct GpuRegionStats {
+	std::string name;				// Region name
+	double lastMs = 0.0;			// Duration in the most recently collected frame, summed over its regions of this name
+	double averageMs = 0.0;			// Average duration over the rolling window
+	uint32_t sampleCount = 0;		// Samples in the rolling window
+	bool hasPipelineStats = false;	// True if statistics were collected for region
+	GpuPipelineStats pipelineStats;	// Statistics of the most recently collected frame, summed over its regions of this name
+};
+
+class GpuProfiler {
+public:
+	GpuProfiler(Device* device, PhysicalDevice* physicalDevice, uint32_t frameCount, uint32_t maxRegions = DEFAULT_MAX_REGIONS);	// Constructor
+	~GpuProfiler();	// Destructor
+
+	static constexpr uint32_t DEFAULT_MAX_REGIONS = 64;		// Regions recordable per frame
+	static constexpr uint32_t ROLLING_WINDOW = 64;			// Frames averaged per region
+	static constexpr uint32_t INVALID_REGION = UINT32_MAX;	// Returned when a region could not be started
+
+	// FUNCTIONS
+	void BeginFrame(uint32_t frameIndex, VkCommandBuffer commandBuffer);	// Collect results of frame's previous use and record query resets, frame must have retired
+	uint32_t BeginRegion(VkCommandBuffer commandBuffer, const char* name, bool pipelineStatistics = true);	// Start named region, name must outlive the frame, thread safe
+	void EndRegion(VkCommandBuffer commandBuffer, uint32_t region);	// End region in the command buffer it was started in
+
+	// GETTERS
+	std::vector<GpuRegionStats> GetRegionStats() const;	// Rolling statistics of all regions seen
+	bool GetRegionStats(const std::string& name, GpuRegionStats& stats) const;	// Rolling statistics of one region, returns false if never seen
+	const bool GetTimestampsSupported() const { return m_TimestampsSupported; }
+	const bool GetPipelineStatsSupported() const { return m_PipelineStatsSupported; }
+private:
+	// Region recorded in a frame
+	struct Region {
+		const char* name;			// Region name
+		bool pipelineStatistics;	// True if statistics query was issued
+	};
+
+	// Query pools and regions of one frame in flight
+	struct Frame {
+		VkQueryPool timestampPool = VK_NULL_HANDLE;	// Begin and end timestamp per region
+		VkQueryPool statisticsPool = VK_NULL_HANDLE;	// Pipeline statistics per region
+		std::vector<Region> regions;				// Regions recorded this frame
+	};
+
+	// Summed duration and statistics of every region of one name in a frame
+	struct FrameSample {
+		double durationMs = 0.0;		// Summed duration in milliseconds
+		bool hasPipelineStats = false;	// True if statistics of any region were available
+		GpuPipelineStats pipelineStats;	// Summed statistics
+	};
+
+	// Rolling window of a region
+	struct History {
+		std::array<double, ROLLING_WINDOW> samples = {};	// Durations in milliseconds, one per frame
+		uint32_t next = 0;				// Next sample slot
+		uint32_t count = 0;				// Valid samples
+		double sum = 0.0;				// Sum of valid samples
+		GpuRegionStats stats;			// Latest statistics
+	};
+
+	static constexpr uint32_t PIPELINE_STAT_COUNT = 5;	// Counters per statistics query
+
+	// VARIABLES
+	Device* m_Device;					// Vulkan device
+	PhysicalDevice* m_PhysicalDevice;	// Vulkan physical device
+
+	uint32_t m_MaxRegions;				// Regions recordable per frame
+	double m_TimestampPeriod;			// Nanoseconds per timestamp tick
+	uint64_t m_TimestampMask;			// Valid bits of timestamps on graphics queue
+	bool m_TimestampsSupported;			// True if graphics queue writes timestamps
+	bool m_PipelineStatsSupported;		// True if pipeline statistics queries are enabled
+
+	std::vector<Frame> m_Frames;		// Per frame in flight query pools
+	Frame* m_CurrentFrame = nullptr;	// Frame being recorded
+	std::mutex m_RegionMutex;			// Guards regions of current frame, recorded from workers
+
+	mutable std::mutex m_HistoryMutex;			// Guards histories
+	std::map<std::string, History> m_History;	// Rolling statistics by region name
+
+	// FUNCTIONS
+	void CollectResults(Frame& frame);	// Read finished queries without blocking and fold them into histories
+};
+
+// Scoped GPU region, ends when leaving scope
+class GpuScope {
+public:
+	GpuScope(GpuProfiler* profiler, VkCommandBuffer commandBuffer, const char* name, bool pipelineStatistics = true)	// Constructor
+	: m_Profiler(profiler), m_CommandBuffer(commandBuffer) {
+		m_Region = m_Profiler ? m_Profiler->BeginRegion(m_CommandBuffer, name, pipelineStatistics) : GpuProfiler::INVALID_REGION;
+	}
+	~GpuScope() {	// Destructor
+		if (m_Profiler) m_Profiler->EndRegion(m_CommandBuffer, m_Region);
+	}
+	GpuScope(const GpuScope&) = delete;
+	GpuScope& operator=(const GpuScope&) = delete;
+private:
+	// VARIABLES
+	GpuProfiler* m_Profiler;			// Profiler region belongs to
+	VkCommandBuffer m_CommandBuffer;	// Command buffer region is recorded into
+	uint32_t m_Region;					// Region index in current frame
+};
@@ -1,23 +1,40 @@
 #include "Graphics.h"
 #include "Window.h"
 
+#include <algorithm>
 #include <stdexcept>
 
+#include "../Assets/MeshFile.h"
+
 // Static members
 //std::unique_ptr<Graphics> Graphics::m_Graphics = std::make_unique<Graphics>();
 
 // Constructor
-Graphics::Graphics()
-	: m_Window(std::make_unique<Window>("Vulkan Window", 800, 600)),
-	m_Instance(std::make_unique<Instance>()),
+Graphics::Graphics(bool headless, uint32_t framesInFlight)
+	: m_Headless(headless),
+	m_FramesInFlight(std::max(1u, std::min(framesInFlight, MAX_FRAMES_IN_FLIGHT))),
+	m_Window(headless ? nullptr : std::make_unique<Window>("Vulkan Window", 800, 600)),
+	m_Instance(std::make_unique<Instance>(headless)),
 	m_PhysicalDevice(std::make_unique<PhysicalDevice>(m_Instance.get())),
-	m_Surface(std::make_unique<Surface>(m_Instance.get(), m_PhysicalDevice.get(), m_Window.get())),
+	m_Surface(headless ? nullptr : std::make_unique<Surface>(m_Instance.get(), m_PhysicalDevice.get(), m_Window.get())),
 	m_Device(std::make_unique<Device>(m_Instance.get(), m_PhysicalDevice.get(), m_Surface.get())),
-	m_CommandPool(std::make_unique<CommandPool>(m_Device.get(), m_PhysicalDevice.get())){
+	m_MemoryAllocator(std::make_unique<MemoryAllocator>(m_Device.get(), m_PhysicalDevice.get())),
+	m_UploadManager(std::make_unique<UploadManager>(m_Device.get(), m_MemoryAllocator.get())),
+	m_PipelineCache(std::make_unique<PipelineCache>(m_Device.get(), m_PhysicalDevice.get())),
+	m_BindlessTable(std::make_unique<BindlessTable>(m_Device.get(), m_PhysicalDevice.get(), m_MemoryAllocator.get(), m_UploadManager.get(), m_FramesInFlight)),
+	m_ThreadPool(std::make_unique<ThreadPool>()){
+	// Create swapchain once, meshes added later only rerecord command buffers
+	RecreateSwapchain();
+
+	// Create streaming manager, it reads files on its own threads and creates resources through this class
+	m_StreamingManager = std::make_unique<StreamingManager>(this);
 }
 
 // Destructor
 Graphics::~Graphics() {
+	// Finish reads in flight before the resources they load into are deleted
+	m_StreamingManager.reset();
+
 	// Wait for device to idle
 	vkDeviceWaitIdle(m_Device->GetDevice());
 
@@ -28,19 +45,60 @@ Graphics::~Graphics() {
 		vkDestroyFence(m_Device->GetDevice(), m_FlightFences[i], nullptr);
 	}
 
-	// Delete command buffers
-	for (auto& commandBuffer : m_CommandBuffers) {
-		delete(commandBuffer);
+	// Delete meshes before their memory allocator goes away
+	for (auto& draw : m_Meshes) {
+		delete(draw.mesh);
+	}
+	for (auto& instancedMesh : m_InstancedMeshes) {
+		delete(instancedMesh);
+	}
+	for (auto& clusteredMesh : m_ClusteredMeshes) {
+		delete(clusteredMesh);
+	}
+	for (auto& texture : m_Textures) {
+		delete(texture);
+	}
+	for (auto& retired : m_RetiredResources) {
+		retired.release();
 	}
 }
 
 // Graphics update function
 void Graphics::Update(){
+	PROFILE_SCOPE("Graphics::Update");
+
+	// Render offscreen if headless
+	if (m_Headless) {
+		UpdateHeadless();
+		return;
+	}
+
 	// Wait for fences
-	vkWaitForFences(m_Device->GetDevice(), 1, &m_FlightFences[m_CurrentFrame], VK_TRUE, UINT64_MAX);
+	{
+		PROFILE_SCOPE("WaitForFence");
+		vkWaitForFences(m_Device->GetDevice(), 1, &m_FlightFences[m_CurrentFrame], VK_TRUE, UINT64_MAX);
+	}
+
+	// Frame finished, recycle its command buffers
+	m_CommandAllocator->BeginFrame(static_cast<uint32_t>(m_CurrentFrame));
+	m_ParallelRecorder->BeginFrame(static_cast<uint32_t>(m_CurrentFrame));
 	
+	// Destroy removed resources no frame in flight uses anymore
+	ReleaseRetiredResources();
+
+	// Upload finished reads and queue new ones, uploads are submitted with this frame's flush
+	m_StreamingManager->Update();
+
+	// Recycle finished uploads and submit queued ones ahead of this frame
+	m_UploadManager->Reclaim();
+	m_UploadManager->Flush();
+
 	// Acquire next image in swapchain and return result
-	auto acquireResult = m_Swapchain->AcquireNextImage(m_ImageAvailableSemaphores[m_CurrentFrame]);
+	VkResult acquireResult;
+	{
+		PROFILE_SCOPE("AcquireImage");
+		acquireResult = m_Swapchain->AcquireNextImage(m_ImageAvailableSemaphores[m_CurrentFrame]);
+	}
 
 	// Check if swapchain needs to be recreated
 	if (acquireResult == VK_ERROR_OUT_OF_DATE_KHR) {
@@ -62,45 +120,331 @@ void Graphics::Update(){
 	// Update images in flight
 	m_ImagesInFlight[imageIndex] = m_FlightFences[m_CurrentFrame];
 
+	// Record draw list for this frame
+	auto commandBuffer = RecordCommandBuffer(imageIndex);
+
 	// Submit to graphics queue
-	m_CommandBuffers[imageIndex]->Submit(m_ImageAvailableSemaphores[m_CurrentFrame], m_RenderFinishedSemaphores[m_CurrentFrame], m_FlightFences[m_CurrentFrame]);
+	{
+		PROFILE_SCOPE("Submit");
+		commandBuffer->Submit(m_ImageAvailableSemaphores[m_CurrentFrame], m_RenderFinishedSemaphores[m_CurrentFrame], m_FlightFences[m_CurrentFrame]);
+	}
 
 	// Present
-	auto presentResult = m_Swapchain->QueuePresent(m_Device->GetPresentQueue(), m_RenderFinishedSemaphores[m_CurrentFrame]);
+	VkResult presentResult;
+	{
+		PROFILE_SCOPE("Present");
+		presentResult = m_Swapchain->QueuePresent(m_Device->GetPresentQueue(), m_RenderFinishedSemaphores[m_CurrentFrame]);
+	}
+
+	// Update current frame, the frame was submitted even if presenting failed
+	m_CurrentFrame = (m_CurrentFrame + 1) % m_FramesInFlight;
+	m_FrameNumber++;
 
 	// Check if swapchain needs to be recreated
 	if (presentResult == VK_ERROR_OUT_OF_DATE_KHR || presentResult == VK_SUBOPTIMAL_KHR || m_Window->GetFramebufferResized()) {
 		RecreateSwapchain();
-		return;
 	}
 	else if (presentResult != VK_SUCCESS) {
 		throw std::runtime_error("Failed to present swap chain image!");
 	}
+}
+
+// Graphics update function when rendering offscreen
+void Graphics::UpdateHeadless(){
+	// Wait for fences
+	{
+		PROFILE_SCOPE("WaitForFence");
+		vkWaitForFences(m_Device->GetDevice(), 1, &m_FlightFences[m_CurrentFrame], VK_TRUE, UINT64_MAX);
+	}
+
+	// Fence was last signalled by the frame submitted frames in flight ago, it and every frame before it finished
+	if (m_FrameNumber >= m_FramesInFlight) {
+		m_CompletedFrames = std::max(m_CompletedFrames, m_FrameNumber - m_FramesInFlight + 1);
+	}
+
+	// Frame finished, recycle its command buffers
+	m_CommandAllocator->BeginFrame(static_cast<uint32_t>(m_CurrentFrame));
+	m_ParallelRecorder->BeginFrame(static_cast<uint32_t>(m_CurrentFrame));
+
+	// Destroy removed resources no frame in flight uses anymore
+	ReleaseRetiredResources();
+
+	// Upload finished reads and queue new ones, uploads are submitted with this frame's flush
+	m_StreamingManager->Update();
+
+	// Recycle finished uploads and submit queued ones ahead of this frame
+	m_UploadManager->Reclaim();
+	m_UploadManager->Flush();
+
+	// Acquire next image in offscreen ring
+	auto imageIndex = m_OffscreenTarget->AcquireNextImage();
+
+	// Check if fence in use
+	if (m_ImagesInFlight[imageIndex] != VK_NULL_HANDLE) {
+		// Wait for fence to finish
+		vkWaitForFences(m_Device->GetDevice(), 1, &m_ImagesInFlight[imageIndex], VK_TRUE, UINT64_MAX);
+	}
+	// Update images in flight
+	m_ImagesInFlight[imageIndex] = m_FlightFences[m_CurrentFrame];
+
+	// Record draw list for this frame
+	auto commandBuffer = RecordCommandBuffer(imageIndex);
+
+	// Read back previous frame rendered into this image before it is overwritten
+	if (!m_PendingReadbacks.empty() && m_PendingReadbacks.front().imageIndex == imageIndex) {
+		RetireReadback();
+	}
+
+	// Submit to graphics queue, nothing to wait on or present
+	{
+		PROFILE_SCOPE("Submit");
+		commandBuffer->Submit(VK_NULL_HANDLE, VK_NULL_HANDLE, m_FlightFences[m_CurrentFrame]);
+	}
+	m_PendingReadbacks.push_back({ imageIndex, m_FrameNumber, m_FlightFences[m_CurrentFrame] });
 
 	// Update current frame
-	m_CurrentFrame = (m_CurrentFrame + 1) % m_Swapchain->GetImageCount();
+	m_CurrentFrame = (m_CurrentFrame + 1) % m_FramesInFlight;
+	m_FrameNumber++;
 }
 
-// Add vertex buffer to graphics
-void Graphics::AddVertexBuffer(std::vector<Vertex> vertices){
-	// Add buffer
-	m_VertexBuffers.emplace_back(new Buffer(m_Device.get(), m_PhysicalDevice.get(), sizeof(vertices[0]) * vertices.size(), VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, vertices.data()));
+// Pop oldest finished headless frame, returns false if none ready
+bool Graphics::ReadFrame(ReadbackFrame& frame){
+	// Retire oldest pending frame if the GPU has finished it, without blocking, its fence is only queried while no later frame reused it
+	if (!m_PendingReadbacks.empty()) {
+		auto& pending = m_PendingReadbacks.front();
+		if (pending.frameNumber >= m_CompletedFrames && vkGetFenceStatus(m_Device->GetDevice(), pending.fence) == VK_SUCCESS) {
+			m_CompletedFrames = pending.frameNumber + 1;
+		}
+		if (pending.frameNumber < m_CompletedFrames) {
+			RetireReadback();
+		}
+	}
 
-	// Recreate swapchain
-	RecreateSwapchain();
+	// Return false if nothing finished
+	if (m_FinishedFrames.empty()) {
+		return false;
+	}
+
+	// Hand over oldest finished frame
+	frame = std::move(m_FinishedFrames.front());
+	m_FinishedFrames.pop_front();
+	return true;
+}
+
+// Move oldest pending readback into finished frames
+void Graphics::RetireReadback(){
+	// Pop oldest pending readback
+	auto pending = m_PendingReadbacks.front();
+	m_PendingReadbacks.pop_front();
+
+	// Skip copying pixels if nobody reads them
+	if (!m_ReadbackEnabled) {
+		return;
+	}
+
+	// Drop oldest finished frame if not being drained
+	if (m_FinishedFrames.size() >= MAX_FINISHED_FRAMES) {
+		m_FinishedFrames.pop_front();
+	}
+
+	// Copy pixels out of readback buffer
+	ReadbackFrame frame;
+	frame.frameNumber = pending.frameNumber;
+	frame.width = m_OffscreenTarget->GetExtent().width;
+	frame.height = m_OffscreenTarget->GetExtent().height;
+	frame.format = m_OffscreenTarget->GetImageFormat();
+	m_OffscreenTarget->ReadPixels(pending.imageIndex, frame.pixels);
+	m_FinishedFrames.emplace_back(std::move(frame));
+}
+
+// Add created mesh to draw list
+Mesh* Graphics::AddToDrawList(Mesh* mesh, const PipelineState& pipelineState){
+	// Look up pipeline, shared with every mesh of the same state
+	GraphicsPipeline* pipeline;
+	try {
+		pipeline = m_PipelineStateCache->GetPipeline(pipelineState);
+	}
+	catch (...) {
+		delete(mesh);
+		throw;
+	}
+
+	// Add mesh and rerecord command buffers lazily
+	m_Meshes.push_back({ mesh, pipelineState, pipeline });
+	return mesh;
+}
+
+// Add cooked mesh, mapped streams and indices are copied straight into staging memory
+Mesh* Graphics::AddMesh(const MeshFile& meshFile, const PipelineState& pipelineState){
+	// Throw error if mesh was cooked for another vertex input
+	if (!pipelineState.vertexInput || pipelineState.vertexInput->hash != meshFile.GetLayoutHash()) {
+		throw std::runtime_error("Unable to add cooked mesh, its vertex streams do not match the pipeline vertex input!");
+	}
+
+	// Create mesh without touching individual vertices
+	auto mesh = new Mesh(m_Device.get(), m_MemoryAllocator.get(), m_UploadManager.get(), meshFile.GetStreams(), meshFile.GetVertexCount(), meshFile.GetIndexData(), meshFile.GetIndexCount(), meshFile.GetIndexType());
+	mesh->SetLods(meshFile.GetLods());
+	mesh->SetBounds(meshFile.GetBounds());
+	return AddToDrawList(mesh, pipelineState);
+}
+
+// Remove mesh from draw list, deleted once GPU is done with it
+void Graphics::RemoveMesh(Mesh* mesh){
+	// Find mesh in draw list
+	auto it = std::find_if(m_Meshes.begin(), m_Meshes.end(), [mesh](const MeshDraw& draw) { return draw.mesh == mesh; });
+	if (it == m_Meshes.end()) {
+		throw std::runtime_error("Unable to remove mesh not in draw list!");
+	}
+
+	// Swap with last and pop, draw order does not matter
+	*it = m_Meshes.back();
+	m_Meshes.pop_back();
+
+	// Frames already submitted may still read mesh, delete it later
+	Retire([mesh]() { delete(mesh); });
+}
+
+// Add mesh drawn once per instance with a single draw call
+InstancedMesh* Graphics::AddInstancedMesh(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices, const std::vector<InstanceData>& instances){
+	// Create instanced mesh, its buffers are uploaded through staging ring
+	auto instancedMesh = new InstancedMesh(m_Device.get(), m_MemoryAllocator.get(), m_UploadManager.get(), vertices, indices, instances);
+
+	// Add instanced mesh, creating its pipeline variant on first use
+	m_InstancedMeshes.emplace_back(instancedMesh);
+	CreateInstancedPipeline();
+	return instancedMesh;
+}
+
+// Remove instanced mesh, deleted once GPU is done with it
+void Graphics::RemoveInstancedMesh(InstancedMesh* instancedMesh){
+	// Find instanced mesh in draw list
+	auto it = std::find(m_InstancedMeshes.begin(), m_InstancedMeshes.end(), instancedMesh);
+	if (it == m_InstancedMeshes.end()) {
+		throw std::runtime_error("Unable to remove instanced mesh not in draw list!");
+	}
+
+	// Swap with last and pop, draw order does not matter
+	*it = m_InstancedMeshes.back();
+	m_InstancedMeshes.pop_back();
+
+	// Frames already submitted may still read mesh, delete it later
+	Retire([instancedMesh]() { delete(instancedMesh); });
+}
+
+// Add mesh whose clusters are culled on the GPU every frame before drawing
+ClusteredMesh* Graphics::AddClusteredMesh(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices){
+	// Only pay for the cull pipeline once something uses it, it does not depend on the render pass
+	if (!m_ClusterCullPipeline) {
+		m_ClusterCullPipeline = std::make_unique<ComputePipeline>(m_Device.get(), m_PipelineCache.get(), "src/res/shaders/cluster_cull_comp.spv", ClusteredMesh::GetCullBindings(), static_cast<uint32_t>(sizeof(ClusterCullView)));
+	}
+
+	// Create clustered mesh with output buffers for every frame in flight
+	auto clusteredMesh = new ClusteredMesh(m_Device.get(), m_MemoryAllocator.get(), m_UploadManager.get(), m_ClusterCullPipeline.get(), vertices, indices, m_FramesInFlight);
+	m_ClusteredMeshes.emplace_back(clusteredMesh);
+	return clusteredMesh;
 }
 
+// Remove clustered mesh, deleted once GPU is done with it
+void Graphics::RemoveClusteredMesh(ClusteredMesh* clusteredMesh){
+	// Find clustered mesh in draw list
+	auto it = std::find(m_ClusteredMeshes.begin(), m_ClusteredMeshes.end(), clusteredMesh);
+	if (it == m_ClusteredMeshes.end()) {
+		throw std::runtime_error("Unable to remove clustered mesh not in draw list!");
+	}
+
+	// Swap with last and pop, draw order does not matter
+	*it = m_ClusteredMeshes.back();
+	m_ClusteredMeshes.pop_back();
+
+	// Frames in flight may still draw it
+	Retire([clusteredMesh]() { delete(clusteredMesh); });
+}
+
+// Upload texture into an optimal tiling image with a full mip chain
+Texture* Graphics::AddTexture(const TextureData& data){
+	// Create texture, levels are copied through staging ring and finished with the next flush
+	auto texture = new Texture(m_Device.get(), m_PhysicalDevice.get(), m_MemoryAllocator.get(), m_UploadManager.get(), data);
+	texture->SetBindlessIndex(m_BindlessTable->AddTexture(texture));
+	m_Textures.emplace_back(texture);
+	return texture;
+}
+
+// Upload cooked texture levels from first level down as they are stored, file may be closed once it returns
+Texture* Graphics::AddTexture(const TextureFile& file, uint32_t firstLevel){
+	// Create texture, mapped levels are copied into the staging ring without decoding
+	auto texture = new Texture(m_Device.get(), m_PhysicalDevice.get(), m_MemoryAllocator.get(), m_UploadManager.get(), file, firstLevel);
+	texture->SetBindlessIndex(m_BindlessTable->AddTexture(texture));
+	m_Textures.emplace_back(texture);
+	return texture;
+}
+
+// Upload cooked texture levels into a new texture taking over texture's bindless slot, texture is deleted once GPU is done with it
+Texture* Graphics::ReplaceTexture(Texture* texture, const TextureFile& file, uint32_t firstLevel){
+	// Find texture
+	auto it = std::find(m_Textures.begin(), m_Textures.end(), texture);
+	if (it == m_Textures.end()) {
+		throw std::runtime_error("Unable to replace texture not added!");
+	}
+
+	// Create replacement, its upload is flushed before the next frame samples it
+	auto replacement = new Texture(m_Device.get(), m_PhysicalDevice.get(), m_MemoryAllocator.get(), m_UploadManager.get(), file, firstLevel);
+	*it = replacement;
+
+	// Take over slot so indices taken from the old texture stay valid
+	replacement->SetBindlessIndex(texture->GetBindlessIndex());
+	m_BindlessTable->SetTexture(replacement->GetBindlessIndex(), replacement);
+
+	// Each frame's set takes the new descriptor once that frame finished, frames in flight keep sampling the old image until then, so only it is retired and the slot stays in use
+	Retire([texture]() {
+		delete(texture);
+	});
+	return replacement;
+}
+
+// Remove texture, deleted once GPU is done with it
+void Graphics::RemoveTexture(Texture* texture){
+	// Find texture
+	auto it = std::find(m_Textures.begin(), m_Textures.end(), texture);
+	if (it == m_Textures.end()) {
+		throw std::runtime_error("Unable to remove texture not added!");
+	}
+
+	// Swap with last and pop, order does not matter
+	*it = m_Textures.back();
+	m_Textures.pop_back();
+
+	// Frames in flight may still sample it, its slot is reused only once they finished
+	Retire([this, texture]() {
+		m_BindlessTable->RemoveTexture(texture->GetBindlessIndex());
+		delete(texture);
+	});
+}
+
+// Destroy resource once frames in flight no longer use it
+void Graphics::Retire(std::function<void()> release){
+	m_RetiredResources.push_back({ std::move(release), m_FrameNumber });
+}
+
+// Destroy retired resources no frame in flight uses anymore
+void Graphics::ReleaseRetiredResources(){
+	// Frames before current minus frames in flight have waited on their fence
+	while (!m_RetiredResources.empty() && m_RetiredResources.front().frameNumber + m_FramesInFlight <= m_FrameNumber) {
+		m_RetiredResources.front().release();
+		m_RetiredResources.pop_front();
+	}
+}
+
+// Create semaphores and fences for frames in flight
 void Graphics::CreateSyncObjects(){
 	// Exit if already created
 	if (m_FlightFences.size() != 0) {
 		return;
 	}
 
-	// Resize vectors
-	m_ImageAvailableSemaphores.resize(m_Swapchain->GetImageCount());
-	m_RenderFinishedSemaphores.resize(m_Swapchain->GetImageCount());
-	m_FlightFences.resize(m_Swapchain->GetImageCount());
-	m_ImagesInFlight.resize(m_Swapchain->GetImageCount(), VK_NULL_HANDLE);
+	// Resize vectors, one set per frame in flight regardless of image count
+	m_ImageAvailableSemaphores.resize(m_FramesInFlight);
+	m_RenderFinishedSemaphores.resize(m_FramesInFlight);
+	m_FlightFences.resize(m_FramesInFlight);
 
 	// Semaphore creation info
 	VkSemaphoreCreateInfo semaphoreCreateInfo = {};
@@ -128,54 +472,218 @@ void Graphics::CreateSyncObjects(){
 	}
 }
 
-// Fill in vector of command buffers
-void Graphics::RecreateCommandBuffers(){
-	// Resize command buffers vector
-	m_CommandBuffers.resize(m_Swapchain->GetImageCount());
+// Create per-frame command allocators matching frames in flight
+void Graphics::CreateCommandAllocators(){
+	// Exit if already created
+	if (m_CommandAllocator) {
+		return;
+	}
 
-	// Create command buffer to fill vector
-	for (size_t i = 0; i < m_CommandBuffers.size(); i++) {
-		// Create command buffer and begin
-		m_CommandBuffers[i] = new CommandBuffer(m_Device.get(), m_CommandPool.get());
-		m_CommandBuffers[i]->Begin(0);
+	// Create allocators, pools are transient as buffers are rerecorded every frame
+	m_CommandAllocator = std::make_unique<CommandAllocator>(m_Device.get(), m_Device->GetGraphicsFamily(), m_FramesInFlight);
+	m_ParallelRecorder = std::make_unique<ParallelRecorder>(m_Device.get(), m_ThreadPool.get(), m_FramesInFlight);
+	m_GpuProfiler = std::make_unique<GpuProfiler>(m_Device.get(), m_PhysicalDevice.get(), m_FramesInFlight);
+}
 
-		// Begin render pass
-		m_RenderPass->Begin(m_CommandBuffers[i]->GetCommandBuffer(), m_SwapchainFramebuffers->GetFramebuffers()[i]);
+// Pick level of detail of every mesh in draw list
+void Graphics::SelectLods(){
+	PROFILE_SCOPE("SelectLods");
 
-		// Bind graphics pipeline
-		m_GraphicsPipeline->Bind(m_CommandBuffers[i]->GetCommandBuffer());
+	// Meshes are drawn in object space, bounds are used as they are
+	for (auto& draw : m_Meshes) {
+		draw.lod = m_LodSelector.Select(draw.mesh->GetLods(), draw.mesh->GetBounds(), glm::mat4(1.0f), draw.lod);
+	}
+}
+
+// Record cluster culls of current frame, before render pass
+void Graphics::RecordCulls(VkCommandBuffer commandBuffer){
+	// Nothing to cull
+	if (m_ClusteredMeshes.empty()) {
+		return;
+	}
 
-		// Vulkan draw command for all buffers
-		for (auto& buffer : m_VertexBuffers) {
-			// Bind buffer
-			buffer->Bind(m_CommandBuffers[i]->GetCommandBuffer());
-			vkCmdDraw(m_CommandBuffers[i]->GetCommandBuffer(), 3, 1, 0, 0);
+	// Every mesh writes its own index buffer of this frame, draws wait on the barrier after each cull
+	GpuScope cullScope(m_GpuProfiler.get(), commandBuffer, "ClusterCull", false);
+	for (auto& clusteredMesh : m_ClusteredMeshes) {
+		clusteredMesh->RecordCull(commandBuffer, static_cast<uint32_t>(m_CurrentFrame), m_CullView);
+	}
+}
+
+// Record draw list for image into command buffer of current frame
+CommandBuffer* Graphics::RecordCommandBuffer(uint32_t imageIndex){
+	PROFILE_SCOPE("RecordCommandBuffer");
+
+	// Levels are picked before recording so worker slices only read them
+	SelectLods();
+
+	// Previous submission of this frame finished, write table slots changed since
+	m_BindlessTable->Update(static_cast<uint32_t>(m_CurrentFrame));
+
+	// Begin command buffer recycled from this frame
+	auto commandBuffer = m_CommandAllocator->Allocate();
+	commandBuffer->Begin();
+
+	// Collect GPU timings of this frame's previous use and reset its queries
+	m_GpuProfiler->BeginFrame(static_cast<uint32_t>(m_CurrentFrame), commandBuffer->GetCommandBuffer());
+	{
+		GpuScope frameScope(m_GpuProfiler.get(), commandBuffer->GetCommandBuffer(), "Frame", false);
+
+		// Compacted index buffers must be written before the render pass draws them
+		RecordCulls(commandBuffer->GetCommandBuffer());
+
+		// Record large draw lists across worker threads into secondary buffers
+		auto framebuffer = m_SwapchainFramebuffers->GetFramebuffers()[imageIndex];
+		auto drawCount = static_cast<uint32_t>(m_Meshes.size() + m_InstancedMeshes.size() + m_ClusteredMeshes.size());
+		if (drawCount >= PARALLEL_RECORD_THRESHOLD && m_ParallelRecorder->GetWorkerCount() > 1) {
+			// Begin render pass executing secondaries
+			m_RenderPass->Begin(commandBuffer->GetCommandBuffer(), framebuffer, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+
+			// Record slices, secondaries do not inherit dynamic state, profiler sums the slices of a frame into one DrawSlice sample
+			m_ParallelRecorder->Record(commandBuffer->GetCommandBuffer(), m_RenderPass->GetRenderPass(), framebuffer, drawCount, [this](VkCommandBuffer secondary, uint32_t first, uint32_t count) {
+				GpuScope sliceScope(m_GpuProfiler.get(), secondary, "DrawSlice");
+				m_RenderPass->SetDynamicState(secondary);
+				RecordDraws(secondary, first, count);
+			});
+		}
+		else {
+			// Begin render pass and record inline
+			m_RenderPass->Begin(commandBuffer->GetCommandBuffer(), framebuffer);
+			GpuScope drawScope(m_GpuProfiler.get(), commandBuffer->GetCommandBuffer(), "Draw");
+			RecordDraws(commandBuffer->GetCommandBuffer(), 0, drawCount);
 		}
 
 		// End render pass
-		m_RenderPass->End(m_CommandBuffers[i]->GetCommandBuffer());
+		m_RenderPass->End(commandBuffer->GetCommandBuffer());
 
-		// End command buffer recording
-		m_CommandBuffers[i]->End();
+		// Copy rendered image out for readback when headless
+		if (m_Headless) {
+			GpuScope readbackScope(m_GpuProfiler.get(), commandBuffer->GetCommandBuffer(), "Readback", false);
+			m_OffscreenTarget->RecordReadback(commandBuffer->GetCommandBuffer(), imageIndex);
+		}
 	}
+
+	// End command buffer recording
+	commandBuffer->End();
+	return commandBuffer;
 }
 
-// Recreate swapchain for resized window
+// Record draws [first, first + count) of meshes followed by instanced and clustered meshes
+void Graphics::RecordDraws(VkCommandBuffer commandBuffer, uint32_t first, uint32_t count){
+	// Bind resource table once, every pipeline shares its layout
+	m_BindlessTable->Bind(commandBuffer, m_GraphicsPipeline->GetPipelineLayout(), static_cast<uint32_t>(m_CurrentFrame));
+
+	// Bind pipeline only when it changes between draws
+	GraphicsPipeline* boundPipeline = nullptr;
+	auto meshCount = static_cast<uint32_t>(m_Meshes.size());
+	auto instancedCount = static_cast<uint32_t>(m_InstancedMeshes.size());
+	for (uint32_t i = first; i < first + count; i++) {
+		if (i < meshCount) {
+			// Bind and draw mesh
+			auto& draw = m_Meshes[i];
+			if (boundPipeline != draw.pipeline) {
+				boundPipeline = draw.pipeline;
+				boundPipeline->Bind(commandBuffer);
+			}
+			BindlessTable::Push(commandBuffer, boundPipeline->GetPipelineLayout(), draw.mesh->GetResources());
+			draw.mesh->Bind(commandBuffer);
+			draw.mesh->Draw(commandBuffer, 1, draw.lod);
+		}
+		else if (i < meshCount + instancedCount) {
+			// One draw per instanced mesh covering all its instances
+			if (boundPipeline != m_InstancedPipeline) {
+				boundPipeline = m_InstancedPipeline;
+				boundPipeline->Bind(commandBuffer);
+			}
+			m_InstancedMeshes[i - meshCount]->Bind(commandBuffer);
+			m_InstancedMeshes[i - meshCount]->Draw(commandBuffer);
+		}
+		else {
+			// Indirect draw of the clusters this frame's cull kept
+			if (boundPipeline != m_GraphicsPipeline) {
+				boundPipeline = m_GraphicsPipeline;
+				boundPipeline->Bind(commandBuffer);
+			}
+			auto clusteredMesh = m_ClusteredMeshes[i - meshCount - instancedCount];
+			clusteredMesh->Bind(commandBuffer, static_cast<uint32_t>(m_CurrentFrame));
+			clusteredMesh->Draw(commandBuffer, static_cast<uint32_t>(m_CurrentFrame));
+		}
+	}
+}
+
+// Recreate swapchain for resized window, frames in flight keep running
 void Graphics::RecreateSwapchain(){
-	// Wait for device to idle
-	vkDeviceWaitIdle(m_Device->GetDevice());
-	m_CurrentFrame = 0;
+	PROFILE_SCOPE("RecreateSwapchain");
 
-	// Create new swapchain
-	m_Swapchain = std::make_unique<Swapchain>(m_Device.get(), m_PhysicalDevice.get(), m_Surface.get(), m_Window.get());
-	m_RenderPass = std::make_unique<RenderPass>(m_Device.get(), m_Swapchain.get());
-	m_GraphicsPipeline = std::make_unique<GraphicsPipeline>(m_Device.get(), m_Swapchain.get(), m_RenderPass.get());
-	m_SwapchainFramebuffers = std::make_unique<Framebuffers>(m_Device.get(), m_RenderPass.get(), m_Swapchain.get());
+	// Create new swapchain, or offscreen image ring once when headless
+	if (m_Headless) {
+		if (!m_OffscreenTarget) {
+			m_OffscreenTarget = std::make_unique<OffscreenTarget>(m_Device.get(), m_MemoryAllocator.get(), VkExtent2D{ 800, 600 }, HEADLESS_IMAGE_COUNT);
+		}
+	}
+	else {
+		// A zero sized swapchain is invalid, wait while minimized
+		m_Window->WaitWhileMinimized();
+
+		// Hand old swapchain to the driver so it can reuse its resources
+		auto oldSwapchain = m_Swapchain.release();
+		m_Swapchain = std::make_unique<Swapchain>(m_Device.get(), m_PhysicalDevice.get(), m_Surface.get(), m_Window.get(), oldSwapchain ? oldSwapchain->GetSwapchain() : VK_NULL_HANDLE);
+
+		// Old framebuffers and image views may still be used by frames in flight, destroy them later
+		if (oldSwapchain) {
+			auto oldFramebuffers = m_SwapchainFramebuffers.release();
+			Retire([oldFramebuffers]() { delete(oldFramebuffers); });
+			Retire([oldSwapchain]() { delete(oldSwapchain); });
+		}
+	}
+
+	// Keep render pass and its pipelines unless the target format changed, viewport is dynamic
+	if (m_RenderPass && m_RenderPass->IsCompatible(GetRenderTarget())) {
+		m_RenderPass->SetRenderTarget(GetRenderTarget());
+	}
+	else {
+		// Format changes are rare, wait for frames in flight before destroying pass and pipelines
+		if (m_RenderPass) {
+			vkDeviceWaitIdle(m_Device->GetDevice());
+		}
 
-	// Recreate command buffers
-	RecreateCommandBuffers();
+		// Switch cache to new pass before the old one is destroyed
+		auto renderPass = std::make_unique<RenderPass>(m_Device.get(), GetRenderTarget());
+		if (m_PipelineStateCache) {
+			m_PipelineStateCache->SetRenderPass(renderPass.get());
+		}
+		else {
+			m_PipelineStateCache = std::make_unique<PipelineStateCache>(m_Device.get(), m_PipelineCache.get(), renderPass.get(), m_BindlessTable.get());
+		}
+		m_RenderPass = std::move(renderPass);
+	}
+
+	// Look up pipelines, only compiled the first time or after a format change
+	m_GraphicsPipeline = m_PipelineStateCache->GetPipeline(PipelineState::Default());
+	for (auto& draw : m_Meshes) {
+		draw.pipeline = m_PipelineStateCache->GetPipeline(draw.state);
+	}
+	m_InstancedPipeline = nullptr;
+	CreateInstancedPipeline();
+	m_SwapchainFramebuffers = std::make_unique<Framebuffers>(m_Device.get(), m_RenderPass.get(), GetRenderTarget());
+
+	// Create sync objects and command allocators for frames in flight
 	CreateSyncObjects();
+	CreateCommandAllocators();
+
+	// Images of new target have not been used by any frame
+	m_ImagesInFlight.assign(GetRenderTarget()->GetImageCount(), VK_NULL_HANDLE);
 
 	// Set bool
-	m_Window->SetFramebufferResized(false);
+	if (m_Window) {
+		m_Window->SetFramebufferResized(false);
+	}
+}
+
+// Look up instanced pipeline variant if instanced meshes exist
+void Graphics::CreateInstancedPipeline(){
+	// Only pay for the variant once something uses it
+	if (m_InstancedPipeline || m_InstancedMeshes.empty()) {
+		return;
+	}
+	m_InstancedPipeline = m_PipelineStateCache->GetPipeline(PipelineState::Instanced());
 }
@@ -1,31 +1,83 @@
 #pragma once
 
+#include <deque>
+#include <functional>
 #include <memory>
+#include <stdexcept>
+#include <type_traits>
 #include <vector>
 #include <vulkan/vulkan.h>
 
+#include "BindlessTable.h"
 #include "Buffer.h"
+#include "ClusteredMesh.h"
+#include "CommandAllocator.h"
 #include "CommandBuffer.h"
 #include "CommandPool.h"
+#include "ComputePipeline.h"
 #include "Device.h"
 #include "Framebuffers.h"
+#include "GpuProfiler.h"
 #include "GraphicsPipeline.h"
 #include "Instance.h"
+#include "InstanceData.h"
+#include "InstancedMesh.h"
+#include "LodSelector.h"
+#include "MemoryAllocator.h"
+#include "Mesh.h"
+#include "OffscreenTarget.h"
+#include "ParallelRecorder.h"
 #include "PhysicalDevice.h"
+#include "PipelineCache.h"
+#include "PipelineStateCache.h"
 #include "RenderPass.h"
+#include "RenderTarget.h"
+#include "StreamingManager.h"
 #include "Surface.h"
 #include "Swapchain.h"
+#include "Texture.h"
+#include "UploadManager.h"
 #include "Vertex.h"
 #include "Window.h"
+#include "../Core/Profiler.h"
+#include "../Core/ThreadPool.h"
+
+class MeshFile;
 
 class Graphics {
 public:
-	Graphics();		// Constructor
+	Graphics(bool headless = false, uint32_t framesInFlight = DEFAULT_FRAMES_IN_FLIGHT);	// Constructor, headless renders offscreen without a window, frames in flight are clamped to [1, MAX_FRAMES_IN_FLIGHT]
 	~Graphics();	// Destructor
 
+	static constexpr uint32_t DEFAULT_FRAMES_IN_FLIGHT = 2;	// Frames the CPU may record ahead of the GPU
+	static constexpr uint32_t MAX_FRAMES_IN_FLIGHT = 3;	// Upper bound on frames in flight
+
 	// FUNCTIONS
 	void Update();	// Graphics update function
-	void AddVertexBuffer(std::vector<Vertex> vertices);		// Add buffer to buffer vector
+	template<typename VertexType>
+	Mesh* AddMesh(const std::vector<VertexType>& vertices, const std::vector<uint32_t>& indices = {}, const PipelineState& pipelineState = PipelineState::Default()) {	// Add mesh drawn with pipeline state to draw list, returns handle for removal
+		return AddToDrawList(new Mesh(m_Device.get(), m_MemoryAllocator.get(), m_UploadManager.get(), vertices, indices), pipelineState);
+	}
+	template<typename PositionType, typename AttributeType>
+	Mesh* AddSplitMesh(const std::vector<PositionType>& positions, const std::vector<AttributeType>& attributes, const std::vector<uint32_t>& indices, const PipelineState& pipelineState) {	// Add mesh with positions and remaining attributes in separate streams
+		static_assert(std::is_trivially_copyable_v<PositionType> && std::is_trivially_copyable_v<AttributeType>, "Vertices are copied to the GPU byte for byte!");
+		if (positions.size() != attributes.size()) {
+			throw std::runtime_error("Unable to add split mesh, streams differ in vertex count!");
+		}
+		std::vector<VertexStreamData> streams = { { positions.data(), static_cast<uint32_t>(sizeof(PositionType)) }, { attributes.data(), static_cast<uint32_t>(sizeof(AttributeType)) } };
+		return AddToDrawList(new Mesh(m_Device.get(), m_MemoryAllocator.get(), m_UploadManager.get(), streams, static_cast<uint32_t>(positions.size()), indices), pipelineState);
+	}
+	Mesh* AddMesh(const MeshFile& meshFile, const PipelineState& pipelineState = PipelineState::Default());	// Add cooked mesh, mapped streams and indices are copied straight into staging memory
+	void RemoveMesh(Mesh* mesh);	// Remove mesh from draw list, deleted once GPU is done with it
+	InstancedMesh* AddInstancedMesh(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices, const std::vector<InstanceData>& instances);	// Add mesh drawn once per instance with a single draw call
+	void RemoveInstancedMesh(InstancedMesh* instancedMesh);	// Remove instanced mesh, deleted once GPU is done with it
+	ClusteredMesh* AddClusteredMesh(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices);	// Add mesh whose clusters are culled on the GPU every frame before drawing
+	void RemoveClusteredMesh(ClusteredMesh* clusteredMesh);	// Remove clustered mesh, deleted once GPU is done with it
+	Texture* AddTexture(const TextureData& data);	// Upload texture into an optimal tiling image with a full mip chain, shaders sample it through its bindless index
+	Texture* AddTexture(const TextureFile& file, uint32_t firstLevel = 0);	// Upload cooked texture levels from first level down as they are stored, file may be closed once it returns
+	Texture* ReplaceTexture(Texture* texture, const TextureFile& file, uint32_t firstLevel = 0);	// Upload cooked texture levels into a new texture taking over texture's bindless slot, texture is deleted once GPU is done with it
+	void RemoveTexture(Texture* texture);	// Remove texture and free its bindless slot, deleted once GPU is done with it
+	bool ReadFrame(ReadbackFrame& frame);	// Pop oldest finished headless frame, returns false if none ready
 
 	// GETTERS
 	//static Graphics* Get() { return m_Graphics.get(); }
@@ -34,31 +86,106 @@ public:
 	Instance* GetInstance() { return m_Instance.get(); }
 	Device* GetDevice() { return m_Device.get(); }
 	PhysicalDevice* GetPhysicalDevice() { return m_PhysicalDevice.get(); }
+	MemoryAllocator* GetMemoryAllocator() { return m_MemoryAllocator.get(); }
+	UploadManager* GetUploadManager() { return m_UploadManager.get(); }
+	BindlessTable* GetBindlessTable() { return m_BindlessTable.get(); }
+	GpuProfiler* GetGpuProfiler() { return m_GpuProfiler.get(); }
+	LodSelector* GetLodSelector() { return &m_LodSelector; }
+	StreamingManager* GetStreamingManager() { return m_StreamingManager.get(); }
+	ThreadPool* GetThreadPool() { return m_ThreadPool.get(); }
+	RenderTarget* GetRenderTarget() { return m_Headless ? static_cast<RenderTarget*>(m_OffscreenTarget.get()) : m_Swapchain.get(); }
+	const bool GetHeadless() const { return m_Headless; }
+	const uint32_t GetFramesInFlight() const { return m_FramesInFlight; }
+
+	// SETTERS
+	void SetReadbackEnabled(bool readbackEnabled) { m_ReadbackEnabled = readbackEnabled; }
+	void SetCullView(const glm::mat4& viewProjection) { m_CullView = ClusterCullView::FromViewProjection(viewProjection); }	// Set frustum clusters are culled against, disables cone culling until a camera is set
+	void SetCullCamera(const glm::vec3& position) { m_CullView.cameraPosition = position; m_CullView.coneCulling = 1; }	// Set camera position clusters facing away from are culled for
 private:
+	// Resource removed but possibly still used by frames in flight
+	struct RetiredResource {
+		std::function<void()> release;	// Destroys resource
+		uint64_t frameNumber;			// Frame number when retired
+	};
+
+	// Mesh in draw list with the pipeline it is drawn with
+	struct MeshDraw {
+		Mesh* mesh;					// Mesh geometry
+		PipelineState state;		// Pipeline state mesh is drawn with
+		GraphicsPipeline* pipeline;	// Pipeline for state, looked up again when pipelines are rebuilt
+		uint32_t lod = 0;			// Level of detail drawn, reselected every frame
+	};
+
+	// Readback of a submitted headless frame
+	struct PendingReadback {
+		uint32_t imageIndex;	// Offscreen image the frame was rendered into
+		uint64_t frameNumber;	// Number of the frame
+		VkFence fence;			// Fence signalled when frame finished, only tracks this frame until a later frame reuses it
+	};
+
+	static const uint32_t HEADLESS_IMAGE_COUNT = 3;		// Amount of images in offscreen ring
+	static const size_t MAX_FINISHED_FRAMES = 8;		// Finished frames kept before oldest are dropped
+	static const uint32_t PARALLEL_RECORD_THRESHOLD = 2 * ParallelRecorder::MIN_DRAWS_PER_WORKER;	// Draws needed before recording is split over threads
+
 	// VARIABLES
 	//static std::unique_ptr<Graphics> m_Graphics;	// Graphics static object
+	bool m_Headless;								// True if rendering offscreen without a window
+	uint32_t m_FramesInFlight;						// Frames recorded ahead of the GPU, independent of image count
 	std::unique_ptr<Window> m_Window;				// Window static object
 	std::unique_ptr<Instance> m_Instance;			// Vulkan instance
 	std::unique_ptr<PhysicalDevice> m_PhysicalDevice;// Vulkan physical device
 	std::unique_ptr<Surface> m_Surface;				// Vulkan surface
 	std::unique_ptr<Device> m_Device;				// Vulkan logical device
+	std::unique_ptr<MemoryAllocator> m_MemoryAllocator;		// Device memory allocator
+	std::unique_ptr<UploadManager> m_UploadManager;			// Staging uploads on transfer queue
+	std::unique_ptr<PipelineCache> m_PipelineCache;			// Pipeline cache persisted to disk
+	std::unique_ptr<BindlessTable> m_BindlessTable;			// Textures and storage buffers every pipeline reads by index
 	std::unique_ptr<Swapchain> m_Swapchain;			// Vulkan swapchain
-	std::unique_ptr<RenderPass> m_RenderPass;				// Vulkan render pass
-	std::unique_ptr<GraphicsPipeline> m_GraphicsPipeline;	// Vulkan graphics pipeline
+	std::unique_ptr<OffscreenTarget> m_OffscreenTarget;		// Offscreen image ring used when headless
+	std::unique_ptr<RenderPass> m_RenderPass;				// Vulkan render pass, kept across resizes of the same format
+	std::unique_ptr<PipelineStateCache> m_PipelineStateCache;	// Pipelines by state, shared between meshes
+	GraphicsPipeline* m_GraphicsPipeline = nullptr;			// Default pipeline, compiled up front, owned by state cache
+	GraphicsPipeline* m_InstancedPipeline = nullptr;		// Graphics pipeline consuming per-instance stream, owned by state cache
+	std::unique_ptr<ComputePipeline> m_ClusterCullPipeline;	// Compute pipeline culling clusters, created on first use
 	std::unique_ptr<Framebuffers> m_SwapchainFramebuffers;	// Vulkan swapchain framebuffers
-	std::unique_ptr<CommandPool> m_CommandPool;				// Vulkan command pool
+	std::unique_ptr<ThreadPool> m_ThreadPool;				// Worker threads for command recording and asset loading
+	std::unique_ptr<CommandAllocator> m_CommandAllocator;	// Primary command buffers recycled per frame
+	std::unique_ptr<ParallelRecorder> m_ParallelRecorder;	// Per-worker command pools and secondary buffers
+	std::unique_ptr<GpuProfiler> m_GpuProfiler;				// Timestamp and pipeline statistics queries per frame in flight
+	LodSelector m_LodSelector;								// Picks level of detail per mesh from projected error
+	std::unique_ptr<StreamingManager> m_StreamingManager;	// Reads cooked assets on I/O threads within a residency budget
 
 	size_t m_CurrentFrame = 0;						// Current frame
-	std::vector<CommandBuffer*> m_CommandBuffers;	// Vector of command buffers
+	uint64_t m_FrameNumber = 0;						// Total frames submitted
 	std::vector<VkSemaphore> m_ImageAvailableSemaphores;	// Vector of image available semaphores
 	std::vector<VkSemaphore> m_RenderFinishedSemaphores;	// Vector of render finished semaphores
 	std::vector<VkFence> m_FlightFences;					// Vector of in flight fences
 	std::vector<VkFence> m_ImagesInFlight;					// Vector of fences for images in flight
 
-	std::vector<Buffer*> m_VertexBuffers = {};
+	std::vector<MeshDraw> m_Meshes = {};					// Draw list
+	std::vector<InstancedMesh*> m_InstancedMeshes = {};		// Instanced draw list
+	std::vector<ClusteredMesh*> m_ClusteredMeshes = {};		// Clustered draw list, culled before the render pass
+	std::vector<Texture*> m_Textures = {};					// Uploaded textures
+	ClusterCullView m_CullView = ClusterCullView::FromViewProjection(glm::mat4(1.0f));	// Frustum clusters are culled against, shaders draw positions as clip space
+	std::deque<RetiredResource> m_RetiredResources;			// Removed resources waiting for frames in flight
+
+	bool m_ReadbackEnabled = true;							// Keep finished headless frames for ReadFrame
+	std::deque<PendingReadback> m_PendingReadbacks;		// Submitted headless frames not yet read back
+	uint64_t m_CompletedFrames = 0;						// Headless frames numbered below this are known to have finished
+	std::deque<ReadbackFrame> m_FinishedFrames;			// Headless frames read back to CPU memory
 
 	// FUNCTIONS
-	void CreateSyncObjects();		// Create semaphores and fences
-	void RecreateCommandBuffers();	// Fill in vector of command buffers
+	void UpdateHeadless();			// Graphics update function when rendering offscreen
+	Mesh* AddToDrawList(Mesh* mesh, const PipelineState& pipelineState);	// Add created mesh to draw list
+	void RetireReadback();			// Move oldest pending readback into finished frames
+	void CreateSyncObjects();		// Create semaphores and fences for frames in flight
+	void CreateCommandAllocators();	// Create per-frame command allocators matching frames in flight
+	void SelectLods();				// Pick level of detail of every mesh in draw list
+	void RecordCulls(VkCommandBuffer commandBuffer);	// Record cluster culls of current frame, before render pass
+	CommandBuffer* RecordCommandBuffer(uint32_t imageIndex);	// Record draw list for image into command buffer of current frame
+	void RecordDraws(VkCommandBuffer commandBuffer, uint32_t first, uint32_t count);	// Record draws [first, first + count) of meshes followed by instanced and clustered meshes
+	void Retire(std::function<void()> release);	// Destroy resource once frames in flight no longer use it
+	void ReleaseRetiredResources();	// Destroy retired resources no frame in flight uses anymore
+	void CreateInstancedPipeline();	// Look up instanced pipeline variant if instanced meshes exist
 	void RecreateSwapchain();		// Recreate swapchain for resized window
 };
\ No newline at end of file
@@ -1,70 +1,74 @@
 #include "GraphicsPipeline.h"
 
+#include <algorithm>
 #include <stdexcept>
-
-#include "Vertex.h"
+#include <string>
 
 // Dynamic States
 const std::vector<VkDynamicState> dynamicStates = { VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR, VK_DYNAMIC_STATE_LINE_WIDTH };
 
 // Constructor
-GraphicsPipeline::GraphicsPipeline(Device* device, Swapchain* swapchain, RenderPass* renderPass)
-: m_Device(device), m_Swapchain(swapchain), m_RenderPass(renderPass) {
+GraphicsPipeline::GraphicsPipeline(Device* device, PipelineCache* pipelineCache, RenderPass* renderPass, const PipelineState& state, const BindlessTable* bindlessTable)
+: m_Device(device), m_PipelineCache(pipelineCache), m_RenderPass(renderPass), m_State(state) {
+	// Size resource arrays of shaders to the table, constants shaders do not declare are ignored
+	if (bindlessTable) {
+		m_SpecializationData[0] = bindlessTable->GetTextureCapacity();
+		m_SpecializationData[1] = bindlessTable->GetBufferCapacity();
+	}
+	m_SpecializationEntries[0] = { 0, 0, sizeof(uint32_t) };
+	m_SpecializationEntries[1] = { 1, sizeof(uint32_t), sizeof(uint32_t) };
+	m_SpecializationInfo.mapEntryCount = bindlessTable ? 2 : 0;
+	m_SpecializationInfo.pMapEntries = m_SpecializationEntries;
+	m_SpecializationInfo.dataSize = sizeof(m_SpecializationData);
+	m_SpecializationInfo.pData = m_SpecializationData;
+
 	// Create shaders
-	Shader vertShader(m_Device, VK_SHADER_STAGE_VERTEX_BIT, "src/res/shaders/default_vert.spv");
-	Shader fragShader(m_Device, VK_SHADER_STAGE_FRAGMENT_BIT, "src/res/shaders/default_frag.spv");
+	Shader vertShader(m_Device, VK_SHADER_STAGE_VERTEX_BIT, std::string(m_State.vertexShader));
+	Shader fragShader(m_Device, VK_SHADER_STAGE_FRAGMENT_BIT, std::string(m_State.fragmentShader));
 
 	// Add shaders to pipeline
 	AddShader(&vertShader);
 	AddShader(&fragShader);
 
-	// Pipeline vertex input info
-	auto bindingDescription = Vertex::GetBindingDescription();
-	auto attributeDescriptions = Vertex::GetAttributeDescriptions();
+	// Throw error if state has no vertex input
+	if (!m_State.vertexInput) {
+		throw std::runtime_error("Unable to create graphics pipeline without vertex input!");
+	}
+
+	// Check vertex shader reads what the input provides
+	ValidateVertexInput(&vertShader, *m_State.vertexInput);
+
+	// Pipeline vertex input info, bindings and attributes are generated at compile time
 	VkPipelineVertexInputStateCreateInfo vertexInputInfo = {};
 	vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
-	vertexInputInfo.vertexBindingDescriptionCount = 1;
-	vertexInputInfo.pVertexBindingDescriptions = &bindingDescription;
-	vertexInputInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(attributeDescriptions.size());
-	vertexInputInfo.pVertexAttributeDescriptions = attributeDescriptions.data();
+	vertexInputInfo.vertexBindingDescriptionCount = m_State.vertexInput->bindingCount;
+	vertexInputInfo.pVertexBindingDescriptions = m_State.vertexInput->bindings;
+	vertexInputInfo.vertexAttributeDescriptionCount = m_State.vertexInput->attributeCount;
+	vertexInputInfo.pVertexAttributeDescriptions = m_State.vertexInput->attributes;
 
 	// Input assembly info
 	VkPipelineInputAssemblyStateCreateInfo inputAssemblyInfo = {};
 	inputAssemblyInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
-	inputAssemblyInfo.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+	inputAssemblyInfo.topology = m_State.topology;
 	inputAssemblyInfo.primitiveRestartEnable = VK_FALSE;
 
-	// Viewport details
-	VkViewport viewport = {};
-	viewport.x = 0.0f;
-	viewport.y = 0.0f;
-	viewport.width = (float)m_Swapchain->GetExtent().width;
-	viewport.height = (float)m_Swapchain->GetExtent().height;
-	viewport.minDepth = 0.0f;
-	viewport.maxDepth = 1.0f;
-
-	// Create scissor
-	VkRect2D scissor = {};
-	scissor.offset = { 0, 0 };
-	scissor.extent = m_Swapchain->GetExtent();
-
-	// Viewport state
+	// Viewport state, viewport and scissor are set dynamically when recording
 	VkPipelineViewportStateCreateInfo viewportState = {};
 	viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
 	viewportState.viewportCount = 1;
-	viewportState.pViewports = &viewport;
+	viewportState.pViewports = nullptr;
 	viewportState.scissorCount = 1;
-	viewportState.pScissors = &scissor;
+	viewportState.pScissors = nullptr;
 
 	// Rasterizer info
 	VkPipelineRasterizationStateCreateInfo rasterizer = {};
 	rasterizer.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
 	rasterizer.depthClampEnable = VK_FALSE;
 	rasterizer.rasterizerDiscardEnable = VK_FALSE;
-	rasterizer.polygonMode = VK_POLYGON_MODE_FILL;
+	rasterizer.polygonMode = m_State.polygonMode;
 	rasterizer.lineWidth = 1.0f;
-	rasterizer.cullMode = VK_CULL_MODE_BACK_BIT;
-	rasterizer.frontFace = VK_FRONT_FACE_CLOCKWISE;
+	rasterizer.cullMode = m_State.cullMode;
+	rasterizer.frontFace = m_State.frontFace;
 	rasterizer.depthBiasEnable = VK_FALSE;
 	rasterizer.depthBiasConstantFactor = 0.0f;
 	rasterizer.depthBiasClamp = 0.0f;
@@ -83,13 +87,13 @@ GraphicsPipeline::GraphicsPipeline(Device* device, Swapchain* swapchain, RenderP
 	// Colour blending data
 	VkPipelineColorBlendAttachmentState colourBlendAttachment = {};
 	colourBlendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
-	colourBlendAttachment.blendEnable = VK_TRUE;
-	colourBlendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
-	colourBlendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
-	colourBlendAttachment.colorBlendOp = VK_BLEND_OP_ADD;
-	colourBlendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
-	colourBlendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;
-	colourBlendAttachment.alphaBlendOp = VK_BLEND_OP_ADD;
+	colourBlendAttachment.blendEnable = m_State.blendEnable ? VK_TRUE : VK_FALSE;
+	colourBlendAttachment.srcColorBlendFactor = m_State.srcColourBlendFactor;
+	colourBlendAttachment.dstColorBlendFactor = m_State.dstColourBlendFactor;
+	colourBlendAttachment.colorBlendOp = m_State.colourBlendOp;
+	colourBlendAttachment.srcAlphaBlendFactor = m_State.srcAlphaBlendFactor;
+	colourBlendAttachment.dstAlphaBlendFactor = m_State.dstAlphaBlendFactor;
+	colourBlendAttachment.alphaBlendOp = m_State.alphaBlendOp;
 
 	// Colour blend state
 	VkPipelineColorBlendStateCreateInfo colourBlendState = {};
@@ -109,13 +113,17 @@ GraphicsPipeline::GraphicsPipeline(Device* device, Swapchain* swapchain, RenderP
 	dynamicState.dynamicStateCount = static_cast<uint32_t>(dynamicStates.size());
 	dynamicState.pDynamicStates = dynamicStates.data();
 
+	// Bindless table and resource indices, identical for every pipeline so the set stays bound across pipeline switches
+	VkDescriptorSetLayout setLayout = bindlessTable ? bindlessTable->GetDescriptorSetLayout() : VK_NULL_HANDLE;
+	VkPushConstantRange pushConstantRange = bindlessTable ? bindlessTable->GetPushConstantRange() : VkPushConstantRange{};
+
 	// Pipeline layout creation info
 	VkPipelineLayoutCreateInfo pipelineLayoutInfo = {};
 	pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-	pipelineLayoutInfo.setLayoutCount = 0;
-	pipelineLayoutInfo.pSetLayouts = nullptr;
-	pipelineLayoutInfo.pushConstantRangeCount = 0;
-	pipelineLayoutInfo.pPushConstantRanges = nullptr;
+	pipelineLayoutInfo.setLayoutCount = bindlessTable ? 1 : 0;
+	pipelineLayoutInfo.pSetLayouts = bindlessTable ? &setLayout : nullptr;
+	pipelineLayoutInfo.pushConstantRangeCount = bindlessTable ? 1 : 0;
+	pipelineLayoutInfo.pPushConstantRanges = bindlessTable ? &pushConstantRange : nullptr;
 	
 	// Create pipeline layout
 	if (vkCreatePipelineLayout(m_Device->GetDevice(), &pipelineLayoutInfo, nullptr, &m_PipelineLayout) != VK_SUCCESS) {
@@ -143,8 +151,8 @@ GraphicsPipeline::GraphicsPipeline(Device* device, Swapchain* swapchain, RenderP
 	pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
 	pipelineInfo.basePipelineIndex = -1;
 
-	// Create graphics pipeline
-	if (vkCreateGraphicsPipelines(m_Device->GetDevice(), VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &m_GraphicsPipeline) != VK_SUCCESS) {
+	// Create graphics pipeline through shared cache
+	if (vkCreateGraphicsPipelines(m_Device->GetDevice(), m_PipelineCache->GetPipelineCache(), 1, &pipelineInfo, nullptr, &m_GraphicsPipeline) != VK_SUCCESS) {
 		throw std::runtime_error("Unable to create graphics pipeline!");
 	}
 }
@@ -172,7 +180,31 @@ void GraphicsPipeline::AddShader(Shader* shader){
 	shaderStageCreateInfo.stage = shader->GetShaderStage();
 	shaderStageCreateInfo.module = shader->GetShaderModule();
 	shaderStageCreateInfo.pName = "main";
+	shaderStageCreateInfo.pSpecializationInfo = &m_SpecializationInfo;
 
 	// Add shader stage to stages
 	m_ShaderStages.emplace_back(shaderStageCreateInfo);
 }
+
+// Check every vertex shader input is fed by an attribute of the same numeric type
+void GraphicsPipeline::ValidateVertexInput(Shader* vertexShader, const VertexInputDescription& vertexInput){
+	auto attributes = vertexInput.attributes;
+	auto attributesEnd = vertexInput.attributes + vertexInput.attributeCount;
+	for (auto& input : vertexShader->GetInputs()) {
+		for (uint32_t i = 0; i < input.locationCount; i++) {
+			// Find attribute at location
+			auto location = input.location + i;
+			auto attribute = std::find_if(attributes, attributesEnd, [location](const VkVertexInputAttributeDescription& a) { return a.location == location; });
+
+			// Throw error if location is not fed, shader would read undefined values
+			if (attribute == attributesEnd) {
+				throw std::runtime_error("Unable to create graphics pipeline, " + std::string(m_State.vertexShader) + " reads location " + std::to_string(location) + " which the vertex input does not provide!");
+			}
+
+			// Throw error if float, signed and unsigned integer types are mixed
+			if (GetFormatComponents(attribute->format).type != input.type) {
+				throw std::runtime_error("Unable to create graphics pipeline, " + std::string(m_State.vertexShader) + " reads location " + std::to_string(location) + " with a different numeric type than its attribute!");
+			}
+		}
+	}
+}
@@ -1,15 +1,17 @@
 #pragma once
 
+#include "BindlessTable.h"
 #include "Device.h"
+#include "PipelineCache.h"
+#include "PipelineState.h"
 #include "RenderPass.h"
 #include "Shader.h"
-#include "Swapchain.h"
 
 #include <vector>
 
 class GraphicsPipeline {
 public:
-	GraphicsPipeline(Device* device, Swapchain* swapchain, RenderPass* renderPass);	// Constructor
+	GraphicsPipeline(Device* device, PipelineCache* pipelineCache, RenderPass* renderPass, const PipelineState& state, const BindlessTable* bindlessTable = nullptr);	// Constructor, viewport and scissor are dynamic so pipeline is independent of target size, a bindless table becomes set 0 and the push constant range
 	~GraphicsPipeline();// Destructor
 	
 	// FUNCTIONS
@@ -18,17 +20,23 @@ public:
 	// GETTERS
 	const VkPipeline GetGraphicsPipeline() const { return m_GraphicsPipeline; }
 	const VkPipelineLayout GetPipelineLayout() const { return m_PipelineLayout; }
+	const PipelineState& GetState() const { return m_State; }
 private:
 	// VARIABLES
 	Device* m_Device;			// Vulkan device
-	Swapchain* m_Swapchain;		// Vulkan swapchain
+	PipelineCache* m_PipelineCache;	// Pipeline cache shared by all pipelines
 	RenderPass* m_RenderPass;	// Vulkan render pass
+	PipelineState m_State;		// Fixed function and shader state pipeline was built from
 
 	VkPipeline m_GraphicsPipeline = VK_NULL_HANDLE;		// Vulkan graphics pipeline
 	VkPipelineLayout m_PipelineLayout = VK_NULL_HANDLE;	// Vulkan pipeline layout
 
 	std::vector<VkPipelineShaderStageCreateInfo> m_ShaderStages = {};	// Shader stages pipeline will use
+	uint32_t m_SpecializationData[2] = {};							// Bindless texture and buffer capacities, specialization constants 0 and 1
+	VkSpecializationMapEntry m_SpecializationEntries[2] = {};		// Map of specialization constants into data
+	VkSpecializationInfo m_SpecializationInfo = {};					// Specialization shared by every stage
 
 	// FUNCTIONS
 	void AddShader(Shader* shader);	// Add shader to pipeline shader stage
+	void ValidateVertexInput(Shader* vertexShader, const VertexInputDescription& vertexInput);	// Check every vertex shader input is fed by an attribute of the same numeric type
 };
\ No newline at end of file
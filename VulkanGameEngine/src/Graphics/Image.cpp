@@ -0,0 +1,121 @@
+#include "Image.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+// Constructor
+Image::Image(Device* device, MemoryAllocator* allocator, VkExtent2D extent, VkFormat format, VkImageUsageFlags usage, VkMemoryPropertyFlags properties, uint32_t mipLevels)
+: m_Device(device), m_Allocator(allocator), m_Extent(extent), m_Format(format), m_MipLevels(mipLevels) {
+	// Image create info
+	VkImageCreateInfo imageInfo = {};
+	imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+	imageInfo.imageType = VK_IMAGE_TYPE_2D;
+	imageInfo.format = m_Format;
+	imageInfo.extent = { m_Extent.width, m_Extent.height, 1 };
+	imageInfo.mipLevels = m_MipLevels;
+	imageInfo.arrayLayers = 1;
+	imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+	imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+	imageInfo.usage = usage;
+	imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+	imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+	// Create image
+	if (vkCreateImage(m_Device->GetDevice(), &imageInfo, nullptr, &m_Image) != VK_SUCCESS) {
+		throw std::runtime_error("Unable to create image!");
+	}
+
+	// Allocate memory from shared block and bind image to it
+	m_Allocation = m_Allocator->AllocateImage(m_Image, properties);
+
+	// Image view create info
+	VkImageViewCreateInfo viewInfo = {};
+	viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+	viewInfo.image = m_Image;
+	viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+	viewInfo.format = m_Format;
+	viewInfo.components.r = VK_COMPONENT_SWIZZLE_IDENTITY;
+	viewInfo.components.g = VK_COMPONENT_SWIZZLE_IDENTITY;
+	viewInfo.components.b = VK_COMPONENT_SWIZZLE_IDENTITY;
+	viewInfo.components.a = VK_COMPONENT_SWIZZLE_IDENTITY;
+	viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+	viewInfo.subresourceRange.baseMipLevel = 0;
+	viewInfo.subresourceRange.levelCount = m_MipLevels;
+	viewInfo.subresourceRange.baseArrayLayer = 0;
+	viewInfo.subresourceRange.layerCount = 1;
+
+	// Create image view
+	if (vkCreateImageView(m_Device->GetDevice(), &viewInfo, nullptr, &m_ImageView) != VK_SUCCESS) {
+		throw std::runtime_error("Unable to create image view!");
+	}
+}
+
+// Destructor
+Image::~Image(){
+	// Destroy image view and image
+	vkDestroyImageView(m_Device->GetDevice(), m_ImageView, nullptr);
+	vkDestroyImage(m_Device->GetDevice(), m_Image, nullptr);
+	m_Allocator->Free(m_Allocation);
+}
+
+// Levels of a full mip chain down to 1x1
+uint32_t Image::GetMipLevelCount(VkExtent2D extent){
+	uint32_t levels = 1;
+	for (auto size = std::max(extent.width, extent.height); size > 1; size >>= 1) {
+		levels++;
+	}
+	return levels;
+}
+
+// Extent of mip level, halved and rounded down per level
+VkExtent2D Image::GetMipExtent(VkExtent2D extent, uint32_t level){
+	return { std::max(extent.width >> level, 1u), std::max(extent.height >> level, 1u) };
+}
+
+// Bytes per texel block of a format image data is uploaded in, 0 if not supported
+uint32_t Image::GetBlockSize(VkFormat format){
+	switch (format) {
+	case VK_FORMAT_R8_UNORM:
+		return 1;
+	case VK_FORMAT_R8G8_UNORM:
+		return 2;
+	case VK_FORMAT_R8G8B8A8_UNORM:
+	case VK_FORMAT_R8G8B8A8_SRGB:
+	case VK_FORMAT_B8G8R8A8_UNORM:
+	case VK_FORMAT_B8G8R8A8_SRGB:
+		return 4;
+	case VK_FORMAT_R16G16B16A16_SFLOAT:
+		return 8;
+	case VK_FORMAT_R32G32B32A32_SFLOAT:
+		return 16;
+	case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+	case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+	case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+	case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+	case VK_FORMAT_BC4_UNORM_BLOCK:
+		return 8;
+	case VK_FORMAT_BC3_UNORM_BLOCK:
+	case VK_FORMAT_BC3_SRGB_BLOCK:
+	case VK_FORMAT_BC5_UNORM_BLOCK:
+	case VK_FORMAT_BC7_UNORM_BLOCK:
+	case VK_FORMAT_BC7_SRGB_BLOCK:
+		return 16;
+	default:
+		return 0;
+	}
+}
+
+// Texels per side of a texel block, 1 for uncompressed formats
+uint32_t Image::GetBlockExtent(VkFormat format){
+	// BC formats encode 4x4 texel blocks
+	return format >= VK_FORMAT_BC1_RGB_UNORM_BLOCK && format <= VK_FORMAT_BC7_SRGB_BLOCK ? 4 : 1;
+}
+
+// Bytes of tightly packed mip level, partial blocks at edges count whole
+VkDeviceSize Image::GetLevelSize(VkFormat format, VkExtent2D extent, uint32_t level){
+	auto levelExtent = GetMipExtent(extent, level);
+	auto blockExtent = GetBlockExtent(format);
+	VkDeviceSize blocksWide = (levelExtent.width + blockExtent - 1) / blockExtent;
+	VkDeviceSize blocksHigh = (levelExtent.height + blockExtent - 1) / blockExtent;
+	return blocksWide * blocksHigh * GetBlockSize(format);
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include "Device.h"
+#include "MemoryAllocator.h"
+
+class Image {
+public:
+	Image(Device* device, MemoryAllocator* allocator, VkExtent2D extent, VkFormat format, VkImageUsageFlags usage, VkMemoryPropertyFlags properties, uint32_t mipLevels = 1);	// Constructor, view covers every mip level
+	~Image();	// Destructor
+
+	// FUNCTIONS
+	static uint32_t GetMipLevelCount(VkExtent2D extent);	// Levels of a full mip chain down to 1x1
+	static VkExtent2D GetMipExtent(VkExtent2D extent, uint32_t level);	// Extent of mip level, halved and rounded down per level
+	static uint32_t GetBlockSize(VkFormat format);	// Bytes per texel block of a format image data is uploaded in, 0 if not supported
+	static uint32_t GetBlockExtent(VkFormat format);	// Texels per side of a texel block, 1 for uncompressed formats
+	static VkDeviceSize GetLevelSize(VkFormat format, VkExtent2D extent, uint32_t level);	// Bytes of tightly packed mip level, partial blocks at edges count whole
+
+	// GETTERS
+	const VkImage GetImage() const { return m_Image; }
+	const VkImageView GetImageView() const { return m_ImageView; }
+	const VkDeviceMemory GetImageMemory() const { return m_Allocation.memory; }
+	const VkExtent2D GetExtent() const { return m_Extent; }
+	const VkFormat GetFormat() const { return m_Format; }
+	const uint32_t GetMipLevels() const { return m_MipLevels; }
+private:
+	// VARIABLES
+	Device* m_Device;					// Vulkan device
+	MemoryAllocator* m_Allocator;		// Device memory allocator
+
+	VkExtent2D m_Extent;							// Image extent
+	VkFormat m_Format;								// Image format
+	uint32_t m_MipLevels;							// Amount of mip levels
+	VkImage m_Image = VK_NULL_HANDLE;				// Vulkan image
+	VkImageView m_ImageView = VK_NULL_HANDLE;		// Vulkan image view
+	Allocation m_Allocation;						// Image memory
+};
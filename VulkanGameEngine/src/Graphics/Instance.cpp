@@ -16,7 +16,8 @@ const std::vector<const char*> Instance::m_DeviceExtensions = {
 };
 
 // Constructor
-Instance::Instance(){
+Instance::Instance(bool headless)
+: m_Headless(headless) {
 	// Check if validation layers are available
 	if (m_EnableValidationLayers && !CheckValidationLayerSupport()) {
 		throw std::runtime_error("Validation layers requested, but not available!");
@@ -104,15 +105,28 @@ bool Instance::CheckValidationLayerSupport(){
 	return true;
 }
 
+// Return device extensions required for this instance
+std::vector<const char*> Instance::GetDeviceExtensions() const{
+	// Headless rendering never presents, so the swapchain extension is not needed
+	if (m_Headless) {
+		return {};
+	}
+
+	return m_DeviceExtensions;
+}
+
 // Return required extensions
 std::vector<const char*> Instance::GetRequiredExtensions(){
-	// GLFW extensions
-	uint32_t glfwExtensionCount;
-	const char** glfwExtensions;
-	glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
-
-	// Create vector from said extensions
-	std::vector<const char*> extensions(glfwExtensions, glfwExtensions + glfwExtensionCount);
+	// Vector of extensions
+	std::vector<const char*> extensions;
+
+	// GLFW surface extensions, only needed when rendering to a window
+	if (!m_Headless) {
+		uint32_t glfwExtensionCount;
+		const char** glfwExtensions;
+		glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
+		extensions.assign(glfwExtensions, glfwExtensions + glfwExtensionCount);
+	}
 
 	// Add debug utils extension if validation layers enabled
 	if (m_EnableValidationLayers) {
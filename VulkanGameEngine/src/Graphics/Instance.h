@@ -5,7 +5,7 @@
 
 class Instance {
 public:
-	Instance();		// Constructor
+	Instance(bool headless = false);	// Constructor
 	~Instance();	// Destructor
 
 	static const std::vector<const char*> m_ValidationLayers;
@@ -14,8 +14,11 @@ public:
 	// GETTERS
 	const VkInstance GetInstance() const { return m_Instance; }
 	const bool GetEnableValidationLayers() const { return m_EnableValidationLayers; }
+	const bool GetHeadless() const { return m_Headless; }
+	std::vector<const char*> GetDeviceExtensions() const;	// Return device extensions required for this instance
 private:
 	// VARIABLES
+	bool m_Headless;	// True if rendering without a window or presentation
 	VkInstance m_Instance = VK_NULL_HANDLE;
 	VkDebugUtilsMessengerEXT m_DebugMessenger = VK_NULL_HANDLE;
 
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <glm/glm.hpp>
+#include <vulkan/vulkan.h>
+
+#include "VertexFormats.h"
+
+// Per-instance attributes streamed from vertex binding 1
+struct InstanceData {
+	glm::mat4 transform = glm::mat4(1.0f);	// Instance transform, applied to vertex position
+	glm::vec4 colour = glm::vec4(1.0f);		// Instance colour, multiplied with vertex colour
+
+	// STATIC GETTERS
+	static constexpr VkVertexInputBindingDescription GetBindingDescription() { return InstanceLayout::GetBindingDescription(1, VK_VERTEX_INPUT_RATE_INSTANCE); }
+	static constexpr std::array<VkVertexInputAttributeDescription, InstanceLayout::LOCATION_COUNT> GetAttributeDescriptions() { return InstanceLayout::GetAttributeDescriptions(1); }
+};
+
+// Members must sit where the generated descriptions expect them
+static_assert(sizeof(InstanceData) == InstanceLayout::STRIDE, "InstanceData size must match InstanceLayout!");
+static_assert(offsetof(InstanceData, transform) == InstanceLayout::OFFSETS[0], "InstanceData transform must match InstanceLayout!");
+static_assert(offsetof(InstanceData, colour) == InstanceLayout::OFFSETS[1], "InstanceData colour must match InstanceLayout!");
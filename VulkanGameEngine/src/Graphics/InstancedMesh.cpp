@@ -0,0 +1,40 @@
+#include "InstancedMesh.h"
+
+#include <stdexcept>
+
+// Constructor
+InstancedMesh::InstancedMesh(Device* device, MemoryAllocator* allocator, UploadManager* uploadManager, const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices, const std::vector<InstanceData>& instances)
+: m_Device(device), m_InstanceCount(static_cast<uint32_t>(instances.size())) {
+	// Throw error if there is nothing to instance
+	if (instances.empty()) {
+		throw std::runtime_error("Unable to create instanced mesh without instances!");
+	}
+
+	// Create shared mesh
+	m_Mesh = std::make_unique<Mesh>(m_Device, allocator, uploadManager, vertices, indices);
+
+	// Create device local instance buffer and queue upload
+	auto instanceSize = sizeof(instances[0]) * instances.size();
+	m_InstanceBuffer = std::make_unique<Buffer>(m_Device, allocator, instanceSize, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, nullptr);
+	uploadManager->UploadBuffer(m_InstanceBuffer.get(), instances.data(), instanceSize);
+}
+
+// Destructor
+InstancedMesh::~InstancedMesh(){
+}
+
+// Bind mesh buffers and instance stream
+void InstancedMesh::Bind(VkCommandBuffer commandBuffer){
+	// Bind mesh vertex and index buffers
+	m_Mesh->Bind(commandBuffer);
+
+	// Bind instance buffer to binding 1
+	VkBuffer buffers[] = { m_InstanceBuffer->GetBuffer() };
+	VkDeviceSize offsets[] = { 0 };
+	vkCmdBindVertexBuffers(commandBuffer, 1, 1, buffers, offsets);
+}
+
+// Draw every instance with one draw call
+void InstancedMesh::Draw(VkCommandBuffer commandBuffer){
+	m_Mesh->Draw(commandBuffer, m_InstanceCount);
+}
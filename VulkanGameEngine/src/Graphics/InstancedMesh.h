@@ -0,0 +1,33 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+#include "Buffer.h"
+#include "Device.h"
+#include "InstanceData.h"
+#include "MemoryAllocator.h"
+#include "Mesh.h"
+#include "UploadManager.h"
+
+class InstancedMesh {
+public:
+	InstancedMesh(Device* device, MemoryAllocator* allocator, UploadManager* uploadManager, const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices, const std::vector<InstanceData>& instances);	// Constructor
+	~InstancedMesh();	// Destructor
+
+	// FUNCTIONS
+	void Bind(VkCommandBuffer commandBuffer);	// Bind mesh buffers and instance stream
+	void Draw(VkCommandBuffer commandBuffer);	// Draw every instance with one draw call
+
+	// GETTERS
+	Mesh* GetMesh() const { return m_Mesh.get(); }
+	const uint32_t GetInstanceCount() const { return m_InstanceCount; }
+private:
+	// VARIABLES
+	Device* m_Device;					// Vulkan device
+
+	uint32_t m_InstanceCount;					// Amount of instances
+	std::unique_ptr<Mesh> m_Mesh;				// Shared mesh drawn for every instance
+	std::unique_ptr<Buffer> m_InstanceBuffer;	// Device local per-instance attributes
+};
@@ -0,0 +1,51 @@
+#include "LodSelector.h"
+
+#include <algorithm>
+#include <cmath>
+
+// Constructor
+LodSelector::LodSelector(){
+}
+
+// Destructor
+LodSelector::~LodSelector(){
+}
+
+// Level to draw next frame, current level is kept until it is clearly too coarse or too fine
+uint32_t LodSelector::Select(const std::vector<MeshLod>& lods, const MeshBounds& bounds, const glm::mat4& transform, uint32_t currentLod) const {
+	// Full detail without a camera or levels to choose from
+	if (!m_HasCamera || lods.size() <= 1) {
+		return 0;
+	}
+
+	// Refine while current level shows more error than allowed
+	auto lod = std::min(currentLod, static_cast<uint32_t>(lods.size()) - 1);
+	while (lod > 0 && ProjectError(lods[lod].error, bounds, transform) > m_ErrorThreshold) {
+		lod--;
+	}
+
+	// Coarsen only while next level stays well under threshold, so objects near a boundary do not flicker
+	auto coarsenThreshold = m_ErrorThreshold * (1.0f - m_Hysteresis);
+	while (lod + 1 < lods.size() && ProjectError(lods[lod + 1].error, bounds, transform) <= coarsenThreshold) {
+		lod++;
+	}
+	return lod;
+}
+
+// Pixels object space error covers at nearest point of bounding sphere
+float LodSelector::ProjectError(float error, const MeshBounds& bounds, const glm::mat4& transform) const {
+	// Largest axis scale bounds errors under non-uniform scaling
+	auto scale = std::max({ glm::length(glm::vec3(transform[0])), glm::length(glm::vec3(transform[1])), glm::length(glm::vec3(transform[2])) });
+	auto centre = glm::vec3(transform * glm::vec4(bounds.centre, 1.0f));
+
+	// Perspective projection of error at nearest point of sphere
+	auto distance = std::max(glm::length(centre - m_CameraPosition) - bounds.radius * scale, MIN_DISTANCE);
+	return error * scale * m_ProjectionScale / distance;
+}
+
+// Set camera errors are projected for, vertical field of view in radians
+void LodSelector::SetCamera(const glm::vec3& position, float verticalFov, uint32_t viewportHeight){
+	m_CameraPosition = position;
+	m_ProjectionScale = viewportHeight / (2.0f * std::tan(verticalFov * 0.5f));
+	m_HasCamera = true;
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+#include "Mesh.h"
+
+// Picks levels of detail whose object space error projects below a pixel threshold
+class LodSelector {
+public:
+	LodSelector();	// Constructor
+	~LodSelector();	// Destructor
+
+	static constexpr float DEFAULT_ERROR_THRESHOLD = 1.0f;	// Projected error in pixels a level may show
+	static constexpr float DEFAULT_HYSTERESIS = 0.25f;		// Share of threshold a coarser level must stay under before switching to it
+	static constexpr float MIN_DISTANCE = 0.001f;			// Distance clamp for cameras inside a bounding sphere
+
+	// FUNCTIONS
+	uint32_t Select(const std::vector<MeshLod>& lods, const MeshBounds& bounds, const glm::mat4& transform, uint32_t currentLod) const;	// Level to draw next frame, current level is kept until it is clearly too coarse or too fine
+	float ProjectError(float error, const MeshBounds& bounds, const glm::mat4& transform) const;	// Pixels object space error covers at nearest point of bounding sphere
+
+	// GETTERS
+	const bool HasCamera() const { return m_HasCamera; }
+	const float GetErrorThreshold() const { return m_ErrorThreshold; }
+	const float GetHysteresis() const { return m_Hysteresis; }
+
+	// SETTERS
+	void SetCamera(const glm::vec3& position, float verticalFov, uint32_t viewportHeight);	// Set camera errors are projected for, vertical field of view in radians
+	void SetErrorThreshold(float errorThreshold) { m_ErrorThreshold = errorThreshold; }
+	void SetHysteresis(float hysteresis) { m_Hysteresis = hysteresis; }
+private:
+	// VARIABLES
+	bool m_HasCamera = false;								// False until a camera is set, every mesh draws full detail
+	glm::vec3 m_CameraPosition = glm::vec3(0.0f);			// World space camera position
+	float m_ProjectionScale = 0.0f;							// Pixels per unit of size at unit distance
+	float m_ErrorThreshold = DEFAULT_ERROR_THRESHOLD;		// Pixels of error allowed
+	float m_Hysteresis = DEFAULT_HYSTERESIS;				// Dead band against flickering between levels
+};
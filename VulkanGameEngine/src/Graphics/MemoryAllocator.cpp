@@ -0,0 +1,287 @@
+#include "MemoryAllocator.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+// Constructor
+MemoryAllocator::MemoryAllocator(Device* device, PhysicalDevice* physicalDevice, VkDeviceSize blockSize)
+: m_Device(device), m_PhysicalDevice(physicalDevice) {
+	// Round block size up to a power of two multiple of the smallest allocation
+	m_MaxOrder = GetOrder(std::max(blockSize, MIN_ALLOCATION_SIZE));
+	m_BlockSize = GetOrderSize(m_MaxOrder);
+
+	// Buddies are aligned to at least the smallest allocation, so buffers and images only
+	// risk sharing a granularity page when the granularity is larger than that
+	auto granularity = m_PhysicalDevice->GetProperties().limits.bufferImageGranularity;
+	m_SeparateLinear = granularity > MIN_ALLOCATION_SIZE;
+}
+
+// Destructor
+MemoryAllocator::~MemoryAllocator(){
+	// Free all remaining blocks
+	for (auto& block : m_Blocks) {
+		vkFreeMemory(m_Device->GetDevice(), block.first, nullptr);
+	}
+}
+
+// Allocate memory for buffer and bind it
+Allocation MemoryAllocator::AllocateBuffer(VkBuffer buffer, VkMemoryPropertyFlags properties){
+	// Get memory requirements
+	VkMemoryRequirements memRequirements;
+	vkGetBufferMemoryRequirements(m_Device->GetDevice(), buffer, &memRequirements);
+
+	// Allocate and bind buffer to memory
+	auto allocation = Allocate(memRequirements, properties, true);
+	if (vkBindBufferMemory(m_Device->GetDevice(), buffer, allocation.memory, allocation.offset) != VK_SUCCESS) {
+		Free(allocation);
+		throw std::runtime_error("Unable to bind buffer memory!");
+	}
+	return allocation;
+}
+
+// Allocate memory for optimal tiling image and bind it
+Allocation MemoryAllocator::AllocateImage(VkImage image, VkMemoryPropertyFlags properties){
+	// Get memory requirements
+	VkMemoryRequirements memRequirements;
+	vkGetImageMemoryRequirements(m_Device->GetDevice(), image, &memRequirements);
+
+	// Allocate and bind image to memory
+	auto allocation = Allocate(memRequirements, properties, false);
+	if (vkBindImageMemory(m_Device->GetDevice(), image, allocation.memory, allocation.offset) != VK_SUCCESS) {
+		Free(allocation);
+		throw std::runtime_error("Unable to bind image memory!");
+	}
+	return allocation;
+}
+
+// Return allocation to allocator
+void MemoryAllocator::Free(Allocation& allocation){
+	// Ignore empty allocations
+	if (allocation.memory == VK_NULL_HANDLE) return;
+
+	std::lock_guard<std::mutex> lock(m_Mutex);
+
+	// Update statistics
+	m_Stats.allocationCount--;
+	m_Stats.usedBytes -= allocation.size;
+	m_Stats.requestedBytes -= allocation.requestedSize;
+
+	// Dedicated allocations own their memory
+	if (allocation.dedicated) {
+		vkFreeMemory(m_Device->GetDevice(), allocation.memory, nullptr);
+		m_Stats.dedicatedCount--;
+		m_Stats.reservedBytes -= allocation.size;
+		allocation = {};
+		return;
+	}
+
+	// Find owning block
+	auto blockIt = m_Blocks.find(allocation.memory);
+	if (blockIt == m_Blocks.end()) {
+		throw std::runtime_error("Freed allocation does not belong to allocator!");
+	}
+	auto block = blockIt->second.get();
+
+	// Merge with free buddies as far up as possible
+	auto offset = allocation.offset;
+	auto order = allocation.order;
+	while (order < m_MaxOrder) {
+		auto buddy = offset ^ GetOrderSize(order);
+		auto& freeList = block->freeLists[order];
+		auto buddyIt = freeList.find(buddy);
+		if (buddyIt == freeList.end()) {
+			break;
+		}
+		freeList.erase(buddyIt);
+		offset = std::min(offset, buddy);
+		order++;
+	}
+	block->freeLists[order].insert(offset);
+	block->allocationCount--;
+
+	// Release empty block unless it is the last one of its kind
+	if (block->allocationCount == 0) {
+		auto sameKind = std::count_if(m_Blocks.begin(), m_Blocks.end(), [block](const auto& other) {
+			return other.second->memoryType == block->memoryType && other.second->linear == block->linear;
+		});
+		if (sameKind > 1) {
+			DestroyBlock(block);
+		}
+	}
+
+	allocation = {};
+}
+
+// Return allocator usage statistics
+MemoryStats MemoryAllocator::GetStats() const{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	return m_Stats;
+}
+
+// Allocate memory matching requirements
+Allocation MemoryAllocator::Allocate(const VkMemoryRequirements& requirements, VkMemoryPropertyFlags properties, bool linear){
+	// Find memory type
+	auto memoryType = m_PhysicalDevice->FindMemoryType(requirements.memoryTypeBits, properties);
+
+	std::lock_guard<std::mutex> lock(m_Mutex);
+
+	// Buddies are aligned to their own size, so alignment is met by rounding size up to it
+	auto size = std::max(requirements.size, requirements.alignment);
+	Allocation allocation;
+
+	// Large resources get their own memory rather than filling most of a block
+	if (size > m_BlockSize / 2) {
+		allocation = AllocateDedicated(requirements.size, memoryType);
+	}
+	else {
+		// Only share blocks between buffers and images when granularity allows it
+		bool blockLinear = m_SeparateLinear ? linear : true;
+		auto order = GetOrder(size);
+
+		// Try existing blocks first
+		bool allocated = false;
+		for (auto& block : m_Blocks) {
+			if (block.second->memoryType == memoryType && block.second->linear == blockLinear && AllocateFromBlock(block.second.get(), order, allocation)) {
+				allocated = true;
+				break;
+			}
+		}
+
+		// Create new block if none had space
+		if (!allocated && !AllocateFromBlock(CreateBlock(memoryType, blockLinear), order, allocation)) {
+			throw std::runtime_error("Unable to sub-allocate memory from new block!");
+		}
+	}
+
+	// Update statistics
+	allocation.requestedSize = requirements.size;
+	m_Stats.allocationCount++;
+	m_Stats.usedBytes += allocation.size;
+	m_Stats.requestedBytes += allocation.requestedSize;
+	return allocation;
+}
+
+// Allocate memory owning its own device memory
+Allocation MemoryAllocator::AllocateDedicated(VkDeviceSize size, uint32_t memoryType){
+	// Memory allocation info
+	VkMemoryAllocateInfo allocInfo = {};
+	allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+	allocInfo.allocationSize = size;
+	allocInfo.memoryTypeIndex = memoryType;
+
+	// Allocate memory
+	Allocation allocation;
+	if (vkAllocateMemory(m_Device->GetDevice(), &allocInfo, nullptr, &allocation.memory) != VK_SUCCESS) {
+		throw std::runtime_error("Unable to allocate dedicated memory!");
+	}
+
+	// Fill in allocation
+	allocation.size = size;
+	allocation.memoryType = memoryType;
+	allocation.dedicated = true;
+	allocation.mapped = MapMemory(allocation.memory, memoryType);
+
+	// Update statistics
+	m_Stats.dedicatedCount++;
+	m_Stats.reservedBytes += size;
+	return allocation;
+}
+
+// Try to take buddy of order from block
+bool MemoryAllocator::AllocateFromBlock(Block* block, uint32_t order, Allocation& allocation){
+	// Find smallest free buddy that fits
+	auto freeOrder = order;
+	while (freeOrder <= m_MaxOrder && block->freeLists[freeOrder].empty()) {
+		freeOrder++;
+	}
+	if (freeOrder > m_MaxOrder) {
+		return false;
+	}
+
+	// Take buddy and split it down to requested order, freeing upper halves
+	auto offset = *block->freeLists[freeOrder].begin();
+	block->freeLists[freeOrder].erase(block->freeLists[freeOrder].begin());
+	while (freeOrder > order) {
+		freeOrder--;
+		block->freeLists[freeOrder].insert(offset + GetOrderSize(freeOrder));
+	}
+
+	// Fill in allocation
+	allocation.memory = block->memory;
+	allocation.offset = offset;
+	allocation.size = GetOrderSize(order);
+	allocation.mapped = block->mapped ? static_cast<char*>(block->mapped) + offset : nullptr;
+	allocation.memoryType = block->memoryType;
+	allocation.order = order;
+	allocation.dedicated = false;
+	block->allocationCount++;
+	return true;
+}
+
+// Allocate new shared block
+MemoryAllocator::Block* MemoryAllocator::CreateBlock(uint32_t memoryType, bool linear){
+	// Memory allocation info
+	VkMemoryAllocateInfo allocInfo = {};
+	allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+	allocInfo.allocationSize = m_BlockSize;
+	allocInfo.memoryTypeIndex = memoryType;
+
+	// Allocate memory
+	auto block = std::make_unique<Block>();
+	if (vkAllocateMemory(m_Device->GetDevice(), &allocInfo, nullptr, &block->memory) != VK_SUCCESS) {
+		throw std::runtime_error("Unable to allocate memory block!");
+	}
+
+	// Whole block starts free at the highest order
+	block->memoryType = memoryType;
+	block->linear = linear;
+	block->mapped = MapMemory(block->memory, memoryType);
+	block->freeLists.resize(m_MaxOrder + 1);
+	block->freeLists[m_MaxOrder].insert(0);
+
+	// Update statistics
+	m_Stats.blockCount++;
+	m_Stats.reservedBytes += m_BlockSize;
+
+	// Store block
+	auto blockPtr = block.get();
+	m_Blocks[block->memory] = std::move(block);
+	return blockPtr;
+}
+
+// Free shared block
+void MemoryAllocator::DestroyBlock(Block* block){
+	// Update statistics
+	m_Stats.blockCount--;
+	m_Stats.reservedBytes -= m_BlockSize;
+
+	// Free memory and forget block
+	auto memory = block->memory;
+	vkFreeMemory(m_Device->GetDevice(), memory, nullptr);
+	m_Blocks.erase(memory);
+}
+
+// Map memory if host visible
+void* MemoryAllocator::MapMemory(VkDeviceMemory memory, uint32_t memoryType){
+	// Only host visible memory can be mapped
+	auto memProperties = m_PhysicalDevice->GetMemoryProperties();
+	if (!(memProperties.memoryTypes[memoryType].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT)) {
+		return nullptr;
+	}
+
+	// Map whole memory persistently, it is unmapped implicitly when freed
+	void* mapped = nullptr;
+	if (vkMapMemory(m_Device->GetDevice(), memory, 0, VK_WHOLE_SIZE, 0, &mapped) != VK_SUCCESS) {
+		throw std::runtime_error("Unable to map memory!");
+	}
+	return mapped;
+}
+
+// Smallest buddy order fitting size
+uint32_t MemoryAllocator::GetOrder(VkDeviceSize size) const{
+	uint32_t order = 0;
+	while (GetOrderSize(order) < size) {
+		order++;
+	}
+	return order;
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <set>
+#include <unordered_map>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+#include "Device.h"
+#include "PhysicalDevice.h"
+
+// Range of device memory handed out by the allocator
+struct Allocation {
+	VkDeviceMemory memory = VK_NULL_HANDLE;	// Device memory the allocation lives in
+	VkDeviceSize offset = 0;				// Offset into device memory
+	VkDeviceSize size = 0;					// Size reserved for allocation
+	VkDeviceSize requestedSize = 0;			// Size requested by resource
+	void* mapped = nullptr;					// Host pointer to allocation if memory is host visible
+	uint32_t memoryType = 0;				// Memory type index
+	uint32_t order = 0;						// Buddy order of allocation inside its block
+	bool dedicated = false;					// True if allocation owns its device memory
+};
+
+// Allocator usage statistics
+struct MemoryStats {
+	uint32_t blockCount = 0;			// Shared device memory blocks
+	uint32_t dedicatedCount = 0;		// Allocations owning their own device memory
+	uint32_t allocationCount = 0;		// Live allocations
+	VkDeviceSize reservedBytes = 0;		// Bytes allocated from the driver
+	VkDeviceSize usedBytes = 0;			// Bytes reserved by live allocations
+	VkDeviceSize requestedBytes = 0;	// Bytes requested by live allocations
+};
+
+class MemoryAllocator {
+public:
+	MemoryAllocator(Device* device, PhysicalDevice* physicalDevice, VkDeviceSize blockSize = DEFAULT_BLOCK_SIZE);	// Constructor
+	~MemoryAllocator();	// Destructor
+
+	static constexpr VkDeviceSize DEFAULT_BLOCK_SIZE = 64 * 1024 * 1024;	// Size of shared memory blocks
+	static constexpr VkDeviceSize MIN_ALLOCATION_SIZE = 256;				// Smallest buddy allocation
+
+	// FUNCTIONS
+	Allocation AllocateBuffer(VkBuffer buffer, VkMemoryPropertyFlags properties);	// Allocate memory for buffer and bind it
+	Allocation AllocateImage(VkImage image, VkMemoryPropertyFlags properties);	// Allocate memory for optimal tiling image and bind it
+	void Free(Allocation& allocation);	// Return allocation to allocator
+
+	// GETTERS
+	MemoryStats GetStats() const;
+private:
+	// Shared device memory split with a buddy allocator
+	struct Block {
+		VkDeviceMemory memory = VK_NULL_HANDLE;	// Device memory of block
+		void* mapped = nullptr;					// Persistent host pointer if host visible
+		uint32_t memoryType = 0;				// Memory type index
+		bool linear = true;						// True if block holds linear resources (buffers)
+		uint32_t allocationCount = 0;			// Live allocations in block
+		std::vector<std::set<VkDeviceSize>> freeLists;	// Free offsets per buddy order
+	};
+
+	// VARIABLES
+	Device* m_Device;					// Vulkan device
+	PhysicalDevice* m_PhysicalDevice;	// Vulkan physical device
+
+	VkDeviceSize m_BlockSize;			// Size of shared memory blocks
+	uint32_t m_MaxOrder;				// Buddy order of a whole block
+	bool m_SeparateLinear;				// True if buffers and images need separate blocks due to bufferImageGranularity
+
+	mutable std::mutex m_Mutex;			// Guards blocks and statistics
+	std::unordered_map<VkDeviceMemory, std::unique_ptr<Block>> m_Blocks;	// Shared blocks by device memory
+	MemoryStats m_Stats = {};			// Usage statistics
+
+	// FUNCTIONS
+	Allocation Allocate(const VkMemoryRequirements& requirements, VkMemoryPropertyFlags properties, bool linear);	// Allocate memory matching requirements
+	Allocation AllocateDedicated(VkDeviceSize size, uint32_t memoryType);	// Allocate memory owning its own device memory
+	bool AllocateFromBlock(Block* block, uint32_t order, Allocation& allocation);	// Try to take buddy of order from block
+	Block* CreateBlock(uint32_t memoryType, bool linear);	// Allocate new shared block
+	void DestroyBlock(Block* block);	// Free shared block
+	void* MapMemory(VkDeviceMemory memory, uint32_t memoryType);	// Map memory if host visible
+	uint32_t GetOrder(VkDeviceSize size) const;	// Smallest buddy order fitting size
+	VkDeviceSize GetOrderSize(uint32_t order) const { return MIN_ALLOCATION_SIZE << order; }
+};
@@ -0,0 +1,113 @@
+#include "Mesh.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+// Constructor
+Mesh::Mesh(Device* device, MemoryAllocator* allocator, UploadManager* uploadManager, const std::vector<VertexStreamData>& streams, uint32_t vertexCount, const void* indexData, uint32_t indexCount, VkIndexType indexType)
+: m_Device(device), m_VertexCount(vertexCount) {
+	// Create and upload buffers
+	CreateVertexBuffers(allocator, uploadManager, streams);
+	CreateIndexBuffer(allocator, uploadManager, indexData, indexCount, indexType);
+}
+
+// Constructor
+Mesh::Mesh(Device* device, MemoryAllocator* allocator, UploadManager* uploadManager, const std::vector<VertexStreamData>& streams, uint32_t vertexCount, const std::vector<uint32_t>& indices)
+: m_Device(device), m_VertexCount(vertexCount) {
+	// Create and upload vertex buffers
+	CreateVertexBuffers(allocator, uploadManager, streams);
+
+	// Use 16 bit indices when every vertex can be addressed, halving index fetch
+	if (m_VertexCount <= 65536) {
+		std::vector<uint16_t> shortIndices(indices.begin(), indices.end());
+		CreateIndexBuffer(allocator, uploadManager, shortIndices.data(), static_cast<uint32_t>(shortIndices.size()), VK_INDEX_TYPE_UINT16);
+	}
+	else {
+		CreateIndexBuffer(allocator, uploadManager, indices.data(), static_cast<uint32_t>(indices.size()), VK_INDEX_TYPE_UINT32);
+	}
+}
+
+// Constructor for a single stream
+Mesh::Mesh(Device* device, MemoryAllocator* allocator, UploadManager* uploadManager, const void* vertexData, uint32_t vertexCount, uint32_t vertexStride, const std::vector<uint32_t>& indices)
+: Mesh(device, allocator, uploadManager, std::vector<VertexStreamData>{ { vertexData, vertexStride } }, vertexCount, indices) {
+}
+
+// Destructor
+Mesh::~Mesh(){
+}
+
+// Bind vertex and index buffers
+void Mesh::Bind(VkCommandBuffer commandBuffer){
+	// Bind every stream to the binding matching its index
+	vkCmdBindVertexBuffers(commandBuffer, 0, static_cast<uint32_t>(m_VertexBufferHandles.size()), m_VertexBufferHandles.data(), m_VertexBufferOffsets.data());
+
+	// Bind index buffer if indexed
+	if (m_IndexBuffer) {
+		vkCmdBindIndexBuffer(commandBuffer, m_IndexBuffer->GetBuffer(), 0, m_IndexType);
+	}
+}
+
+// Draw level of detail, whole mesh if it has no levels
+void Mesh::Draw(VkCommandBuffer commandBuffer, uint32_t instanceCount, uint32_t lod){
+	// Draw indexed range of level if index buffer exists, else every vertex in order
+	if (m_IndexBuffer) {
+		auto& level = m_Lods[std::min(lod, GetLodCount() - 1)];
+		vkCmdDrawIndexed(commandBuffer, level.indexCount, instanceCount, level.firstIndex, 0, 0);
+	}
+	else {
+		vkCmdDraw(commandBuffer, m_VertexCount, instanceCount, 0, 0);
+	}
+}
+
+// Set index ranges of levels of detail, most detailed first
+void Mesh::SetLods(const std::vector<MeshLod>& lods){
+	// Throw error if a level reads past the index buffer
+	for (auto& lod : lods) {
+		if (static_cast<uint64_t>(lod.firstIndex) + lod.indexCount > m_IndexCount) {
+			throw std::runtime_error("Unable to set mesh level of detail outside index buffer!");
+		}
+	}
+
+	// Keep a single level covering every index if none were given
+	if (!lods.empty()) {
+		m_Lods = lods;
+	}
+}
+
+// Create device local vertex buffer per stream and queue uploads
+void Mesh::CreateVertexBuffers(MemoryAllocator* allocator, UploadManager* uploadManager, const std::vector<VertexStreamData>& streams){
+	// Throw error if mesh is empty
+	if (m_VertexCount == 0 || streams.empty()) {
+		throw std::runtime_error("Unable to create mesh without vertices!");
+	}
+
+	for (auto& stream : streams) {
+		// Create buffer and queue copy, data is copied into staging memory before returning
+		auto vertexSize = static_cast<VkDeviceSize>(stream.stride) * m_VertexCount;
+		auto vertexBuffer = std::make_unique<Buffer>(m_Device, allocator, vertexSize, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, nullptr);
+		uploadManager->UploadBuffer(vertexBuffer.get(), stream.data, vertexSize);
+
+		m_VertexStrides.emplace_back(stream.stride);
+		m_VertexBufferHandles.emplace_back(vertexBuffer->GetBuffer());
+		m_VertexBufferOffsets.emplace_back(0);
+		m_VertexBuffers.emplace_back(std::move(vertexBuffer));
+	}
+}
+
+// Create device local index buffer and queue upload
+void Mesh::CreateIndexBuffer(MemoryAllocator* allocator, UploadManager* uploadManager, const void* indexData, uint32_t indexCount, VkIndexType indexType){
+	// Single level covering every index
+	m_IndexCount = indexCount;
+	m_IndexType = indexType;
+	m_Lods = { { 0, indexCount, 0.0f } };
+
+	// Done if mesh is not indexed
+	if (indexCount == 0) {
+		return;
+	}
+
+	// Create buffer and queue copy
+	auto indexSize = static_cast<VkDeviceSize>(indexCount) * (indexType == VK_INDEX_TYPE_UINT16 ? sizeof(uint16_t) : sizeof(uint32_t));
+	m_IndexBuffer = std::make_unique<Buffer>(m_Device, allocator, indexSize, VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, nullptr);
+	uploadManager->UploadBuffer(m_IndexBuffer.get(), indexData, indexSize);
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <memory>
+#include <type_traits>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+#include "BindlessTable.h"
+#include "Buffer.h"
+#include "Device.h"
+#include "MemoryAllocator.h"
+#include "UploadManager.h"
+#include "Vertex.h"
+
+// Vertex data of one stream, bound to the binding matching its index
+struct VertexStreamData {
+	const void* data;	// Vertex bytes
+	uint32_t stride;	// Bytes per vertex
+};
+
+// Range of the index buffer drawn for a level of detail
+struct MeshLod {
+	uint32_t firstIndex = 0;	// First index of level
+	uint32_t indexCount = 0;	// Indices of level
+	float error = 0.0f;			// Object space error of level against full detail
+};
+
+// Axis aligned box and bounding sphere of a mesh in object space
+struct MeshBounds {
+	glm::vec3 min = glm::vec3(0.0f);		// Smallest corner
+	glm::vec3 max = glm::vec3(0.0f);		// Largest corner
+	glm::vec3 centre = glm::vec3(0.0f);	// Sphere centre
+	float radius = 0.0f;				// Sphere radius
+};
+
+class Mesh {
+public:
+	Mesh(Device* device, MemoryAllocator* allocator, UploadManager* uploadManager, const std::vector<VertexStreamData>& streams, uint32_t vertexCount, const void* indexData, uint32_t indexCount, VkIndexType indexType);	// Constructor, indices already in their final type are uploaded as is
+	Mesh(Device* device, MemoryAllocator* allocator, UploadManager* uploadManager, const std::vector<VertexStreamData>& streams, uint32_t vertexCount, const std::vector<uint32_t>& indices = {});	// Constructor, one buffer per stream, no indices draws vertices in order
+	Mesh(Device* device, MemoryAllocator* allocator, UploadManager* uploadManager, const void* vertexData, uint32_t vertexCount, uint32_t vertexStride, const std::vector<uint32_t>& indices = {});	// Constructor for a single stream
+
+	// Constructor for any trivially copyable vertex type
+	template<typename VertexType>
+	Mesh(Device* device, MemoryAllocator* allocator, UploadManager* uploadManager, const std::vector<VertexType>& vertices, const std::vector<uint32_t>& indices = {})
+	: Mesh(device, allocator, uploadManager, vertices.data(), static_cast<uint32_t>(vertices.size()), static_cast<uint32_t>(sizeof(VertexType)), indices) {
+		static_assert(std::is_trivially_copyable_v<VertexType>, "Vertices are copied to the GPU byte for byte!");
+	}
+	~Mesh();	// Destructor
+
+	// FUNCTIONS
+	void Bind(VkCommandBuffer commandBuffer);	// Bind vertex and index buffers
+	void Draw(VkCommandBuffer commandBuffer, uint32_t instanceCount = 1, uint32_t lod = 0);	// Draw level of detail, whole mesh if it has no levels
+
+	// GETTERS
+	const uint32_t GetVertexCount() const { return m_VertexCount; }
+	const uint32_t GetVertexStride(uint32_t stream = 0) const { return m_VertexStrides[stream]; }
+	const uint32_t GetStreamCount() const { return static_cast<uint32_t>(m_VertexBuffers.size()); }
+	const uint32_t GetIndexCount() const { return m_IndexCount; }
+	const VkIndexType GetIndexType() const { return m_IndexType; }
+	const bool IsIndexed() const { return m_IndexBuffer != nullptr; }
+	Buffer* GetVertexBuffer(uint32_t stream = 0) const { return m_VertexBuffers[stream].get(); }
+	Buffer* GetIndexBuffer() const { return m_IndexBuffer.get(); }
+	const std::vector<MeshLod>& GetLods() const { return m_Lods; }
+	const uint32_t GetLodCount() const { return static_cast<uint32_t>(m_Lods.size()); }
+	const MeshBounds& GetBounds() const { return m_Bounds; }
+	const ResourceIndices& GetResources() const { return m_Resources; }
+
+	// SETTERS
+	void SetLods(const std::vector<MeshLod>& lods);	// Set index ranges of levels of detail, most detailed first
+	void SetBounds(const MeshBounds& bounds) { m_Bounds = bounds; }
+	void SetResources(const ResourceIndices& resources) { m_Resources = resources; }	// Set bindless slots pushed before the mesh is drawn
+private:
+	// VARIABLES
+	Device* m_Device;					// Vulkan device
+
+	uint32_t m_VertexCount;								// Amount of vertices
+	std::vector<uint32_t> m_VertexStrides;				// Bytes per vertex of each stream
+	uint32_t m_IndexCount = 0;							// Amount of indices
+	VkIndexType m_IndexType = VK_INDEX_TYPE_UINT32;		// Index type, 16 bit when every vertex fits
+	std::vector<std::unique_ptr<Buffer>> m_VertexBuffers;	// Device local vertex buffer per stream
+	std::vector<VkBuffer> m_VertexBufferHandles;			// Vertex buffers bound in one call
+	std::vector<VkDeviceSize> m_VertexBufferOffsets;		// Zero offset per stream
+	std::unique_ptr<Buffer> m_IndexBuffer;				// Device local index buffer, null if not indexed
+	std::vector<MeshLod> m_Lods;						// Levels of detail, a single level covers every index
+	MeshBounds m_Bounds = {};							// Object space bounds, zero unless set
+	ResourceIndices m_Resources = {};					// Bindless slots pushed before drawing, default white texture and zeroed buffer
+
+	// FUNCTIONS
+	void CreateVertexBuffers(MemoryAllocator* allocator, UploadManager* uploadManager, const std::vector<VertexStreamData>& streams);	// Create device local vertex buffer per stream and queue uploads
+	void CreateIndexBuffer(MemoryAllocator* allocator, UploadManager* uploadManager, const void* indexData, uint32_t indexCount, VkIndexType indexType);	// Create device local index buffer and queue upload
+};
@@ -0,0 +1,67 @@
+#include "OffscreenTarget.h"
+
+#include <cstring>
+#include <stdexcept>
+
+// Constructor
+OffscreenTarget::OffscreenTarget(Device* device, MemoryAllocator* allocator, VkExtent2D extent, uint32_t imageCount, VkFormat format)
+: m_Device(device), m_Allocator(allocator), m_Extent(extent), m_Format(format) {
+	// Only 4 byte formats are read back tightly packed
+	if (m_Format != VK_FORMAT_R8G8B8A8_UNORM && m_Format != VK_FORMAT_B8G8R8A8_UNORM) {
+		throw std::runtime_error("Unsupported offscreen image format!");
+	}
+	m_ImageSize = static_cast<VkDeviceSize>(m_Extent.width) * m_Extent.height * 4;
+
+	// Start on last image so first acquire returns image 0
+	m_ActiveImageIndex = imageCount - 1;
+
+	// Create image ring and matching readback buffers
+	for (uint32_t i = 0; i < imageCount; i++) {
+		m_Images.emplace_back(std::make_unique<Image>(m_Device, m_Allocator, m_Extent, m_Format, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT));
+		m_ImageViews.emplace_back(m_Images.back()->GetImageView());
+		m_ReadbackBuffers.emplace_back(std::make_unique<Buffer>(m_Device, m_Allocator, m_ImageSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, nullptr));
+	}
+}
+
+// Destructor
+OffscreenTarget::~OffscreenTarget(){
+
+}
+
+// Advance to next image in ring and return its index
+uint32_t OffscreenTarget::AcquireNextImage(){
+	m_ActiveImageIndex = (m_ActiveImageIndex + 1) % GetImageCount();
+	return m_ActiveImageIndex;
+}
+
+// Record copy of rendered image into its readback buffer
+void OffscreenTarget::RecordReadback(VkCommandBuffer commandBuffer, uint32_t imageIndex){
+	// Copy whole image into buffer, render pass dependency into external already made colour writes visible to the transfer
+	VkBufferImageCopy region = {};
+	region.bufferOffset = 0;
+	region.bufferRowLength = 0;
+	region.bufferImageHeight = 0;
+	region.imageSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 };
+	region.imageOffset = { 0, 0, 0 };
+	region.imageExtent = { m_Extent.width, m_Extent.height, 1 };
+	vkCmdCopyImageToBuffer(commandBuffer, m_Images[imageIndex]->GetImage(), VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, m_ReadbackBuffers[imageIndex]->GetBuffer(), 1, &region);
+
+	// Make transfer writes visible to the host
+	VkBufferMemoryBarrier bufferBarrier = {};
+	bufferBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+	bufferBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+	bufferBarrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+	bufferBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	bufferBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	bufferBarrier.buffer = m_ReadbackBuffers[imageIndex]->GetBuffer();
+	bufferBarrier.offset = 0;
+	bufferBarrier.size = VK_WHOLE_SIZE;
+	vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 0, nullptr, 1, &bufferBarrier, 0, nullptr);
+}
+
+// Copy readback buffer contents to CPU memory
+void OffscreenTarget::ReadPixels(uint32_t imageIndex, std::vector<uint8_t>& pixels) const{
+	// Copy pixels out of persistently mapped readback buffer
+	pixels.resize(static_cast<size_t>(m_ImageSize));
+	std::memcpy(pixels.data(), m_ReadbackBuffers[imageIndex]->GetMappedData(), pixels.size());
+}
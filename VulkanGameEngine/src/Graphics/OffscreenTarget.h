@@ -0,0 +1,53 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+#include "Buffer.h"
+#include "Device.h"
+#include "Image.h"
+#include "MemoryAllocator.h"
+#include "RenderTarget.h"
+
+// Finished frame read back from an offscreen image
+struct ReadbackFrame {
+	uint64_t frameNumber = 0;	// Number of the frame that produced the pixels
+	uint32_t width = 0;			// Width in pixels
+	uint32_t height = 0;		// Height in pixels
+	VkFormat format = VK_FORMAT_UNDEFINED;	// Pixel format
+	std::vector<uint8_t> pixels;			// Tightly packed pixel data
+};
+
+class OffscreenTarget : public RenderTarget {
+public:
+	OffscreenTarget(Device* device, MemoryAllocator* allocator, VkExtent2D extent, uint32_t imageCount, VkFormat format = VK_FORMAT_R8G8B8A8_UNORM);	// Constructor
+	~OffscreenTarget();	// Destructor
+
+	// FUNCTIONS
+	uint32_t AcquireNextImage();	// Advance to next image in ring and return its index
+	void RecordReadback(VkCommandBuffer commandBuffer, uint32_t imageIndex);	// Record copy of rendered image into its readback buffer
+	void ReadPixels(uint32_t imageIndex, std::vector<uint8_t>& pixels) const;	// Copy readback buffer contents to CPU memory
+
+	// GETTERS
+	VkExtent2D GetExtent() const override { return m_Extent; }
+	const uint32_t GetImageCount() const override { return static_cast<uint32_t>(m_Images.size()); }
+	const uint32_t GetActiveImageIndex() const { return m_ActiveImageIndex; }
+	const std::vector<VkImageView> GetImageViews() const override { return m_ImageViews; }
+	const VkFormat GetImageFormat() const override { return m_Format; }
+	const VkImageLayout GetFinalLayout() const override { return VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL; }
+	const VkDeviceSize GetImageSize() const { return m_ImageSize; }
+private:
+	// VARIABLES
+	Device* m_Device;					// Vulkan device
+	MemoryAllocator* m_Allocator;		// Device memory allocator
+
+	VkExtent2D m_Extent;				// Image extent
+	VkFormat m_Format;					// Image format
+	VkDeviceSize m_ImageSize;			// Size of one image in bytes
+	uint32_t m_ActiveImageIndex = 0;	// Index of active image in ring
+
+	std::vector<std::unique_ptr<Image>> m_Images;			// Offscreen colour images
+	std::vector<VkImageView> m_ImageViews;					// Views of offscreen images
+	std::vector<std::unique_ptr<Buffer>> m_ReadbackBuffers;	// Host visible buffers images are copied into
+};
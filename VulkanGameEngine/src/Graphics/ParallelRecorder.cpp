@@ -0,0 +1,63 @@
+#include "ParallelRecorder.h"
+
+#include <algorithm>
+
+#include "../Core/Profiler.h"
+
+// Constructor
+ParallelRecorder::ParallelRecorder(Device* device, ThreadPool* threadPool, uint32_t frameCount)
+: m_Device(device), m_ThreadPool(threadPool), m_WorkerCount(threadPool->GetThreadCount()) {
+	// Create command allocator for every worker
+	for (uint32_t i = 0; i < m_WorkerCount; i++) {
+		m_Allocators.emplace_back(std::make_unique<CommandAllocator>(m_Device, m_Device->GetGraphicsFamily(), frameCount));
+	}
+}
+
+// Destructor
+ParallelRecorder::~ParallelRecorder(){
+}
+
+// Recycle worker command buffers of frame, its fence must have signalled
+void ParallelRecorder::BeginFrame(uint32_t frameIndex){
+	for (auto& allocator : m_Allocators) {
+		allocator->BeginFrame(frameIndex);
+	}
+}
+
+// Split draws over workers and execute their secondaries in primary
+void ParallelRecorder::Record(VkCommandBuffer primary, VkRenderPass renderPass, VkFramebuffer framebuffer, uint32_t drawCount, const RecordFunction& recordFunction){
+	// Only use as many workers as there is work for
+	auto workerCount = std::min(m_WorkerCount, std::max(1u, (drawCount + MIN_DRAWS_PER_WORKER - 1) / MIN_DRAWS_PER_WORKER));
+	auto drawsPerWorker = (drawCount + workerCount - 1) / workerCount;
+
+	// Secondaries continue the primary render pass
+	VkCommandBufferInheritanceInfo inheritanceInfo = {};
+	inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+	inheritanceInfo.renderPass = renderPass;
+	inheritanceInfo.subpass = 0;
+	inheritanceInfo.framebuffer = framebuffer;
+
+	// Record slices in parallel, each worker only allocates from its own pools
+	std::vector<VkCommandBuffer> secondaries(workerCount);
+	for (uint32_t i = 0; i < workerCount; i++) {
+		auto first = std::min(drawCount, i * drawsPerWorker);
+		auto count = std::min(drawsPerWorker, drawCount - first);
+		auto allocator = m_Allocators[i].get();
+		auto secondary = &secondaries[i];
+		m_ThreadPool->Enqueue([allocator, secondary, inheritanceInfo, first, count, &recordFunction]() {
+			PROFILE_SCOPE("RecordSlice");
+			auto commandBuffer = allocator->Allocate(VK_COMMAND_BUFFER_LEVEL_SECONDARY);
+			commandBuffer->Begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT, &inheritanceInfo);
+			recordFunction(commandBuffer->GetCommandBuffer(), first, count);
+			commandBuffer->End();
+			*secondary = commandBuffer->GetCommandBuffer();
+		});
+	}
+	{
+		PROFILE_SCOPE("WaitForWorkers");
+		m_ThreadPool->Wait();
+	}
+
+	// Execute secondaries in slice order
+	vkCmdExecuteCommands(primary, workerCount, secondaries.data());
+}
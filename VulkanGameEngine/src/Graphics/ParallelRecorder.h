@@ -0,0 +1,34 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+#include "../Core/ThreadPool.h"
+#include "CommandAllocator.h"
+#include "Device.h"
+
+class ParallelRecorder {
+public:
+	using RecordFunction = std::function<void(VkCommandBuffer commandBuffer, uint32_t first, uint32_t count)>;	// Records draws [first, first + count) into secondary buffer
+
+	ParallelRecorder(Device* device, ThreadPool* threadPool, uint32_t frameCount);	// Constructor
+	~ParallelRecorder();	// Destructor
+
+	static const uint32_t MIN_DRAWS_PER_WORKER = 64;	// Fewer draws per worker cost more in overhead than they save
+
+	// FUNCTIONS
+	void BeginFrame(uint32_t frameIndex);	// Recycle worker command buffers of frame, its fence must have signalled
+	void Record(VkCommandBuffer primary, VkRenderPass renderPass, VkFramebuffer framebuffer, uint32_t drawCount, const RecordFunction& recordFunction);	// Split draws over workers and execute their secondaries in primary
+
+	// GETTERS
+	const uint32_t GetWorkerCount() const { return m_WorkerCount; }
+private:
+	// VARIABLES
+	Device* m_Device;			// Vulkan device
+	ThreadPool* m_ThreadPool;	// Worker threads
+
+	uint32_t m_WorkerCount;		// Workers recording in parallel
+	std::vector<std::unique_ptr<CommandAllocator>> m_Allocators;	// Per-worker command pools per frame, pools are not thread safe
+};
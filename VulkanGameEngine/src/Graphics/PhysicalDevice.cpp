@@ -1,5 +1,6 @@
 #include "PhysicalDevice.h"
 
+#include <cstring>
 #include <map>
 #include <set>
 #include <stdexcept>
@@ -15,6 +16,47 @@ PhysicalDevice::~PhysicalDevice(){
 	
 }
 
+// Find memory type index matching filter and properties
+uint32_t PhysicalDevice::FindMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) const{
+	// Loop through memory types
+	for (uint32_t i = 0; i < m_MemoryProperties.memoryTypeCount; i++) {
+		if ((typeFilter & (1 << i)) && (m_MemoryProperties.memoryTypes[i].propertyFlags & properties) == properties) {
+			return i;
+		}
+	}
+
+	// If nothing found throw error
+	throw std::runtime_error("Unable to find suitable memory type!");
+}
+
+// True if images of format and tiling support every feature
+bool PhysicalDevice::SupportsFormat(VkFormat format, VkFormatFeatureFlags features, VkImageTiling tiling) const{
+	// Query features of format
+	VkFormatProperties properties = {};
+	vkGetPhysicalDeviceFormatProperties(m_PhysicalDevice, format, &properties);
+
+	// Check features of requested tiling
+	auto supported = tiling == VK_IMAGE_TILING_LINEAR ? properties.linearTilingFeatures : properties.optimalTilingFeatures;
+	return (supported & features) == features;
+}
+
+// True if device exposes extension
+bool PhysicalDevice::SupportsExtension(const char* extensionName) const{
+	// Enumerate extensions
+	uint32_t extensionCount;
+	vkEnumerateDeviceExtensionProperties(m_PhysicalDevice, nullptr, &extensionCount, nullptr);
+	std::vector<VkExtensionProperties> availableExtensions(extensionCount);
+	vkEnumerateDeviceExtensionProperties(m_PhysicalDevice, nullptr, &extensionCount, availableExtensions.data());
+
+	// Look for extension by name
+	for (const auto& extension : availableExtensions) {
+		if (std::strcmp(extension.extensionName, extensionName) == 0) {
+			return true;
+		}
+	}
+	return false;
+}
+
 // Function that picks physical device
 void PhysicalDevice::PickPhysicalDevice(){
 
@@ -55,6 +97,7 @@ void PhysicalDevice::PickPhysicalDevice(){
 	vkGetPhysicalDeviceProperties(m_PhysicalDevice, &m_Properties);
 	vkGetPhysicalDeviceFeatures(m_PhysicalDevice, &m_Features);
 	vkGetPhysicalDeviceMemoryProperties(m_PhysicalDevice, &m_MemoryProperties);
+	QueryDescriptorIndexing();
 }
 
 // Function that rates all physical devices and returns score
@@ -99,7 +142,8 @@ bool PhysicalDevice::CheckDeviceExtensionSupport(VkPhysicalDevice device){
 	vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount, availableExtensions.data());
 
 	// Set of required extensions
-	std::set<std::string> requiredExtensions(Instance::m_DeviceExtensions.begin(), Instance::m_DeviceExtensions.end());
+	auto deviceExtensions = m_Instance->GetDeviceExtensions();
+	std::set<std::string> requiredExtensions(deviceExtensions.begin(), deviceExtensions.end());
 
 	// Loop through available extensions
 	for (const auto& extension : availableExtensions) {
@@ -109,3 +153,27 @@ bool PhysicalDevice::CheckDeviceExtensionSupport(VkPhysicalDevice device){
 	// Return true if all required extensions were found
 	return requiredExtensions.empty();
 }
+
+// Query descriptor indexing features and limits of picked device
+void PhysicalDevice::QueryDescriptorIndexing(){
+	// Structures are chained through Vulkan 1.1 queries, leave everything unsupported on older devices
+	m_DescriptorIndexingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+	m_DescriptorIndexingProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES_EXT;
+	if (m_Properties.apiVersion < VK_API_VERSION_1_1 || !SupportsExtension(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME)) {
+		return;
+	}
+
+	// Query features
+	VkPhysicalDeviceFeatures2 features = {};
+	features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+	features.pNext = &m_DescriptorIndexingFeatures;
+	vkGetPhysicalDeviceFeatures2(m_PhysicalDevice, &features);
+	m_DescriptorIndexingFeatures.pNext = nullptr;
+
+	// Query update after bind limits
+	VkPhysicalDeviceProperties2 properties = {};
+	properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+	properties.pNext = &m_DescriptorIndexingProperties;
+	vkGetPhysicalDeviceProperties2(m_PhysicalDevice, &properties);
+	m_DescriptorIndexingProperties.pNext = nullptr;
+}
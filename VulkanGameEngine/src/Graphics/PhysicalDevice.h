@@ -11,12 +11,19 @@ public:
 	PhysicalDevice(const Instance* instance);	// Constructor
 	~PhysicalDevice();	// Destructor
 
+	// FUNCTIONS
+	uint32_t FindMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) const;	// Find memory type index matching filter and properties
+	bool SupportsFormat(VkFormat format, VkFormatFeatureFlags features, VkImageTiling tiling = VK_IMAGE_TILING_OPTIMAL) const;	// True if images of format and tiling support every feature
+	bool SupportsExtension(const char* extensionName) const;	// True if device exposes extension
+
 	// GETTERS
 	const VkPhysicalDevice GetPhysicalDevice() const { return m_PhysicalDevice; }
 	const VkPhysicalDeviceProperties GetProperties() const { return m_Properties; }
 	const VkPhysicalDeviceFeatures GetFeatures() const { return m_Features; }
 	const VkPhysicalDeviceMemoryProperties GetMemoryProperties() const { return m_MemoryProperties; }
 	const VkSampleCountFlagBits GetMsaaSamples() const { return m_MsaaSamples; }
+	const VkPhysicalDeviceDescriptorIndexingFeaturesEXT GetDescriptorIndexingFeatures() const { return m_DescriptorIndexingFeatures; }
+	const VkPhysicalDeviceDescriptorIndexingPropertiesEXT GetDescriptorIndexingProperties() const { return m_DescriptorIndexingProperties; }
 
 private:
 	// VARIABLES
@@ -27,10 +34,13 @@ private:
 	VkPhysicalDeviceFeatures m_Features = {};			// Vulkan physical device features
 	VkPhysicalDeviceMemoryProperties m_MemoryProperties = {};	// Vulkan physical device memory properties
 	VkSampleCountFlagBits m_MsaaSamples = VK_SAMPLE_COUNT_1_BIT;// MSAA sample count
+	VkPhysicalDeviceDescriptorIndexingFeaturesEXT m_DescriptorIndexingFeatures = {};		// Descriptor indexing features, all false without the extension
+	VkPhysicalDeviceDescriptorIndexingPropertiesEXT m_DescriptorIndexingProperties = {};	// Update after bind limits, all zero without the extension
 
 	// FUNCTIONS
 	void PickPhysicalDevice();					// Function that picks physical device
 	int RateDevice(VkPhysicalDevice device);	// Function that rates all physical devices and returns score
 	bool CheckDeviceExtensionSupport(VkPhysicalDevice device);	// Check extension support on physical device
+	void QueryDescriptorIndexing();				// Query descriptor indexing features and limits of picked device
 };
 
@@ -0,0 +1,117 @@
+#include "PipelineCache.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+// Constructor
+PipelineCache::PipelineCache(Device* device, PhysicalDevice* physicalDevice, const std::string& path)
+: m_Device(device), m_PhysicalDevice(physicalDevice), m_Path(path) {
+	// Load cache data, discarding it if written by another driver or device
+	auto data = LoadFile();
+	if (!data.empty() && !IsCompatible(data)) {
+		std::cout << "Discarding incompatible pipeline cache " << m_Path << std::endl;
+		data.clear();
+	}
+	m_LoadedFromDisk = !data.empty();
+
+	// Pipeline cache creation info
+	VkPipelineCacheCreateInfo cacheInfo = {};
+	cacheInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+	cacheInfo.initialDataSize = data.size();
+	cacheInfo.pInitialData = data.empty() ? nullptr : data.data();
+
+	// Create pipeline cache
+	if (vkCreatePipelineCache(m_Device->GetDevice(), &cacheInfo, nullptr, &m_PipelineCache) != VK_SUCCESS) {
+		throw std::runtime_error("Unable to create pipeline cache!");
+	}
+}
+
+// Destructor
+PipelineCache::~PipelineCache(){
+	// Write cache back to disk, failing only costs compile time next launch
+	if (!Save()) {
+		std::cout << "Unable to save pipeline cache " << m_Path << std::endl;
+	}
+
+	// Destroy pipeline cache
+	vkDestroyPipelineCache(m_Device->GetDevice(), m_PipelineCache, nullptr);
+}
+
+// Write cache to disk atomically, returns false on failure
+bool PipelineCache::Save(){
+	// Get cache data
+	size_t dataSize = 0;
+	if (vkGetPipelineCacheData(m_Device->GetDevice(), m_PipelineCache, &dataSize, nullptr) != VK_SUCCESS) {
+		return false;
+	}
+	std::vector<char> data(dataSize);
+	if (vkGetPipelineCacheData(m_Device->GetDevice(), m_PipelineCache, &dataSize, data.data()) != VK_SUCCESS) {
+		return false;
+	}
+
+	// Write to temporary file so a crash never leaves a truncated cache behind
+	auto tempPath = m_Path + ".tmp";
+	{
+		std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+		if (!file.is_open()) {
+			return false;
+		}
+		file.write(data.data(), dataSize);
+		if (!file) {
+			return false;
+		}
+	}
+
+	// Replace cache file with temporary file
+	std::error_code error;
+	std::filesystem::rename(tempPath, m_Path, error);
+	return !error;
+}
+
+// Read cache file, empty if missing
+std::vector<char> PipelineCache::LoadFile() const{
+	// Open file in binary, a missing cache is not an error
+	std::ifstream file(m_Path, std::ios::ate | std::ios::binary);
+	if (!file.is_open()) {
+		return {};
+	}
+
+	// Read contents into buffer
+	size_t fileSize = (size_t)file.tellg();
+	std::vector<char> buffer(fileSize);
+	file.seekg(0);
+	file.read(buffer.data(), fileSize);
+	if (!file) {
+		return {};
+	}
+	return buffer;
+}
+
+// Check cache header against physical device
+bool PipelineCache::IsCompatible(const std::vector<char>& data) const{
+	// Header is length, version, vendor ID, device ID and cache UUID
+	const size_t headerSize = 16 + VK_UUID_SIZE;
+	if (data.size() < headerSize) {
+		return false;
+	}
+
+	// Read header fields
+	uint32_t headerLength, headerVersion, vendorID, deviceID;
+	uint8_t cacheUUID[VK_UUID_SIZE];
+	std::memcpy(&headerLength, data.data(), 4);
+	std::memcpy(&headerVersion, data.data() + 4, 4);
+	std::memcpy(&vendorID, data.data() + 8, 4);
+	std::memcpy(&deviceID, data.data() + 12, 4);
+	std::memcpy(cacheUUID, data.data() + 16, VK_UUID_SIZE);
+
+	// Compare against physical device
+	auto properties = m_PhysicalDevice->GetProperties();
+	return headerLength >= headerSize && headerLength <= data.size()
+		&& headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE
+		&& vendorID == properties.vendorID
+		&& deviceID == properties.deviceID
+		&& std::memcmp(cacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+}
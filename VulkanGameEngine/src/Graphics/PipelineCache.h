@@ -0,0 +1,33 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+#include "Device.h"
+#include "PhysicalDevice.h"
+
+class PipelineCache {
+public:
+	PipelineCache(Device* device, PhysicalDevice* physicalDevice, const std::string& path = "pipeline_cache.bin");	// Constructor, loads cache from disk if it matches this device
+	~PipelineCache();	// Destructor, writes cache back to disk
+
+	// FUNCTIONS
+	bool Save();	// Write cache to disk atomically, returns false on failure
+
+	// GETTERS
+	const VkPipelineCache GetPipelineCache() const { return m_PipelineCache; }
+	const bool GetLoadedFromDisk() const { return m_LoadedFromDisk; }
+private:
+	// VARIABLES
+	Device* m_Device;					// Vulkan device
+	PhysicalDevice* m_PhysicalDevice;	// Vulkan physical device
+
+	std::string m_Path;								// Cache file path
+	bool m_LoadedFromDisk = false;					// True if cache was created from valid file data
+	VkPipelineCache m_PipelineCache = VK_NULL_HANDLE;	// Vulkan pipeline cache
+
+	// FUNCTIONS
+	std::vector<char> LoadFile() const;	// Read cache file, empty if missing
+	bool IsCompatible(const std::vector<char>& data) const;	// Check cache header against physical device
+};
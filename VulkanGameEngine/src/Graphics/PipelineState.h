@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vulkan/vulkan.h>
+
+#include "VertexFormats.h"
+
+// Full fixed-function and shader state of a graphics pipeline, viewport and scissor are dynamic
+struct PipelineState {
+	std::string_view vertexShader = "src/res/shaders/default_vert.spv";		// Vertex shader SPIR-V path
+	std::string_view fragmentShader = "src/res/shaders/default_frag.spv";	// Fragment shader SPIR-V path
+	const VertexInputDescription* vertexInput = &StandardInput::DESCRIPTION;	// Vertex streams consumed, checked against vertex shader inputs
+
+	VkPrimitiveTopology topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;	// Input assembly topology
+	VkPolygonMode polygonMode = VK_POLYGON_MODE_FILL;					// Rasterizer polygon mode
+	VkCullModeFlags cullMode = VK_CULL_MODE_BACK_BIT;					// Faces culled
+	VkFrontFace frontFace = VK_FRONT_FACE_CLOCKWISE;					// Winding of front faces
+
+	bool blendEnable = true;											// Alpha blending
+	VkBlendFactor srcColourBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;		// Colour source factor
+	VkBlendFactor dstColourBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;	// Colour destination factor
+	VkBlendOp colourBlendOp = VK_BLEND_OP_ADD;							// Colour blend operation
+	VkBlendFactor srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;			// Alpha source factor
+	VkBlendFactor dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;			// Alpha destination factor
+	VkBlendOp alphaBlendOp = VK_BLEND_OP_ADD;							// Alpha blend operation
+
+	// FNV-1a hash of all state, constexpr so fixed states hash at compile time
+	constexpr uint64_t Hash() const {
+		uint64_t hash = 14695981039346656037ull;
+		auto mix = [&hash](uint64_t value) {
+			for (int i = 0; i < 8; i++) {
+				hash ^= (value >> (i * 8)) & 0xff;
+				hash *= 1099511628211ull;
+			}
+		};
+		for (auto c : vertexShader) mix(static_cast<uint8_t>(c));
+		mix(0xff);
+		for (auto c : fragmentShader) mix(static_cast<uint8_t>(c));
+		mix(0xff);
+		mix(vertexInput ? vertexInput->hash : 0);
+		mix(topology);
+		mix(polygonMode);
+		mix(cullMode);
+		mix(frontFace);
+		mix(blendEnable);
+		mix(srcColourBlendFactor);
+		mix(dstColourBlendFactor);
+		mix(colourBlendOp);
+		mix(srcAlphaBlendFactor);
+		mix(dstAlphaBlendFactor);
+		mix(alphaBlendOp);
+		return hash;
+	}
+
+	// Operator overloads
+	constexpr bool operator==(const PipelineState& other) const {
+		return vertexShader == other.vertexShader && fragmentShader == other.fragmentShader && vertexInput == other.vertexInput
+			&& topology == other.topology && polygonMode == other.polygonMode && cullMode == other.cullMode && frontFace == other.frontFace
+			&& blendEnable == other.blendEnable && srcColourBlendFactor == other.srcColourBlendFactor && dstColourBlendFactor == other.dstColourBlendFactor
+			&& colourBlendOp == other.colourBlendOp && srcAlphaBlendFactor == other.srcAlphaBlendFactor && dstAlphaBlendFactor == other.dstAlphaBlendFactor
+			&& alphaBlendOp == other.alphaBlendOp;
+	}
+
+	constexpr bool operator!=(const PipelineState& other) const {
+		return !operator==(other);
+	}
+
+	// STATIC GETTERS
+	static constexpr PipelineState Default() { return PipelineState(); }
+	static constexpr PipelineState Instanced() {
+		PipelineState state;
+		state.vertexShader = "src/res/shaders/instanced_vert.spv";
+		state.vertexInput = &InstancedInput::DESCRIPTION;
+		return state;
+	}
+	static constexpr PipelineState Textured() {
+		PipelineState state;
+		state.vertexShader = "src/res/shaders/textured_vert.spv";
+		state.fragmentShader = "src/res/shaders/textured_frag.spv";
+		return state;
+	}
+	static constexpr PipelineState Compact() {
+		PipelineState state;
+		state.vertexShader = "src/res/shaders/compact_vert.spv";
+		state.vertexInput = &CompactInput::DESCRIPTION;
+		return state;
+	}
+	static constexpr PipelineState SplitCompact() {
+		PipelineState state;
+		state.vertexShader = "src/res/shaders/compact_vert.spv";
+		state.vertexInput = &SplitCompactInput::DESCRIPTION;
+		return state;
+	}
+};
+
+// Hasher so states can key standard containers
+struct PipelineStateHasher {
+	size_t operator()(const PipelineState& state) const { return static_cast<size_t>(state.Hash()); }
+};
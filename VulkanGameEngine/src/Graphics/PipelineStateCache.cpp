@@ -0,0 +1,56 @@
+#include "PipelineStateCache.h"
+
+#include <mutex>
+
+// Constructor
+PipelineStateCache::PipelineStateCache(Device* device, PipelineCache* pipelineCache, RenderPass* renderPass, const BindlessTable* bindlessTable)
+: m_Device(device), m_PipelineCache(pipelineCache), m_RenderPass(renderPass), m_BindlessTable(bindlessTable) {
+
+}
+
+// Destructor
+PipelineStateCache::~PipelineStateCache(){
+	// Pipelines destroy themselves
+	Clear();
+}
+
+// Get pipeline for state, creating it on first use, safe to call from any thread
+GraphicsPipeline* PipelineStateCache::GetPipeline(const PipelineState& state){
+	// Look up existing pipeline under shared lock
+	{
+		std::shared_lock<std::shared_mutex> lock(m_Mutex);
+		auto pipelineIt = m_Pipelines.find(state);
+		if (pipelineIt != m_Pipelines.end()) {
+			return pipelineIt->second.get();
+		}
+	}
+
+	// Compile outside the lock so other lookups are not blocked
+	auto pipeline = std::make_unique<GraphicsPipeline>(m_Device, m_PipelineCache, m_RenderPass, state, m_BindlessTable);
+
+	// Insert, keeping the first pipeline if another thread raced us to it
+	std::unique_lock<std::shared_mutex> lock(m_Mutex);
+	auto inserted = m_Pipelines.emplace(state, std::move(pipeline));
+	return inserted.first->second.get();
+}
+
+// Destroy all pipelines, caller ensures none are in use
+void PipelineStateCache::Clear(){
+	std::unique_lock<std::shared_mutex> lock(m_Mutex);
+	m_Pipelines.clear();
+}
+
+// Number of cached pipelines
+size_t PipelineStateCache::GetPipelineCount() const{
+	std::shared_lock<std::shared_mutex> lock(m_Mutex);
+	return m_Pipelines.size();
+}
+
+// Switch render pass pipelines are built against, clears pipelines if it changed
+void PipelineStateCache::SetRenderPass(RenderPass* renderPass){
+	// Pipelines stay valid for the same render pass
+	if (renderPass == m_RenderPass) return;
+
+	Clear();
+	m_RenderPass = renderPass;
+}
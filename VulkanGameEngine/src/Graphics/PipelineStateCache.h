@@ -0,0 +1,39 @@
+#pragma once
+
+#include <memory>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vulkan/vulkan.h>
+
+#include "BindlessTable.h"
+#include "Device.h"
+#include "GraphicsPipeline.h"
+#include "PipelineCache.h"
+#include "PipelineState.h"
+#include "RenderPass.h"
+
+class PipelineStateCache {
+public:
+	PipelineStateCache(Device* device, PipelineCache* pipelineCache, RenderPass* renderPass, const BindlessTable* bindlessTable = nullptr);	// Constructor, pipelines share the bindless table layout if given
+	~PipelineStateCache();	// Destructor
+
+	// FUNCTIONS
+	GraphicsPipeline* GetPipeline(const PipelineState& state);	// Get pipeline for state, creating it on first use, safe to call from any thread
+	void Clear();	// Destroy all pipelines, caller ensures none are in use
+
+	// GETTERS
+	size_t GetPipelineCount() const;
+	RenderPass* GetRenderPass() { return m_RenderPass; }
+
+	// SETTERS
+	void SetRenderPass(RenderPass* renderPass);	// Switch render pass pipelines are built against, clears pipelines if it changed
+private:
+	// VARIABLES
+	Device* m_Device;					// Vulkan device
+	PipelineCache* m_PipelineCache;		// Pipeline cache shared by all pipelines
+	RenderPass* m_RenderPass;			// Render pass pipelines are compatible with
+	const BindlessTable* m_BindlessTable;	// Table forming set 0 of every pipeline, may be null
+
+	mutable std::shared_mutex m_Mutex;	// Guards pipelines, lookups share the lock
+	std::unordered_map<PipelineState, std::unique_ptr<GraphicsPipeline>, PipelineStateHasher> m_Pipelines;	// Pipelines by state, shader paths must outlive the cache
+};
@@ -3,22 +3,22 @@
 #include <stdexcept>
 
 // Constructor
-RenderPass::RenderPass(Device* device, Swapchain* swapchain)
-: m_Device(device), m_Swapchain(swapchain) {
+RenderPass::RenderPass(Device* device, RenderTarget* renderTarget)
+: m_Device(device), m_RenderTarget(renderTarget), m_Format(renderTarget->GetImageFormat()), m_FinalLayout(renderTarget->GetFinalLayout()) {
 	// Temp vectors
 	std::vector<VkAttachmentDescription> attachments;
 	std::vector<VkSubpassDescription> subpasses;
 
 	// Colour attachment description
 	VkAttachmentDescription colourAttachment = {};
-	colourAttachment.format = m_Swapchain->GetImageFormat();
+	colourAttachment.format = m_Format;
 	colourAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
 	colourAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
 	colourAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
 	colourAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
 	colourAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
 	colourAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-	colourAttachment.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+	colourAttachment.finalLayout = m_FinalLayout;
 	attachments.emplace_back(colourAttachment);
 
 	// Colour attachment reference
@@ -33,6 +33,9 @@ RenderPass::RenderPass(Device* device, Swapchain* swapchain)
 	subpass.pColorAttachments = &colourAttachmentRef;
 	subpasses.emplace_back(subpass);
 
+	// Temp dependency vector
+	std::vector<VkSubpassDependency> dependencies;
+
 	// Dependency info
 	VkSubpassDependency dependency = {};
 	dependency.srcSubpass = VK_SUBPASS_EXTERNAL;
@@ -41,6 +44,19 @@ RenderPass::RenderPass(Device* device, Swapchain* swapchain)
 	dependency.srcAccessMask = 0;
 	dependency.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
 	dependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+	dependencies.emplace_back(dependency);
+
+	// Offscreen image is copied out after the pass, make colour writes available to the transfer
+	if (m_FinalLayout == VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL) {
+		VkSubpassDependency readbackDependency = {};
+		readbackDependency.srcSubpass = 0;
+		readbackDependency.dstSubpass = VK_SUBPASS_EXTERNAL;
+		readbackDependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+		readbackDependency.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+		readbackDependency.dstStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT;
+		readbackDependency.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+		dependencies.emplace_back(readbackDependency);
+	}
 
 	// Render pass creation info
 	VkRenderPassCreateInfo renderPassInfo = {};
@@ -49,8 +65,8 @@ RenderPass::RenderPass(Device* device, Swapchain* swapchain)
 	renderPassInfo.pAttachments = attachments.data();
 	renderPassInfo.subpassCount = static_cast<uint32_t>(subpasses.size());
 	renderPassInfo.pSubpasses = subpasses.data();
-	renderPassInfo.dependencyCount = 1;
-	renderPassInfo.pDependencies = &dependency;
+	renderPassInfo.dependencyCount = static_cast<uint32_t>(dependencies.size());
+	renderPassInfo.pDependencies = dependencies.data();
 
 	// Create render pass
 	if (vkCreateRenderPass(m_Device->GetDevice(), &renderPassInfo, nullptr, &m_RenderPass) != VK_SUCCESS) {
@@ -64,22 +80,9 @@ RenderPass::~RenderPass(){
 }
 
 // Begin render pass
-void RenderPass::Begin(VkCommandBuffer commandBuffer, VkFramebuffer frameBuffer){
-	// Create viewport
-	VkViewport viewport = {};
-	viewport.x = 0.0f;
-	viewport.y = 0.0f;
-	viewport.width = (float)m_Swapchain->GetExtent().width;
-	viewport.height = (float)m_Swapchain->GetExtent().height;
-	viewport.minDepth = 0.0f;
-	viewport.maxDepth = 1.0f;
-	vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
-
-	// Create scissor
-	VkRect2D scissor = {};
-	scissor.offset = { 0, 0 };
-	scissor.extent = m_Swapchain->GetExtent();
-	vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+void RenderPass::Begin(VkCommandBuffer commandBuffer, VkFramebuffer frameBuffer, VkSubpassContents contents){
+	// Set viewport and scissor
+	SetDynamicState(commandBuffer);
 
 	// Starting a render pass
 	VkRenderPassBeginInfo renderPassInfo = {};
@@ -87,15 +90,37 @@ void RenderPass::Begin(VkCommandBuffer commandBuffer, VkFramebuffer frameBuffer)
 	renderPassInfo.renderPass = m_RenderPass;
 	renderPassInfo.framebuffer = frameBuffer;
 	renderPassInfo.renderArea.offset = { 0, 0 };
-	renderPassInfo.renderArea.extent = m_Swapchain->GetExtent();
+	renderPassInfo.renderArea.extent = m_RenderTarget->GetExtent();
 
 	// Clear value
 	renderPassInfo.clearValueCount = 1;
 	renderPassInfo.pClearValues = &m_ClearColour;
 
 	// Begin render pass
-	vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+	vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, contents);
+
+}
+
+// Set viewport, scissor and line width covering render target
+void RenderPass::SetDynamicState(VkCommandBuffer commandBuffer){
+	// Create viewport
+	VkViewport viewport = {};
+	viewport.x = 0.0f;
+	viewport.y = 0.0f;
+	viewport.width = (float)m_RenderTarget->GetExtent().width;
+	viewport.height = (float)m_RenderTarget->GetExtent().height;
+	viewport.minDepth = 0.0f;
+	viewport.maxDepth = 1.0f;
+	vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+
+	// Create scissor
+	VkRect2D scissor = {};
+	scissor.offset = { 0, 0 };
+	scissor.extent = m_RenderTarget->GetExtent();
+	vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
 
+	// Line width is dynamic in every pipeline
+	vkCmdSetLineWidth(commandBuffer, 1.0f);
 }
 
 // End render pass
@@ -1,28 +1,35 @@
 #pragma once
 
 #include "Device.h"
-#include "Swapchain.h"
+#include "RenderTarget.h"
 
 #include <vector>
 
 class RenderPass {
 public:
-	RenderPass(Device* device, Swapchain* swapchain);	// Constructor
+	RenderPass(Device* device, RenderTarget* renderTarget);	// Constructor, pass stays valid for any target of the same format and final layout
 	~RenderPass();	// Destructor
 
 	// FUNCTIONS
-	void Begin(VkCommandBuffer commandBuffer, VkFramebuffer frameBuffer);	// Begin render pass
+	void Begin(VkCommandBuffer commandBuffer, VkFramebuffer frameBuffer, VkSubpassContents contents = VK_SUBPASS_CONTENTS_INLINE);	// Begin render pass
+	void SetDynamicState(VkCommandBuffer commandBuffer);	// Set viewport, scissor and line width covering render target
 	void End(VkCommandBuffer commandBuffer);	// End render pass
 
 	// GETTERS
 	VkRenderPass GetRenderPass() { return m_RenderPass; }
-	
+	const VkFormat GetFormat() const { return m_Format; }
+	const VkImageLayout GetFinalLayout() const { return m_FinalLayout; }
+	const bool IsCompatible(RenderTarget* renderTarget) const { return renderTarget->GetImageFormat() == m_Format && renderTarget->GetFinalLayout() == m_FinalLayout; }
+
 	// SETTERS
 	void SetClearColour(VkClearValue clearColour) { m_ClearColour = clearColour; }
+	void SetRenderTarget(RenderTarget* renderTarget) { m_RenderTarget = renderTarget; }	// Retarget compatible pass, e.g. after resize
 private:
 	// VARIABLES
 	Device* m_Device;
-	Swapchain* m_Swapchain;	// Vulkan swapchain object
+	RenderTarget* m_RenderTarget;	// Target images rendered into
+	VkFormat m_Format;				// Format of colour attachment
+	VkImageLayout m_FinalLayout;	// Layout colour attachment is left in
 
 	VkRenderPass m_RenderPass = VK_NULL_HANDLE;	// Vulkan render pass
 	VkClearValue m_ClearColour = { 0.0f, 0.0f, 0.0f, 1.0f };	// Vulkan clear colour (black by def)
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <vector>
+#include <vulkan/vulkan.h>
+
+// Set of images that a render pass can draw into (swapchain or offscreen)
+class RenderTarget {
+public:
+	virtual ~RenderTarget() = default;	// Destructor
+
+	// GETTERS
+	virtual VkExtent2D GetExtent() const = 0;
+	virtual const uint32_t GetImageCount() const = 0;
+	virtual const std::vector<VkImageView> GetImageViews() const = 0;
+	virtual const VkFormat GetImageFormat() const = 0;
+	virtual const VkImageLayout GetFinalLayout() const = 0;	// Layout images are left in after rendering
+};
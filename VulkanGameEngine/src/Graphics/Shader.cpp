@@ -1,7 +1,25 @@
 #include "Shader.h"
 
+#include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+
+// SPIR-V constants needed to reflect inputs
+constexpr uint32_t SPIRV_MAGIC = 0x07230203;	// First word of every module
+constexpr uint32_t SPIRV_HEADER_WORDS = 5;		// Words before first instruction
+constexpr uint32_t OP_TYPE_INT = 21;
+constexpr uint32_t OP_TYPE_FLOAT = 22;
+constexpr uint32_t OP_TYPE_VECTOR = 23;
+constexpr uint32_t OP_TYPE_MATRIX = 24;
+constexpr uint32_t OP_TYPE_POINTER = 32;
+constexpr uint32_t OP_VARIABLE = 59;
+constexpr uint32_t OP_DECORATE = 71;
+constexpr uint32_t DECORATION_BUILT_IN = 11;
+constexpr uint32_t DECORATION_LOCATION = 30;
+constexpr uint32_t STORAGE_CLASS_INPUT = 1;
 
 // Constructor
 Shader::Shader(Device* device, VkShaderStageFlagBits shaderStage, const std::string& shaderPath)
@@ -11,6 +29,9 @@ Shader::Shader(Device* device, VkShaderStageFlagBits shaderStage, const std::str
 
 	// Create shader modules
 	m_ShaderModule = CreateShaderModule(shaderCode);
+
+	// Reflect inputs so pipelines can check their vertex layout
+	m_Inputs = ReflectInputs(shaderCode);
 }
 
 // Destructor
@@ -60,3 +81,96 @@ VkShaderModule Shader::CreateShaderModule(const std::vector<char>& code){
 	return shaderModule;
 }
 
+// Find input variables and their types in SPIR-V
+std::vector<ShaderInput> Shader::ReflectInputs(const std::vector<char>& code){
+	// Copy into words, code is not guaranteed to be aligned
+	std::vector<uint32_t> words(code.size() / sizeof(uint32_t));
+	std::memcpy(words.data(), code.data(), words.size() * sizeof(uint32_t));
+
+	// Throw error if not SPIR-V
+	if (words.size() < SPIRV_HEADER_WORDS || words[0] != SPIRV_MAGIC) {
+		throw std::runtime_error("Unable to reflect shader, code is not SPIR-V!");
+	}
+
+	// Numeric types by id, locations and built-ins by variable id
+	std::unordered_map<uint32_t, ShaderInput> types;
+	std::unordered_map<uint32_t, uint32_t> pointers;
+	std::unordered_map<uint32_t, uint32_t> locations;
+	std::unordered_set<uint32_t> builtIns;
+	std::vector<std::pair<uint32_t, uint32_t>> variables;
+
+	// Walk instructions, low half of first word is opcode and high half word count
+	for (size_t i = SPIRV_HEADER_WORDS; i < words.size();) {
+		auto opcode = words[i] & 0xffff;
+		auto length = words[i] >> 16;
+		if (length == 0 || i + length > words.size()) {
+			throw std::runtime_error("Unable to reflect shader, instruction exceeds code!");
+		}
+		auto operands = &words[i + 1];
+
+		switch (opcode) {
+		case OP_DECORATE:
+			if (length >= 4 && operands[1] == DECORATION_LOCATION) {
+				locations[operands[0]] = operands[2];
+			}
+			else if (operands[1] == DECORATION_BUILT_IN) {
+				builtIns.insert(operands[0]);
+			}
+			break;
+		case OP_TYPE_INT:
+			types[operands[0]] = { 0, 1, operands[2] ? VertexComponentType::Int : VertexComponentType::Uint, 1 };
+			break;
+		case OP_TYPE_FLOAT:
+			types[operands[0]] = { 0, 1, VertexComponentType::Float, 1 };
+			break;
+		case OP_TYPE_VECTOR: {
+			// Vector of scalars, one location
+			auto component = types.find(operands[1]);
+			if (component != types.end()) {
+				types[operands[0]] = { 0, 1, component->second.type, operands[2] };
+			}
+			break;
+		}
+		case OP_TYPE_MATRIX: {
+			// Matrix of column vectors, one location per column
+			auto column = types.find(operands[1]);
+			if (column != types.end()) {
+				types[operands[0]] = { 0, operands[2], column->second.type, column->second.componentCount };
+			}
+			break;
+		}
+		case OP_TYPE_POINTER:
+			if (operands[1] == STORAGE_CLASS_INPUT) {
+				pointers[operands[0]] = operands[2];
+			}
+			break;
+		case OP_VARIABLE:
+			if (operands[2] == STORAGE_CLASS_INPUT) {
+				variables.emplace_back(operands[1], operands[0]);
+			}
+			break;
+		}
+		i += length;
+	}
+
+	// Resolve located input variables to their types, blocks and arrays are not vertex inputs
+	std::vector<ShaderInput> inputs;
+	for (auto& [variable, pointer] : variables) {
+		auto location = locations.find(variable);
+		if (builtIns.count(variable) || location == locations.end() || !pointers.count(pointer)) {
+			continue;
+		}
+		auto type = types.find(pointers[pointer]);
+		if (type == types.end()) {
+			continue;
+		}
+
+		auto input = type->second;
+		input.location = location->second;
+		inputs.emplace_back(input);
+	}
+
+	// Sort by location
+	std::sort(inputs.begin(), inputs.end(), [](const ShaderInput& a, const ShaderInput& b) { return a.location < b.location; });
+	return inputs;
+}
@@ -5,6 +5,15 @@
 #include <vulkan/vulkan.h>
 
 #include "Device.h"
+#include "VertexLayout.h"
+
+// Input variable of a shader stage, reflected from SPIR-V
+struct ShaderInput {
+	uint32_t location;				// First location
+	uint32_t locationCount;			// Consecutive locations, one per matrix column
+	VertexComponentType type;		// Numeric type of components
+	uint32_t componentCount;		// Components per location
+};
 
 class Shader {
 public:
@@ -14,14 +23,17 @@ public:
 	// GETTERS
 	VkShaderModule GetShaderModule() { return m_ShaderModule; }
 	VkShaderStageFlagBits GetShaderStage() { return m_ShaderStage; }
+	const std::vector<ShaderInput>& GetInputs() const { return m_Inputs; }
 private:
 	// VARIABLES
 	Device* m_Device;
 
 	VkShaderModule m_ShaderModule;
 	VkShaderStageFlagBits m_ShaderStage;
+	std::vector<ShaderInput> m_Inputs;	// Input variables sorted by location, built-ins excluded
 
 	// FUNCTIONS
 	static std::vector<char> ReadFile(const std::string& path);	// Read shader code into bytes
 	VkShaderModule CreateShaderModule(const std::vector<char>& code);	// Create shader module from code
+	static std::vector<ShaderInput> ReflectInputs(const std::vector<char>& code);	// Find input variables and their types in SPIR-V
 };
\ No newline at end of file
@@ -0,0 +1,427 @@
+#include "StreamingManager.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <stdexcept>
+
+#include "Graphics.h"
+#include "../Core/Profiler.h"
+
+// Constructor
+StreamingManager::StreamingManager(Graphics* graphics, VkDeviceSize budget)
+: m_Graphics(graphics), m_Budget(budget), m_IoThreads(std::make_unique<ThreadPool>(IO_THREAD_COUNT)) {
+}
+
+// Destructor
+StreamingManager::~StreamingManager(){
+	// Finish reads in flight, they hold pointers into this manager
+	m_IoThreads.reset();
+
+	// Delete handles removed while loading, their reads are all finished now
+	for (auto& request : m_Finished) {
+		m_Ready.push_back(std::move(request));
+	}
+	for (auto& request : m_Ready) {
+		if (request->texture && request->texture->removed) {
+			delete(request->texture);
+		}
+		if (request->mesh && request->mesh->removed) {
+			delete(request->mesh);
+		}
+	}
+
+	// Delete handles, their textures and meshes are owned by graphics
+	for (auto& texture : m_Textures) {
+		delete(texture);
+	}
+	for (auto& mesh : m_Meshes) {
+		delete(mesh);
+	}
+}
+
+// Upload finished reads, reprioritize and queue new reads and evictions, never blocks on I/O
+void StreamingManager::Update(){
+	PROFILE_SCOPE("StreamingManager::Update");
+	ApplyLoads();
+	UpdatePriorities();
+	QueueLoads();
+}
+
+// Queue cooked texture, its smallest levels are read first
+StreamedTexture* StreamingManager::StreamTexture(const std::string& path, const MeshBounds& bounds){
+	// Create handle, the first read opens the file and picks its floor level
+	auto texture = new StreamedTexture();
+	texture->path = path;
+	texture->bounds = bounds;
+	m_Textures.emplace_back(texture);
+	return texture;
+}
+
+// Stop streaming texture and remove its resident levels
+void StreamingManager::RemoveTexture(StreamedTexture* texture){
+	// Find texture
+	auto it = std::find(m_Textures.begin(), m_Textures.end(), texture);
+	if (it == m_Textures.end()) {
+		throw std::runtime_error("Unable to remove texture not streamed!");
+	}
+
+	// Swap with last and pop, order does not matter
+	*it = m_Textures.back();
+	m_Textures.pop_back();
+
+	// Remove resident levels, frames in flight may still sample them
+	if (texture->texture) {
+		m_Graphics->RemoveTexture(texture->texture);
+		texture->texture = nullptr;
+	}
+
+	// A read in flight still uses the handle, it is deleted once finished
+	if (texture->loading) {
+		texture->removed = true;
+		return;
+	}
+	delete(texture);
+}
+
+// Queue cooked mesh, added to the draw list once read
+StreamedMesh* StreamingManager::StreamMesh(const std::string& path, const MeshBounds& bounds){
+	// Create handle, read is queued by priority on the next update
+	auto mesh = new StreamedMesh();
+	mesh->path = path;
+	mesh->bounds = bounds;
+	m_Meshes.emplace_back(mesh);
+	return mesh;
+}
+
+// Stop streaming mesh and remove it from the draw list
+void StreamingManager::RemoveMesh(StreamedMesh* mesh){
+	// Find mesh
+	auto it = std::find(m_Meshes.begin(), m_Meshes.end(), mesh);
+	if (it == m_Meshes.end()) {
+		throw std::runtime_error("Unable to remove mesh not streamed!");
+	}
+
+	// Swap with last and pop, order does not matter
+	*it = m_Meshes.back();
+	m_Meshes.pop_back();
+
+	// Remove from draw list, frames in flight may still draw it
+	if (mesh->mesh) {
+		m_Graphics->RemoveMesh(mesh->mesh);
+		mesh->mesh = nullptr;
+	}
+
+	// A read in flight still uses the handle, it is deleted once finished
+	if (mesh->loading) {
+		mesh->removed = true;
+		return;
+	}
+	delete(mesh);
+}
+
+// Streaming usage statistics
+StreamingStats StreamingManager::GetStats() const {
+	StreamingStats stats;
+	stats.budget = m_Budget;
+	for (auto& texture : m_Textures) {
+		stats.residentBytes += texture->texture ? texture->texture->GetSize() : 0;
+	}
+	for (auto& mesh : m_Meshes) {
+		stats.residentBytes += mesh->mesh ? mesh->size : 0;
+	}
+	stats.pendingLoads = m_PendingLoads;
+	stats.loads = m_Loads;
+	stats.evictions = m_Evictions;
+	stats.failures = m_Failures;
+	return stats;
+}
+
+// Create textures and meshes of finished reads within the upload limit
+void StreamingManager::ApplyLoads(){
+	// Take reads finished by I/O threads
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		for (auto& request : m_Finished) {
+			m_Ready.push_back(std::move(request));
+		}
+		m_Finished.clear();
+	}
+
+	// Upload in order finished, the rest waits for the next update so staging never stalls a frame
+	VkDeviceSize uploaded = 0;
+	while (!m_Ready.empty() && (uploaded == 0 || uploaded < MAX_UPLOAD_BYTES_PER_UPDATE)) {
+		auto request = std::move(m_Ready.front());
+		m_Ready.pop_front();
+		m_PendingLoads--;
+
+		// Texture levels replace the resident texture in its bindless slot, the old one is retired once frames in flight finish, a failed read keeps what is resident
+		if (auto texture = request->texture) {
+			texture->loading = false;
+			if (texture->removed) {
+				delete(texture);
+				continue;
+			}
+			if (!request->error.empty()) {
+				texture->failed = true;
+				texture->error = request->error;
+				m_Failures++;
+				continue;
+			}
+			if (request->textureFile) {
+				texture->file = std::move(request->textureFile);
+				texture->floorLevel = request->firstLevel;
+			}
+			auto created = texture->texture ? m_Graphics->ReplaceTexture(texture->texture, *texture->file, request->firstLevel) : m_Graphics->AddTexture(*texture->file, request->firstLevel);
+			texture->texture = created;
+			texture->bindlessIndex = created->GetBindlessIndex();
+			texture->residentLevel = request->firstLevel;
+			uploaded += created->GetSize();
+		}
+
+		// Meshes join the draw list, their file is closed once copied into staging, a failed read leaves them unloaded
+		if (auto mesh = request->mesh) {
+			mesh->loading = false;
+			if (mesh->removed) {
+				delete(mesh);
+				continue;
+			}
+			if (!request->error.empty()) {
+				mesh->failed = true;
+				mesh->error = request->error;
+				m_Failures++;
+				continue;
+			}
+			mesh->mesh = m_Graphics->AddMesh(*request->meshFile);
+			mesh->size = request->meshFile->GetSize();
+			uploaded += mesh->size;
+		}
+		m_Loads++;
+	}
+}
+
+// Project bounds of every resource and pick wanted texture levels
+void StreamingManager::UpdatePriorities(){
+	// Textures want the level whose texels are about one pixel on screen
+	for (auto& texture : m_Textures) {
+		texture->priority = ProjectSize(texture->bounds);
+		texture->wantedLevel = 0;
+		if (!texture->file || !m_Graphics->GetLodSelector()->HasCamera()) {
+			continue;
+		}
+		auto extent = texture->file->GetExtent();
+		auto texels = static_cast<float>(std::max(extent.width, extent.height));
+		auto level = std::floor(std::log2(texels / std::max(texture->priority, 1.0f)));
+		texture->wantedLevel = static_cast<uint32_t>(std::clamp(level, 0.0f, static_cast<float>(texture->floorLevel)));
+	}
+
+	// Meshes load in order of size on screen
+	for (auto& mesh : m_Meshes) {
+		mesh->priority = ProjectSize(mesh->bounds);
+	}
+}
+
+// Queue reads by priority, dropping detail of lower priority textures while over budget
+void StreamingManager::QueueLoads(){
+	auto committed = GetCommittedSize();
+
+	// Textures detail can be dropped from, unneeded detail first, then lowest priority, failed files are not read again
+	std::vector<StreamedTexture*> victims;
+	for (auto& texture : m_Textures) {
+		if (texture->texture && !texture->loading && !texture->failed && texture->residentLevel < texture->floorLevel) {
+			victims.push_back(texture);
+		}
+	}
+	std::sort(victims.begin(), victims.end(), [](const StreamedTexture* a, const StreamedTexture* b) {
+		bool aUnneeded = a->residentLevel < a->wantedLevel;
+		bool bUnneeded = b->residentLevel < b->wantedLevel;
+		return aUnneeded != bUnneeded ? aUnneeded : a->priority < b->priority;
+	});
+	size_t nextVictim = 0;
+
+	// Drop detail of the next victim below priority, returns false if none is left
+	auto evict = [&](float priority) {
+		while (nextVictim < victims.size() && m_PendingLoads < MAX_PENDING_LOADS) {
+			auto victim = victims[nextVictim++];
+			bool unneeded = victim->residentLevel < victim->wantedLevel;
+			if (victim->loading || (!unneeded && victim->priority >= priority)) {
+				continue;
+			}
+			auto level = unneeded ? victim->wantedLevel : victim->residentLevel + 1;
+			committed -= GetLevelsSize(victim, victim->residentLevel) - GetLevelsSize(victim, level);
+			QueueTextureLoad(victim, level);
+			m_Evictions++;
+			return true;
+		}
+		return false;
+	};
+
+	// Get back under budget first, a lowered budget drops detail of any texture
+	while (committed > m_Budget && evict(FLT_MAX)) {
+	}
+
+	// Resources wanting reads, first reads of textures go first as their floor levels are small placeholders, failed resources are skipped
+	struct Candidate {
+		StreamedTexture* texture;	// Texture wanting more detail or its first read
+		StreamedMesh* mesh;			// Mesh wanting its read
+		float priority;				// Projected size
+		bool first;					// True for first reads
+	};
+	std::vector<Candidate> candidates;
+	for (auto& texture : m_Textures) {
+		if (!texture->loading && !texture->failed && (!texture->texture || texture->wantedLevel < texture->residentLevel)) {
+			candidates.push_back({ texture, nullptr, texture->priority, !texture->texture });
+		}
+	}
+	for (auto& mesh : m_Meshes) {
+		if (!mesh->loading && !mesh->failed && !mesh->mesh) {
+			candidates.push_back({ nullptr, mesh, mesh->priority, true });
+		}
+	}
+	std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+		return a.first != b.first ? a.first : a.priority > b.priority;
+	});
+
+	// Queue reads until too many are in flight or the budget has no room left
+	for (auto& candidate : candidates) {
+		if (m_PendingLoads >= MAX_PENDING_LOADS) {
+			break;
+		}
+
+		// First reads are not budgeted, their size is only known once the file is open
+		if (candidate.mesh) {
+			QueueMeshLoad(candidate.mesh);
+			continue;
+		}
+		auto texture = candidate.texture;
+		if (texture->loading) {
+			continue;
+		}
+		if (!texture->texture) {
+			QueueTextureLoad(texture, 0);
+			continue;
+		}
+
+		// Make room by dropping detail of lower priority textures
+		auto residentSize = GetLevelsSize(texture, texture->residentLevel);
+		while (committed + GetLevelsSize(texture, texture->wantedLevel) - residentSize > m_Budget && evict(texture->priority)) {
+		}
+
+		// Read most detailed wanted level that fits, later candidates are not allowed to overtake a starved one
+		auto level = texture->wantedLevel;
+		while (level < texture->residentLevel && committed + GetLevelsSize(texture, level) - residentSize > m_Budget) {
+			level++;
+		}
+		if (level == texture->residentLevel) {
+			break;
+		}
+		committed += GetLevelsSize(texture, level) - residentSize;
+		QueueTextureLoad(texture, level);
+	}
+}
+
+// Read texture levels from first level down on an I/O thread
+void StreamingManager::QueueTextureLoad(StreamedTexture* texture, uint32_t firstLevel){
+	texture->loading = true;
+	texture->loadingLevel = firstLevel;
+	m_PendingLoads++;
+
+	// Request for the read, the first read opens the file and reads its floor level instead
+	auto request = new LoadRequest();
+	request->texture = texture;
+	request->path = texture->path;
+	request->firstLevel = firstLevel;
+	auto file = texture->file.get();
+
+	// Read on an I/O thread, failures are recorded on the handle by the update applying the read
+	m_IoThreads->Enqueue([this, request, file]() {
+		PROFILE_SCOPE("StreamTexture");
+		try {
+			auto readFile = file;
+			if (!readFile) {
+				request->textureFile = std::make_unique<TextureFile>(request->path);
+				readFile = request->textureFile.get();
+				request->firstLevel = GetFloorLevel(*readFile);
+			}
+			readFile->Prefetch(request->firstLevel);
+		}
+		catch (const std::exception& exception) {
+			request->error = exception.what();
+		}
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Finished.emplace_back(request);
+	});
+}
+
+// Read mesh on an I/O thread
+void StreamingManager::QueueMeshLoad(StreamedMesh* mesh){
+	mesh->loading = true;
+	m_PendingLoads++;
+
+	// Request for the read
+	auto request = new LoadRequest();
+	request->mesh = mesh;
+	request->path = mesh->path;
+
+	// Read on an I/O thread, failures are recorded on the handle by the update applying the read
+	m_IoThreads->Enqueue([this, request]() {
+		PROFILE_SCOPE("StreamMesh");
+		try {
+			request->meshFile = std::make_unique<MeshFile>(request->path);
+			request->meshFile->Prefetch();
+		}
+		catch (const std::exception& exception) {
+			request->error = exception.what();
+		}
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Finished.emplace_back(request);
+	});
+}
+
+// Resident bytes once queued reads and evictions finished
+VkDeviceSize StreamingManager::GetCommittedSize() const {
+	VkDeviceSize committed = 0;
+	for (auto& texture : m_Textures) {
+		if (texture->loading && texture->file) {
+			committed += GetLevelsSize(texture, texture->loadingLevel);
+		}
+		else if (texture->texture) {
+			committed += texture->texture->GetSize();
+		}
+	}
+	for (auto& mesh : m_Meshes) {
+		committed += mesh->mesh ? mesh->size : 0;
+	}
+	return committed;
+}
+
+// Bytes of texture levels from first level down
+VkDeviceSize StreamingManager::GetLevelsSize(const StreamedTexture* texture, uint32_t firstLevel){
+	VkDeviceSize size = 0;
+	for (auto level = firstLevel; level < texture->file->GetLevelCount(); level++) {
+		size += Image::GetLevelSize(texture->file->GetFormat(), texture->file->GetExtent(), level);
+	}
+	return size;
+}
+
+// Most detailed level no larger than MIN_RESIDENT_EXTENT, or the last level
+uint32_t StreamingManager::GetFloorLevel(const TextureFile& file){
+	auto level = 0u;
+	while (level + 1 < file.GetLevelCount()) {
+		auto extent = Image::GetMipExtent(file.GetExtent(), level);
+		if (std::max(extent.width, extent.height) <= MIN_RESIDENT_EXTENT) {
+			break;
+		}
+		level++;
+	}
+	return level;
+}
+
+// Pixels bounding sphere diameter covers, zero without a camera
+float StreamingManager::ProjectSize(const MeshBounds& bounds) const {
+	auto lodSelector = m_Graphics->GetLodSelector();
+	if (!lodSelector->HasCamera()) {
+		return 0.0f;
+	}
+	return lodSelector->ProjectError(bounds.radius * 2.0f, bounds, glm::mat4(1.0f));
+}
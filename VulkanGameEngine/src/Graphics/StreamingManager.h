@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+#include "Mesh.h"
+#include "Texture.h"
+#include "../Assets/MeshFile.h"
+#include "../Assets/TextureFile.h"
+#include "../Core/ThreadPool.h"
+
+class Graphics;
+
+// Cooked texture whose most detailed levels are read in when on screen and dropped under memory pressure
+struct StreamedTexture {
+	std::string path;						// Cooked KTX2 file
+	MeshBounds bounds;						// World space bounds of what samples the texture, callers may move them
+	Texture* texture = nullptr;				// Resident levels, null until first read finished, replaced whenever residency changes
+	uint32_t bindlessIndex = 0;				// Bindless slot shaders sample resident levels through, 0 samples white until first read finished, then stays the same
+	std::unique_ptr<TextureFile> file;		// Mapped file, kept open so dropped levels can be read again
+	uint32_t residentLevel = 0;				// Most detailed resident level, meaningless while texture is null
+	uint32_t loadingLevel = 0;				// Most detailed level of read in flight
+	uint32_t wantedLevel = 0;				// Most detailed level its projected size asks for
+	uint32_t floorLevel = 0;				// Least detail ever resident, levels up to MIN_RESIDENT_EXTENT texels
+	float priority = 0.0f;					// Projected diameter in pixels, larger reads first
+	bool loading = false;					// True while a read is in flight
+	bool removed = false;					// True if removed while loading, deleted once its read finished
+	bool failed = false;					// True if a read failed, resident levels are kept but never read again
+	std::string error;						// Failure reason of the failed read
+};
+
+// Cooked mesh read in order of projected size, drawn once loaded
+struct StreamedMesh {
+	std::string path;						// Cooked mesh file
+	MeshBounds bounds;						// World space bounds mesh is drawn at, callers may move them
+	Mesh* mesh = nullptr;					// Mesh in draw list, null until read finished
+	VkDeviceSize size = 0;					// Bytes of file once loaded
+	float priority = 0.0f;					// Projected diameter in pixels, larger reads first
+	bool loading = false;					// True while a read is in flight
+	bool removed = false;					// True if removed while loading, deleted once its read finished
+	bool failed = false;					// True if its read failed, stays unloaded and is never read again
+	std::string error;						// Failure reason of the failed read
+};
+
+// Streaming usage statistics
+struct StreamingStats {
+	VkDeviceSize budget = 0;			// Bytes resident resources may use
+	VkDeviceSize residentBytes = 0;		// Bytes of resident texture levels and meshes
+	uint32_t pendingLoads = 0;			// Reads in flight or waiting for upload
+	uint64_t loads = 0;					// Reads finished since creation
+	uint64_t evictions = 0;				// Times texture detail was dropped to make room
+	uint64_t failures = 0;				// Reads failed since creation
+};
+
+// Reads cooked textures and meshes on background I/O threads, ordered by projected size, and keeps texture residency within a video memory budget
+class StreamingManager {
+public:
+	StreamingManager(Graphics* graphics, VkDeviceSize budget = DEFAULT_BUDGET);	// Constructor, priorities use the camera of the graphics level of detail selector
+	~StreamingManager();	// Destructor
+
+	static constexpr VkDeviceSize DEFAULT_BUDGET = 256 * 1024 * 1024;		// Bytes resident resources may use
+	static constexpr VkDeviceSize MAX_UPLOAD_BYTES_PER_UPDATE = 8 * 1024 * 1024;	// Bytes finished reads may upload per update, at least one read is always uploaded
+	static constexpr uint32_t MAX_PENDING_LOADS = 8;		// Reads in flight at once
+	static constexpr uint32_t IO_THREAD_COUNT = 2;			// Threads reading files, separate from the graphics pool so frame recording never waits on disk
+	static constexpr uint32_t MIN_RESIDENT_EXTENT = 64;		// Largest side of the least detailed level kept, read first as a placeholder
+
+	// FUNCTIONS
+	void Update();	// Upload finished reads, reprioritize and queue new reads and evictions, never blocks on I/O
+	StreamedTexture* StreamTexture(const std::string& path, const MeshBounds& bounds = {});	// Queue cooked texture, its smallest levels are read first
+	void RemoveTexture(StreamedTexture* texture);	// Stop streaming texture and remove its resident levels
+	StreamedMesh* StreamMesh(const std::string& path, const MeshBounds& bounds = {});	// Queue cooked mesh, added to the draw list once read
+	void RemoveMesh(StreamedMesh* mesh);	// Stop streaming mesh and remove it from the draw list
+
+	// GETTERS
+	StreamingStats GetStats() const;
+	const VkDeviceSize GetBudget() const { return m_Budget; }
+
+	// SETTERS
+	void SetBudget(VkDeviceSize budget) { m_Budget = budget; }	// Detail above budget is dropped by following updates
+private:
+	// Read of a resource on an I/O thread
+	struct LoadRequest {
+		StreamedTexture* texture = nullptr;			// Texture read, null for meshes
+		StreamedMesh* mesh = nullptr;				// Mesh read, null for textures
+		std::string path;							// File read
+		uint32_t firstLevel = 0;					// Most detailed texture level read
+		std::unique_ptr<TextureFile> textureFile;	// Texture file opened by the read if the texture had none
+		std::unique_ptr<MeshFile> meshFile;			// Mesh file opened by the read
+		std::string error;							// Failure reason, empty on success
+	};
+
+	// VARIABLES
+	Graphics* m_Graphics;					// Graphics owning created textures and meshes
+	VkDeviceSize m_Budget;					// Bytes resident resources may use
+
+	std::vector<StreamedTexture*> m_Textures = {};	// Streamed textures
+	std::vector<StreamedMesh*> m_Meshes = {};		// Streamed meshes
+	uint32_t m_PendingLoads = 0;					// Reads queued and not yet uploaded
+	uint64_t m_Loads = 0;							// Reads uploaded since creation
+	uint64_t m_Evictions = 0;						// Evictions queued since creation
+	uint64_t m_Failures = 0;						// Reads failed since creation
+
+	std::mutex m_Mutex;										// Guards finished reads
+	std::vector<std::unique_ptr<LoadRequest>> m_Finished;	// Reads finished by I/O threads
+	std::deque<std::unique_ptr<LoadRequest>> m_Ready;		// Finished reads waiting for upload, owned by the updating thread
+	std::unique_ptr<ThreadPool> m_IoThreads;				// Threads reading files
+
+	// FUNCTIONS
+	void ApplyLoads();	// Create textures and meshes of finished reads within the upload limit
+	void UpdatePriorities();	// Project bounds of every resource and pick wanted texture levels
+	void QueueLoads();	// Queue reads by priority, dropping detail of lower priority textures while over budget
+	void QueueTextureLoad(StreamedTexture* texture, uint32_t firstLevel);	// Read texture levels from first level down on an I/O thread
+	void QueueMeshLoad(StreamedMesh* mesh);	// Read mesh on an I/O thread
+	VkDeviceSize GetCommittedSize() const;	// Resident bytes once queued reads and evictions finished
+	static VkDeviceSize GetLevelsSize(const StreamedTexture* texture, uint32_t firstLevel);	// Bytes of texture levels from first level down
+	static uint32_t GetFloorLevel(const TextureFile& file);	// Most detailed level no larger than MIN_RESIDENT_EXTENT, or the last level
+	float ProjectSize(const MeshBounds& bounds) const;	// Pixels bounding sphere diameter covers, zero without a camera
+};
@@ -71,6 +71,7 @@ Swapchain::Swapchain(Device* device, PhysicalDevice* physicalDevice, Surface* su
 	createInfo.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
 	createInfo.presentMode = m_PresentMode;
 	createInfo.clipped = VK_TRUE;
+	createInfo.oldSwapchain = oldSwapchain;
 
 	// Create swapchain
 	auto result = vkCreateSwapchainKHR(m_Device->GetDevice(), &createInfo, nullptr, &m_Swapchain);
@@ -5,6 +5,7 @@
 
 #include "Device.h"
 #include "PhysicalDevice.h"
+#include "RenderTarget.h"
 #include "Surface.h"
 
 // Struct for swap chain support details
@@ -14,7 +15,7 @@ struct SwapchainSupportDetails {
 	std::vector<VkPresentModeKHR> presentModes;
 };
 
-class Swapchain {
+class Swapchain : public RenderTarget {
 public:
 	Swapchain(Device* device, PhysicalDevice* physicalDevice, Surface* surface, Window* window, VkSwapchainKHR oldSwapchain = VK_NULL_HANDLE);	// Constructor
 	~Swapchain();	// Destructor
@@ -24,12 +25,13 @@ public:
 	VkResult QueuePresent(const VkQueue& presentQueue, const VkSemaphore& waitSemaphore);	// Present swapchain image to queue
 
 	// GETTERS
-	VkExtent2D GetExtent() { return m_Extent; }
+	VkExtent2D GetExtent() const override { return m_Extent; }
 	VkPresentModeKHR GetPresentMode() { return m_PresentMode; }
-	const uint32_t GetImageCount() const { return m_ImageCount; }
+	const uint32_t GetImageCount() const override { return m_ImageCount; }
 	const uint32_t GetActiveImageIndex() const { return m_ActiveImageIndex; }
-	const std::vector<VkImageView> GetImageViews() const { return m_ImageViews; }
-	const VkFormat GetImageFormat() const { return m_ImageFormat; }
+	const std::vector<VkImageView> GetImageViews() const override { return m_ImageViews; }
+	const VkFormat GetImageFormat() const override { return m_ImageFormat; }
+	const VkImageLayout GetFinalLayout() const override { return VK_IMAGE_LAYOUT_PRESENT_SRC_KHR; }
 	const VkSwapchainKHR GetSwapchain() const { return m_Swapchain; }
 private:
 	// VARIABLES
@@ -0,0 +1,122 @@
+#include "Texture.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#include "../Core/Profiler.h"
+
+// Constructor
+Texture::Texture(Device* device, PhysicalDevice* physicalDevice, MemoryAllocator* allocator, UploadManager* uploadManager, const TextureData& data)
+: m_Device(device) {
+	PROFILE_SCOPE("Texture");
+
+	// Throw error if there is nothing to upload
+	VkExtent2D extent = { data.width, data.height };
+	if (data.levels.empty() || extent.width == 0 || extent.height == 0) {
+		throw std::runtime_error("Unable to create texture without texels!");
+	}
+	CheckFormat(physicalDevice, data.format);
+
+	// Create device local image for the full mip chain, blit source usage is needed for GPU mip generation
+	auto mipLevels = Image::GetMipLevelCount(extent);
+	m_Image = std::make_unique<Image>(m_Device, allocator, extent, data.format, VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, mipLevels);
+
+	// Upload given levels, the GPU blits the rest if it can filter the format
+	std::vector<const void*> levels;
+	if (data.levels.size() >= mipLevels || CanBlit(physicalDevice, data.format)) {
+		for (uint32_t level = 0; level < std::min<size_t>(data.levels.size(), mipLevels); level++) {
+			levels.emplace_back(data.levels[level].data());
+		}
+		m_GpuMips = levels.size() < mipLevels;
+		uploadManager->UploadImage(m_Image.get(), levels);
+	}
+	else {
+		// Box filter on the CPU and upload every level
+		auto mipmapped = data;
+		TextureLoader::GenerateMips(mipmapped);
+		for (auto& level : mipmapped.levels) {
+			levels.emplace_back(level.data());
+		}
+		uploadManager->UploadImage(m_Image.get(), levels);
+	}
+
+	// Count bytes of full mip chain
+	for (uint32_t level = 0; level < mipLevels; level++) {
+		m_Size += Image::GetLevelSize(data.format, extent, level);
+	}
+
+	// Create sampler
+	CreateSampler(physicalDevice);
+}
+
+// Constructor
+Texture::Texture(Device* device, PhysicalDevice* physicalDevice, MemoryAllocator* allocator, UploadManager* uploadManager, const TextureFile& file, uint32_t firstLevel)
+: m_Device(device) {
+	PROFILE_SCOPE("Texture");
+
+	// Throw error if the device cannot sample the cooked format, there is no runtime transcoding
+	CheckFormat(physicalDevice, file.GetFormat());
+	if (firstLevel >= file.GetLevelCount()) {
+		throw std::runtime_error("Unable to create texture, first level is not stored in file!");
+	}
+
+	// Create device local image holding stored levels from first level down only, block compressed levels cannot be blitted
+	std::vector<const void*> levels(file.GetLevels().begin() + firstLevel, file.GetLevels().end());
+	auto extent = Image::GetMipExtent(file.GetExtent(), firstLevel);
+	m_Image = std::make_unique<Image>(m_Device, allocator, extent, file.GetFormat(), VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, static_cast<uint32_t>(levels.size()));
+
+	// Copy levels straight from mapping into staging
+	uploadManager->UploadImage(m_Image.get(), levels);
+	for (uint32_t level = 0; level < levels.size(); level++) {
+		m_Size += Image::GetLevelSize(file.GetFormat(), extent, level);
+	}
+
+	// Create sampler
+	CreateSampler(physicalDevice);
+}
+
+// Destructor
+Texture::~Texture(){
+	// Destroy sampler, image is released with its unique pointer
+	vkDestroySampler(m_Device->GetDevice(), m_Sampler, nullptr);
+}
+
+// Create trilinear repeating sampler over every level
+void Texture::CreateSampler(PhysicalDevice* physicalDevice){
+	// Sampler creation info
+	VkSamplerCreateInfo samplerInfo = {};
+	samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+	samplerInfo.magFilter = VK_FILTER_LINEAR;
+	samplerInfo.minFilter = VK_FILTER_LINEAR;
+	samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
+	samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+	samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+	samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+	samplerInfo.minLod = 0.0f;
+	samplerInfo.maxLod = static_cast<float>(m_Image->GetMipLevels());
+	samplerInfo.borderColor = VK_BORDER_COLOR_INT_OPAQUE_BLACK;
+
+	// Anisotropic filtering is enabled by the device when supported
+	if (m_Device->GetEnabledFeatures().samplerAnisotropy) {
+		samplerInfo.anisotropyEnable = VK_TRUE;
+		samplerInfo.maxAnisotropy = std::min(MAX_ANISOTROPY, physicalDevice->GetProperties().limits.maxSamplerAnisotropy);
+	}
+
+	// Create sampler
+	if (vkCreateSampler(m_Device->GetDevice(), &samplerInfo, nullptr, &m_Sampler) != VK_SUCCESS) {
+		throw std::runtime_error("Unable to create texture sampler!");
+	}
+}
+
+// Throw error if format cannot be sampled with linear filtering
+void Texture::CheckFormat(PhysicalDevice* physicalDevice, VkFormat format){
+	if (!physicalDevice->SupportsFormat(format, VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT | VK_FORMAT_FEATURE_TRANSFER_DST_BIT)) {
+		throw std::runtime_error("Unable to create texture, format " + std::to_string(format) + " cannot be sampled by the device!");
+	}
+}
+
+// Format can be blitted with linear filtering in optimal tiling
+bool Texture::CanBlit(PhysicalDevice* physicalDevice, VkFormat format){
+	return physicalDevice->SupportsFormat(format, VK_FORMAT_FEATURE_BLIT_SRC_BIT | VK_FORMAT_FEATURE_BLIT_DST_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT);
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <memory>
+#include <vulkan/vulkan.h>
+
+#include "Device.h"
+#include "Image.h"
+#include "MemoryAllocator.h"
+#include "PhysicalDevice.h"
+#include "UploadManager.h"
+#include "../Assets/TextureFile.h"
+#include "../Assets/TextureLoader.h"
+
+class Texture {
+public:
+	Texture(Device* device, PhysicalDevice* physicalDevice, MemoryAllocator* allocator, UploadManager* uploadManager, const TextureData& data);	// Constructor, missing mip levels are generated on the GPU, or on the CPU if the format cannot be blitted
+	Texture(Device* device, PhysicalDevice* physicalDevice, MemoryAllocator* allocator, UploadManager* uploadManager, const TextureFile& file, uint32_t firstLevel = 0);	// Constructor, cooked levels from first level down are copied from the mapping as they are, the image holds only those levels
+	~Texture();	// Destructor
+
+	static constexpr float MAX_ANISOTROPY = 8.0f;	// Anisotropic filtering limit, used if the device enables it
+
+	// GETTERS
+	Image* GetImage() const { return m_Image.get(); }
+	const VkImageView GetImageView() const { return m_Image->GetImageView(); }
+	const VkSampler GetSampler() const { return m_Sampler; }
+	const uint32_t GetMipLevels() const { return m_Image->GetMipLevels(); }
+	const bool GetGpuMips() const { return m_GpuMips; }
+	const VkDeviceSize GetSize() const { return m_Size; }
+	const uint32_t GetBindlessIndex() const { return m_BindlessIndex; }
+
+	// SETTERS
+	void SetBindlessIndex(uint32_t bindlessIndex) { m_BindlessIndex = bindlessIndex; }
+private:
+	// VARIABLES
+	Device* m_Device;					// Vulkan device
+
+	std::unique_ptr<Image> m_Image;		// Device local optimal tiling image with its mip chain
+	VkSampler m_Sampler = VK_NULL_HANDLE;	// Trilinear sampler covering every level
+	bool m_GpuMips = false;				// True if mip levels were blitted on the GPU
+	VkDeviceSize m_Size = 0;			// Bytes of tightly packed levels, the share of video memory streaming budgets count
+	uint32_t m_BindlessIndex = 0;		// Slot in the graphics bindless table, 0 samples white until added
+
+	// FUNCTIONS
+	void CreateSampler(PhysicalDevice* physicalDevice);	// Create trilinear repeating sampler over every level
+	static void CheckFormat(PhysicalDevice* physicalDevice, VkFormat format);	// Throw error if format cannot be sampled with linear filtering
+	static bool CanBlit(PhysicalDevice* physicalDevice, VkFormat format);	// Format can be blitted with linear filtering in optimal tiling
+};
@@ -0,0 +1,410 @@
+#include "UploadManager.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+// Constructor
+UploadManager::UploadManager(Device* device, MemoryAllocator* allocator, VkDeviceSize stagingSize)
+: m_Device(device), m_Allocator(allocator) {
+	// Ownership has to be handed over if copies run on a separate queue family
+	m_OwnershipTransfer = m_Device->GetTransferFamily() != m_Device->GetGraphicsFamily();
+
+	// Create command pools, batches are short lived and rerecorded individually
+	VkCommandPoolCreateFlags poolFlags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT | VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+	m_TransferPool = std::make_unique<CommandPool>(m_Device, m_Device->GetTransferFamily(), poolFlags);
+	m_GraphicsPool = std::make_unique<CommandPool>(m_Device, m_Device->GetGraphicsFamily(), poolFlags);
+
+	// Create persistently mapped staging ring
+	m_StagingBuffer = std::make_unique<Buffer>(m_Device, m_Allocator, stagingSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, nullptr);
+}
+
+// Destructor
+UploadManager::~UploadManager(){
+	// Wait for submitted batches
+	WaitIdle();
+
+	// Discard batch being recorded
+	if (m_CurrentBatch) {
+		m_CurrentBatch->transferCommands->End();
+		m_FreeBatches.emplace_back(std::move(m_CurrentBatch));
+	}
+
+	// Destroy semaphores and fences
+	for (auto& batch : m_FreeBatches) {
+		vkDestroySemaphore(m_Device->GetDevice(), batch->transferDone, nullptr);
+		vkDestroyFence(m_Device->GetDevice(), batch->fence, nullptr);
+	}
+}
+
+// Queue copy of data into device local buffer
+void UploadManager::UploadBuffer(Buffer* buffer, const void* data, VkDeviceSize size, VkDeviceSize offset){
+	// Split large uploads so a single copy never needs more than half the ring
+	auto maxChunk = m_StagingBuffer->GetSize() / 2;
+	auto source = static_cast<const char*>(data);
+	auto staging = static_cast<char*>(m_StagingBuffer->GetMappedData());
+
+	for (VkDeviceSize copied = 0; copied < size;) {
+		// Copy chunk into staging ring
+		auto chunk = std::min(maxChunk, size - copied);
+		auto stagingOffset = AllocateStaging(chunk);
+		std::memcpy(staging + stagingOffset, source + copied, static_cast<size_t>(chunk));
+
+		// Record copy from staging ring into buffer
+		BeginBatch();
+		VkBufferCopy copyRegion = {};
+		copyRegion.srcOffset = stagingOffset;
+		copyRegion.dstOffset = offset + copied;
+		copyRegion.size = chunk;
+		vkCmdCopyBuffer(m_CurrentBatch->transferCommands->GetCommandBuffer(), m_StagingBuffer->GetBuffer(), buffer->GetBuffer(), 1, &copyRegion);
+
+		// Remember written range for barriers at flush
+		m_Regions.push_back({ buffer->GetBuffer(), offset + copied, chunk });
+		copied += chunk;
+	}
+}
+
+// Queue copy of tightly packed levels into image, missing levels are blitted on the graphics queue, image ends up shader readable
+void UploadManager::UploadImage(Image* image, const std::vector<const void*>& levels){
+	// Throw error if there is no level to blit the rest from
+	if (levels.empty() || levels.size() > image->GetMipLevels()) {
+		throw std::runtime_error("Unable to upload image, level count does not fit image!");
+	}
+	if (Image::GetBlockSize(image->GetFormat()) == 0) {
+		throw std::runtime_error("Unable to upload image, format layout is unknown!");
+	}
+
+	// Every level becomes a transfer destination, previous contents are discarded
+	BeginBatch();
+	TransitionLevels(m_CurrentBatch->transferCommands->GetCommandBuffer(), image->GetImage(), 0, image->GetMipLevels(), VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+		0, VK_ACCESS_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
+
+	// Copy levels in rows of texel blocks, large levels are split so a single copy never needs more than half the ring
+	auto maxChunk = m_StagingBuffer->GetSize() / 2;
+	auto staging = static_cast<char*>(m_StagingBuffer->GetMappedData());
+	auto blockSize = Image::GetBlockSize(image->GetFormat());
+	auto blockExtent = Image::GetBlockExtent(image->GetFormat());
+	auto rowGranularity = m_Device->GetTransferGranularity().height;
+	for (uint32_t level = 0; level < levels.size(); level++) {
+		auto extent = Image::GetMipExtent(image->GetExtent(), level);
+		VkDeviceSize rowSize = static_cast<VkDeviceSize>((extent.width + blockExtent - 1) / blockExtent) * blockSize;
+		auto rowCount = (extent.height + blockExtent - 1) / blockExtent;
+		auto rowsPerChunk = static_cast<uint32_t>(std::max<VkDeviceSize>(maxChunk / rowSize, 1));
+
+		// Chunks start and end on the transfer family's granularity, given in texel block rows, zero only allows whole levels
+		if (rowGranularity == 0) {
+			rowsPerChunk = rowCount;
+		}
+		else {
+			rowsPerChunk = std::max(rowsPerChunk / rowGranularity * rowGranularity, rowGranularity);
+		}
+		if (std::min(rowsPerChunk, rowCount) * rowSize > m_StagingBuffer->GetSize()) {
+			throw std::runtime_error("Unable to upload image, level chunk does not fit staging ring!");
+		}
+		auto source = static_cast<const char*>(levels[level]);
+
+		for (uint32_t row = 0; row < rowCount;) {
+			// Copy rows into staging ring, a full ring flushes the batch but keeps the image in transfer destination layout
+			auto rows = std::min(rowsPerChunk, rowCount - row);
+			auto stagingOffset = AllocateStaging(rows * rowSize);
+			std::memcpy(staging + stagingOffset, source + row * rowSize, static_cast<size_t>(rows * rowSize));
+
+			// Record copy from staging ring into level
+			BeginBatch();
+			VkBufferImageCopy copyRegion = {};
+			copyRegion.bufferOffset = stagingOffset;
+			copyRegion.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+			copyRegion.imageSubresource.mipLevel = level;
+			copyRegion.imageSubresource.baseArrayLayer = 0;
+			copyRegion.imageSubresource.layerCount = 1;
+			copyRegion.imageOffset = { 0, static_cast<int32_t>(row * blockExtent), 0 };
+			copyRegion.imageExtent = { extent.width, std::min(rows * blockExtent, extent.height - row * blockExtent), 1 };
+			vkCmdCopyBufferToImage(m_CurrentBatch->transferCommands->GetCommandBuffer(), m_StagingBuffer->GetBuffer(), image->GetImage(), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &copyRegion);
+			row += rows;
+		}
+	}
+
+	// Image is finished by the batch that copied its last rows
+	m_ImageRegions.push_back({ image, static_cast<uint32_t>(levels.size()) });
+}
+
+// Submit queued copies, buffers and images are usable by graphics commands submitted afterwards
+void UploadManager::Flush(){
+	// Nothing to submit
+	if (!m_CurrentBatch) return;
+
+	// Take current batch
+	auto batch = std::move(m_CurrentBatch);
+	batch->stagingBytes = m_PendingStagingBytes;
+	m_PendingStagingBytes = 0;
+
+	// Buffers may be read as vertex, index, uniform or storage data afterwards, storage data also by fragment shaders through the bindless table and by compute passes
+	VkPipelineStageFlags dstStages = VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+	VkAccessFlags dstAccess = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT | VK_ACCESS_UNIFORM_READ_BIT | VK_ACCESS_SHADER_READ_BIT;
+
+	// Buffer barriers for every written range
+	std::vector<VkBufferMemoryBarrier> barriers(m_Regions.size());
+	for (size_t i = 0; i < m_Regions.size(); i++) {
+		barriers[i].sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+		barriers[i].srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		barriers[i].dstAccessMask = dstAccess;
+		barriers[i].srcQueueFamilyIndex = m_OwnershipTransfer ? m_Device->GetTransferFamily() : VK_QUEUE_FAMILY_IGNORED;
+		barriers[i].dstQueueFamilyIndex = m_OwnershipTransfer ? m_Device->GetGraphicsFamily() : VK_QUEUE_FAMILY_IGNORED;
+		barriers[i].buffer = m_Regions[i].buffer;
+		barriers[i].offset = m_Regions[i].offset;
+		barriers[i].size = m_Regions[i].size;
+	}
+	m_Regions.clear();
+
+	// Images keep their transfer destination layout across the queue family transfer
+	std::vector<VkImageMemoryBarrier> imageBarriers(m_ImageRegions.size());
+	for (size_t i = 0; i < m_ImageRegions.size(); i++) {
+		imageBarriers[i].sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+		imageBarriers[i].srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		imageBarriers[i].dstAccessMask = 0;
+		imageBarriers[i].oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+		imageBarriers[i].newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+		imageBarriers[i].srcQueueFamilyIndex = m_Device->GetTransferFamily();
+		imageBarriers[i].dstQueueFamilyIndex = m_Device->GetGraphicsFamily();
+		imageBarriers[i].image = m_ImageRegions[i].image->GetImage();
+		imageBarriers[i].subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, m_ImageRegions[i].image->GetMipLevels(), 0, 1 };
+	}
+	auto imageRegions = std::move(m_ImageRegions);
+	m_ImageRegions.clear();
+	auto imageBarrierCount = static_cast<uint32_t>(imageBarriers.size());
+
+	auto transferCommands = batch->transferCommands->GetCommandBuffer();
+	auto barrierCount = static_cast<uint32_t>(barriers.size());
+
+	// Submit info for copies
+	VkSubmitInfo transferSubmit = {};
+	transferSubmit.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+	transferSubmit.commandBufferCount = 1;
+	transferSubmit.pCommandBuffers = &transferCommands;
+
+	// Same family, a single submission with a plain barrier is enough
+	if (!m_OwnershipTransfer) {
+		vkCmdPipelineBarrier(transferCommands, VK_PIPELINE_STAGE_TRANSFER_BIT, dstStages, 0, 0, nullptr, barrierCount, barriers.data(), 0, nullptr);
+
+		// Queue can blit, finish images right after their copies
+		for (auto& region : imageRegions) {
+			RecordMipChain(transferCommands, region);
+		}
+		batch->transferCommands->End();
+
+		// Submit copies
+		if (vkQueueSubmit(m_Device->GetTransferQueue(), 1, &transferSubmit, batch->fence) != VK_SUCCESS) {
+			throw std::runtime_error("Unable to submit upload batch!");
+		}
+		m_InFlight.emplace_back(std::move(batch));
+		return;
+	}
+
+	// Release ownership on transfer queue, destination access is ignored for release
+	for (auto& barrier : barriers) {
+		barrier.dstAccessMask = 0;
+	}
+	vkCmdPipelineBarrier(transferCommands, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr, barrierCount, barriers.data(), imageBarrierCount, imageBarriers.data());
+	batch->transferCommands->End();
+
+	// Acquire ownership on graphics queue, source access is ignored for acquire
+	auto acquireCommands = batch->acquireCommands->GetCommandBuffer();
+	for (auto& barrier : barriers) {
+		barrier.srcAccessMask = 0;
+		barrier.dstAccessMask = dstAccess;
+	}
+	for (auto& barrier : imageBarriers) {
+		barrier.srcAccessMask = 0;
+		barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+	}
+	batch->acquireCommands->Begin();
+	vkCmdPipelineBarrier(acquireCommands, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, dstStages, 0, 0, nullptr, barrierCount, barriers.data(), 0, nullptr);
+
+	// Acquired images are finished here, transfer queues may not support blits
+	if (!imageRegions.empty()) {
+		vkCmdPipelineBarrier(acquireCommands, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, imageBarrierCount, imageBarriers.data());
+		for (auto& region : imageRegions) {
+			RecordMipChain(acquireCommands, region);
+		}
+	}
+	batch->acquireCommands->End();
+
+	// Submit copies, signalling acquire
+	transferSubmit.signalSemaphoreCount = 1;
+	transferSubmit.pSignalSemaphores = &batch->transferDone;
+	if (vkQueueSubmit(m_Device->GetTransferQueue(), 1, &transferSubmit, VK_NULL_HANDLE) != VK_SUCCESS) {
+		throw std::runtime_error("Unable to submit upload batch!");
+	}
+
+	// Submit acquire once copies finished, fence covers the whole batch
+	VkSubmitInfo acquireSubmit = {};
+	acquireSubmit.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+	acquireSubmit.waitSemaphoreCount = 1;
+	acquireSubmit.pWaitSemaphores = &batch->transferDone;
+	VkPipelineStageFlags waitStages = dstStages | (imageRegions.empty() ? 0 : VK_PIPELINE_STAGE_TRANSFER_BIT);
+	acquireSubmit.pWaitDstStageMask = &waitStages;
+	acquireSubmit.commandBufferCount = 1;
+	acquireSubmit.pCommandBuffers = &acquireCommands;
+	if (vkQueueSubmit(m_Device->GetGraphicsQueue(), 1, &acquireSubmit, batch->fence) != VK_SUCCESS) {
+		throw std::runtime_error("Unable to submit upload acquire!");
+	}
+	m_InFlight.emplace_back(std::move(batch));
+}
+
+// Recycle finished batches and their staging memory
+void UploadManager::Reclaim(){
+	while (RetireOldest(false)) {}
+}
+
+// Wait for all submitted batches to finish
+void UploadManager::WaitIdle(){
+	while (RetireOldest(true)) {}
+}
+
+// Reserve bytes in staging ring, waiting for space if needed
+VkDeviceSize UploadManager::AllocateStaging(VkDeviceSize size){
+	auto capacity = m_StagingBuffer->GetSize();
+	while (true) {
+		// Restart at front of ring when empty
+		if (m_StagingUsed == 0) {
+			m_StagingHead = 0;
+		}
+
+		// Align head, wrapping to front if the end of the ring is too short
+		auto offset = (m_StagingHead + STAGING_ALIGNMENT - 1) & ~(STAGING_ALIGNMENT - 1);
+		if (offset + size > capacity) {
+			offset = 0;
+		}
+		auto consumed = (offset == 0 && m_StagingHead != 0 ? capacity - m_StagingHead : offset - m_StagingHead) + size;
+
+		// Take space if the ring has room
+		if (m_StagingUsed + consumed <= capacity) {
+			m_StagingHead = offset + size;
+			m_StagingUsed += consumed;
+			m_PendingStagingBytes += consumed;
+			return offset;
+		}
+
+		// Ring full, submit queued copies and wait for oldest batch
+		if (m_InFlight.empty()) {
+			Flush();
+		}
+		RetireOldest(true);
+	}
+}
+
+// Start recording current batch if not already
+void UploadManager::BeginBatch(){
+	// Already recording
+	if (m_CurrentBatch) return;
+
+	// Reuse finished batch if possible
+	if (!m_FreeBatches.empty()) {
+		m_CurrentBatch = std::move(m_FreeBatches.back());
+		m_FreeBatches.pop_back();
+	}
+	else {
+		// Create command buffers
+		m_CurrentBatch = std::make_unique<Batch>();
+		m_CurrentBatch->transferCommands = std::make_unique<CommandBuffer>(m_Device, m_TransferPool.get());
+		m_CurrentBatch->acquireCommands = std::make_unique<CommandBuffer>(m_Device, m_GraphicsPool.get());
+
+		// Semaphore creation info
+		VkSemaphoreCreateInfo semaphoreCreateInfo = {};
+		semaphoreCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
+		// Fence creation info
+		VkFenceCreateInfo fenceCreateInfo = {};
+		fenceCreateInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+
+		// Create semaphore and fence
+		if (vkCreateSemaphore(m_Device->GetDevice(), &semaphoreCreateInfo, nullptr, &m_CurrentBatch->transferDone) != VK_SUCCESS) {
+			throw std::runtime_error("Unable to create upload semaphore!");
+		}
+		if (vkCreateFence(m_Device->GetDevice(), &fenceCreateInfo, nullptr, &m_CurrentBatch->fence) != VK_SUCCESS) {
+			throw std::runtime_error("Unable to create upload fence!");
+		}
+	}
+
+	// Begin recording copies
+	m_CurrentBatch->transferCommands->Begin();
+}
+
+// Recycle oldest in flight batch if finished, returns false if none retired
+bool UploadManager::RetireOldest(bool wait){
+	// Nothing in flight
+	if (m_InFlight.empty()) return false;
+
+	// Check or wait for batch fence
+	auto& batch = m_InFlight.front();
+	if (wait) {
+		vkWaitForFences(m_Device->GetDevice(), 1, &batch->fence, VK_TRUE, UINT64_MAX);
+	}
+	else if (vkGetFenceStatus(m_Device->GetDevice(), batch->fence) != VK_SUCCESS) {
+		return false;
+	}
+
+	// Release staging memory and recycle batch
+	vkResetFences(m_Device->GetDevice(), 1, &batch->fence);
+	m_StagingUsed -= batch->stagingBytes;
+	m_FreeBatches.emplace_back(std::move(batch));
+	m_InFlight.pop_front();
+	return true;
+}
+
+// Blit missing levels and move every level to shader reads, needs a graphics queue
+void UploadManager::RecordMipChain(VkCommandBuffer commandBuffer, const ImageRegion& region){
+	auto image = region.image->GetImage();
+	auto levelCount = region.image->GetMipLevels();
+	auto firstBlitted = region.uploadedLevels;
+	VkPipelineStageFlags shaderStages = VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+
+	// Uploaded levels that are not blitted from are already final
+	auto finalLevels = firstBlitted < levelCount ? firstBlitted - 1 : levelCount;
+	if (finalLevels > 0) {
+		TransitionLevels(commandBuffer, image, 0, finalLevels, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+			VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, shaderStages);
+	}
+
+	// Halve each level into the next, linear filtering averages 2x2 texels
+	for (auto level = firstBlitted; level < levelCount; level++) {
+		// Previous level becomes blit source once written
+		TransitionLevels(commandBuffer, image, level - 1, 1, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+			VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
+
+		// Blit previous level into level
+		auto sourceExtent = Image::GetMipExtent(region.image->GetExtent(), level - 1);
+		auto extent = Image::GetMipExtent(region.image->GetExtent(), level);
+		VkImageBlit blit = {};
+		blit.srcSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, level - 1, 0, 1 };
+		blit.srcOffsets[1] = { static_cast<int32_t>(sourceExtent.width), static_cast<int32_t>(sourceExtent.height), 1 };
+		blit.dstSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, level, 0, 1 };
+		blit.dstOffsets[1] = { static_cast<int32_t>(extent.width), static_cast<int32_t>(extent.height), 1 };
+		vkCmdBlitImage(commandBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &blit, VK_FILTER_LINEAR);
+
+		// Previous level is done
+		TransitionLevels(commandBuffer, image, level - 1, 1, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+			VK_ACCESS_TRANSFER_READ_BIT, VK_ACCESS_SHADER_READ_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, shaderStages);
+	}
+
+	// Last blitted level is never read by a blit
+	if (firstBlitted < levelCount) {
+		TransitionLevels(commandBuffer, image, levelCount - 1, 1, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+			VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, shaderStages);
+	}
+}
+
+// Record layout transition of mip level range
+void UploadManager::TransitionLevels(VkCommandBuffer commandBuffer, VkImage image, uint32_t baseLevel, uint32_t levelCount, VkImageLayout oldLayout, VkImageLayout newLayout, VkAccessFlags srcAccess, VkAccessFlags dstAccess, VkPipelineStageFlags srcStage, VkPipelineStageFlags dstStage){
+	VkImageMemoryBarrier barrier = {};
+	barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+	barrier.srcAccessMask = srcAccess;
+	barrier.dstAccessMask = dstAccess;
+	barrier.oldLayout = oldLayout;
+	barrier.newLayout = newLayout;
+	barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	barrier.image = image;
+	barrier.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, baseLevel, levelCount, 0, 1 };
+	vkCmdPipelineBarrier(commandBuffer, srcStage, dstStage, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+#include "Buffer.h"
+#include "CommandBuffer.h"
+#include "CommandPool.h"
+#include "Device.h"
+#include "Image.h"
+#include "MemoryAllocator.h"
+
+class UploadManager {
+public:
+	UploadManager(Device* device, MemoryAllocator* allocator, VkDeviceSize stagingSize = DEFAULT_STAGING_SIZE);	// Constructor
+	~UploadManager();	// Destructor
+
+	static constexpr VkDeviceSize DEFAULT_STAGING_SIZE = 16 * 1024 * 1024;	// Size of staging ring
+	static constexpr VkDeviceSize STAGING_ALIGNMENT = 16;					// Alignment of copies inside staging ring
+
+	// FUNCTIONS
+	void UploadBuffer(Buffer* buffer, const void* data, VkDeviceSize size, VkDeviceSize offset = 0);	// Queue copy of data into device local buffer
+	void UploadImage(Image* image, const std::vector<const void*>& levels);	// Queue copy of tightly packed levels into image, missing levels are blitted on the graphics queue, image ends up shader readable
+	void Flush();	// Submit queued copies, buffers and images are usable by graphics commands submitted afterwards
+	void Reclaim();	// Recycle finished batches and their staging memory
+	void WaitIdle();	// Wait for all submitted batches to finish
+
+	// GETTERS
+	const VkDeviceSize GetStagingUsed() const { return m_StagingUsed; }
+	const bool HasPendingCopies() const { return m_CurrentBatch != nullptr; }
+private:
+	// Range of a destination buffer written by the current batch
+	struct Region {
+		VkBuffer buffer;		// Destination buffer
+		VkDeviceSize offset;	// Offset of written range
+		VkDeviceSize size;		// Size of written range
+	};
+
+	// Image written by the current batch, finished on the graphics queue
+	struct ImageRegion {
+		Image* image;				// Destination image, every level in transfer destination layout
+		uint32_t uploadedLevels;	// Levels copied from staging, remaining levels are blitted
+	};
+
+	// Group of copies submitted together
+	struct Batch {
+		std::unique_ptr<CommandBuffer> transferCommands;	// Copies and ownership release on transfer queue
+		std::unique_ptr<CommandBuffer> acquireCommands;		// Ownership acquire on graphics queue
+		VkSemaphore transferDone = VK_NULL_HANDLE;			// Signalled when copies finished
+		VkFence fence = VK_NULL_HANDLE;						// Signalled when batch finished
+		VkDeviceSize stagingBytes = 0;						// Staging ring bytes released when batch finished
+	};
+
+	// VARIABLES
+	Device* m_Device;					// Vulkan device
+	MemoryAllocator* m_Allocator;		// Device memory allocator
+
+	bool m_OwnershipTransfer;			// True if transfer and graphics families differ
+	std::unique_ptr<CommandPool> m_TransferPool;	// Command pool on transfer family
+	std::unique_ptr<CommandPool> m_GraphicsPool;	// Command pool on graphics family
+
+	std::unique_ptr<Buffer> m_StagingBuffer;	// Persistently mapped staging ring
+	VkDeviceSize m_StagingHead = 0;				// Next free byte in staging ring
+	VkDeviceSize m_StagingUsed = 0;				// Bytes between oldest in flight batch and head
+	VkDeviceSize m_PendingStagingBytes = 0;		// Staging bytes consumed by current batch
+
+	std::unique_ptr<Batch> m_CurrentBatch;				// Batch being recorded
+	std::vector<Region> m_Regions;						// Ranges written by current batch
+	std::vector<ImageRegion> m_ImageRegions;			// Images fully written by current batch
+	std::deque<std::unique_ptr<Batch>> m_InFlight;		// Submitted batches, oldest first
+	std::vector<std::unique_ptr<Batch>> m_FreeBatches;	// Finished batches ready for reuse
+
+	// FUNCTIONS
+	VkDeviceSize AllocateStaging(VkDeviceSize size);	// Reserve bytes in staging ring, waiting for space if needed
+	void BeginBatch();		// Start recording current batch if not already
+	bool RetireOldest(bool wait);	// Recycle oldest in flight batch if finished, returns false if none retired
+	void RecordMipChain(VkCommandBuffer commandBuffer, const ImageRegion& region);	// Blit missing levels and move every level to shader reads, needs a graphics queue
+	static void TransitionLevels(VkCommandBuffer commandBuffer, VkImage image, uint32_t baseLevel, uint32_t levelCount, VkImageLayout oldLayout, VkImageLayout newLayout, VkAccessFlags srcAccess, VkAccessFlags dstAccess, VkPipelineStageFlags srcStage, VkPipelineStageFlags dstStage);	// Record layout transition of mip level range
+};
@@ -1,13 +1,30 @@
 #include "Vertex.h"
 
+#include <cstddef>
+#include <cstring>
+
 // Constructor
 Vertex::Vertex(glm::vec3 position, glm::vec3 colour, glm::vec2 uv)
 : m_Position(position), m_Colour(colour), m_UV(uv) {
-	
+	// Members must sit where the generated descriptions expect them
+	static_assert(sizeof(Vertex) == StandardVertexLayout::STRIDE, "Vertex size must match StandardVertexLayout!");
+	static_assert(offsetof(Vertex, m_Position) == StandardVertexLayout::OFFSETS[0], "Vertex position must match StandardVertexLayout!");
+	static_assert(offsetof(Vertex, m_Colour) == StandardVertexLayout::OFFSETS[1], "Vertex colour must match StandardVertexLayout!");
+	static_assert(offsetof(Vertex, m_UV) == StandardVertexLayout::OFFSETS[2], "Vertex UV must match StandardVertexLayout!");
 }
 
-// Destructor
-Vertex::~Vertex() {
+// Hash of all attributes, vertices equal by operator== hash equally
+uint64_t Vertex::Hash() const {
+	// Adding zero folds -0 into 0, which compare equal but differ in bits
+	float components[] = { m_Position.x + 0.0f, m_Position.y + 0.0f, m_Position.z + 0.0f, m_Colour.r + 0.0f, m_Colour.g + 0.0f, m_Colour.b + 0.0f, m_UV.x + 0.0f, m_UV.y + 0.0f };
 
+	// Multiply and fold each component's bits into hash
+	uint64_t hash = 0;
+	for (auto component : components) {
+		uint32_t bits;
+		std::memcpy(&bits, &component, sizeof(bits));
+		hash = (hash ^ bits) * 0x9e3779b97f4a7c15ull;
+		hash ^= hash >> 32;
+	}
+	return hash;
 }
-
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <glm/gtc/packing.hpp>
+#include <vulkan/vulkan.h>
+
+#include "VertexLayout.h"
+
+// Shader locations shared by all vertex formats, 2 to 6 are taken by the per-instance stream
+constexpr uint32_t LOCATION_POSITION = 0;	// Vertex position
+constexpr uint32_t LOCATION_COLOUR = 1;		// Vertex colour
+constexpr uint32_t LOCATION_INSTANCE_TRANSFORM = 2;	// Instance transform, one location per column
+constexpr uint32_t LOCATION_INSTANCE_COLOUR = 6;	// Instance colour
+constexpr uint32_t LOCATION_NORMAL = 7;		// Vertex normal
+constexpr uint32_t LOCATION_UV = 8;			// Texture coordinate
+
+// Two 32 bit floats
+struct Float2 {
+	float x, y;
+	static constexpr VkFormat FORMAT = VK_FORMAT_R32G32_SFLOAT;
+};
+
+// Three 32 bit floats
+struct Float3 {
+	float x, y, z;
+	static constexpr VkFormat FORMAT = VK_FORMAT_R32G32B32_SFLOAT;
+};
+
+// Four 32 bit floats
+struct Float4 {
+	float x, y, z, w;
+	static constexpr VkFormat FORMAT = VK_FORMAT_R32G32B32A32_SFLOAT;
+};
+
+// Column major 4x4 matrix of 32 bit floats, one location per column
+struct Float4x4 {
+	float m[16];
+	static constexpr VkFormat FORMAT = VK_FORMAT_R32G32B32A32_SFLOAT;
+	static constexpr uint32_t LOCATIONS = 4;
+};
+
+// Position as half floats, w pads to 8 bytes as three component 16 bit formats are rarely supported
+struct HalfPosition {
+	uint16_t x, y, z, w;
+	static constexpr VkFormat FORMAT = VK_FORMAT_R16G16B16A16_SFLOAT;
+
+	static HalfPosition Encode(const glm::vec3& position) {
+		return { glm::packHalf1x16(position.x), glm::packHalf1x16(position.y), glm::packHalf1x16(position.z), glm::packHalf1x16(1.0f) };
+	}
+};
+
+// Position as SNORM16, decoded to [-1, 1] so meshes must be normalised to the unit cube
+struct Snorm16Position {
+	int16_t x, y, z, w;
+	static constexpr VkFormat FORMAT = VK_FORMAT_R16G16B16A16_SNORM;
+
+	static Snorm16Position Encode(const glm::vec3& position) {
+		return { static_cast<int16_t>(glm::packSnorm1x16(position.x)), static_cast<int16_t>(glm::packSnorm1x16(position.y)),
+			static_cast<int16_t>(glm::packSnorm1x16(position.z)), static_cast<int16_t>(glm::packSnorm1x16(1.0f)) };
+	}
+};
+
+// Unit normal folded onto an octahedron and stored as two SNORM16, decoded with OctDecode in shaders
+struct OctNormal {
+	int16_t x, y;
+	static constexpr VkFormat FORMAT = VK_FORMAT_R16G16_SNORM;
+
+	static OctNormal Encode(const glm::vec3& normal) {
+		// Project onto octahedron
+		auto octahedron = glm::vec2(normal) / (std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z));
+
+		// Fold lower hemisphere over the diagonals
+		if (normal.z < 0.0f) {
+			auto folded = glm::vec2(1.0f - std::abs(octahedron.y), 1.0f - std::abs(octahedron.x));
+			octahedron.x = octahedron.x >= 0.0f ? folded.x : -folded.x;
+			octahedron.y = octahedron.y >= 0.0f ? folded.y : -folded.y;
+		}
+		return { static_cast<int16_t>(glm::packSnorm1x16(octahedron.x)), static_cast<int16_t>(glm::packSnorm1x16(octahedron.y)) };
+	}
+};
+
+// Colour as UNORM8
+struct Unorm8Colour {
+	uint8_t r, g, b, a;
+	static constexpr VkFormat FORMAT = VK_FORMAT_R8G8B8A8_UNORM;
+
+	static Unorm8Colour Encode(const glm::vec4& colour) {
+		return { glm::packUnorm1x8(colour.r), glm::packUnorm1x8(colour.g), glm::packUnorm1x8(colour.b), glm::packUnorm1x8(colour.a) };
+	}
+};
+
+// Texture coordinate as half floats
+struct HalfUV {
+	uint16_t u, v;
+	static constexpr VkFormat FORMAT = VK_FORMAT_R16G16_SFLOAT;
+
+	static HalfUV Encode(const glm::vec2& uv) {
+		return { glm::packHalf1x16(uv.x), glm::packHalf1x16(uv.y) };
+	}
+};
+
+// Full precision vertex backing Vertex, read by default.vert and instanced.vert
+using StandardVertexLayout = VertexLayout<
+	VertexAttribute<LOCATION_POSITION, Float3>,
+	VertexAttribute<LOCATION_COLOUR, Float3>,
+	VertexAttribute<LOCATION_UV, Float2>>;
+
+// Per-instance attributes backing InstanceData
+using InstanceLayout = VertexLayout<
+	VertexAttribute<LOCATION_INSTANCE_TRANSFORM, Float4x4>,
+	VertexAttribute<LOCATION_INSTANCE_COLOUR, Float4>>;
+
+// 20 byte vertex with half float position, decoded by compact.vert
+using CompactVertexLayout = VertexLayout<
+	VertexAttribute<LOCATION_POSITION, HalfPosition>,
+	VertexAttribute<LOCATION_COLOUR, Unorm8Colour>,
+	VertexAttribute<LOCATION_NORMAL, OctNormal>,
+	VertexAttribute<LOCATION_UV, HalfUV>>;
+using CompactVertex = CompactVertexLayout::Vertex;
+
+// 20 byte vertex with SNORM16 position for meshes normalised to the unit cube, decoded by compact.vert
+using Snorm16VertexLayout = VertexLayout<
+	VertexAttribute<LOCATION_POSITION, Snorm16Position>,
+	VertexAttribute<LOCATION_COLOUR, Unorm8Colour>,
+	VertexAttribute<LOCATION_NORMAL, OctNormal>,
+	VertexAttribute<LOCATION_UV, HalfUV>>;
+using Snorm16Vertex = Snorm16VertexLayout::Vertex;
+
+// Compact vertex split into a position stream and a stream of remaining attributes, depth only passes bind the first alone
+using CompactPositionLayout = VertexLayout<
+	VertexAttribute<LOCATION_POSITION, HalfPosition>>;
+using CompactSurfaceLayout = VertexLayout<
+	VertexAttribute<LOCATION_COLOUR, Unorm8Colour>,
+	VertexAttribute<LOCATION_NORMAL, OctNormal>,
+	VertexAttribute<LOCATION_UV, HalfUV>>;
+
+// Vertex inputs pipelines are built with
+using StandardInput = VertexInput<VertexStream<0, StandardVertexLayout>>;
+using InstancedInput = VertexInput<VertexStream<0, StandardVertexLayout>, VertexStream<1, InstanceLayout, VK_VERTEX_INPUT_RATE_INSTANCE>>;
+using CompactInput = VertexInput<VertexStream<0, CompactVertexLayout>>;
+using SplitCompactInput = VertexInput<VertexStream<0, CompactPositionLayout>, VertexStream<1, CompactSurfaceLayout>>;
+using PositionOnlyInput = VertexInput<VertexStream<0, CompactPositionLayout>>;
+
+// Encode full precision attributes into a compact vertex
+template<typename Layout>
+typename Layout::Vertex EncodeVertex(const glm::vec3& position, const glm::vec4& colour, const glm::vec3& normal, const glm::vec2& uv) {
+	return typename Layout::Vertex(Layout::template ElementType<0>::Encode(position), Unorm8Colour::Encode(colour), OctNormal::Encode(normal), HalfUV::Encode(uv));
+}
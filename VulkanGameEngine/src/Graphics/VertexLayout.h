@@ -0,0 +1,244 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <tuple>
+#include <type_traits>
+#include <vulkan/vulkan.h>
+
+// Vertex input bindings and attributes a pipeline consumes, generated at compile time
+struct VertexInputDescription {
+	const VkVertexInputBindingDescription* bindings = nullptr;		// Binding descriptions
+	uint32_t bindingCount = 0;										// Amount of bindings
+	const VkVertexInputAttributeDescription* attributes = nullptr;	// Attribute descriptions
+	uint32_t attributeCount = 0;									// Amount of attributes
+	uint64_t hash = 0;												// Hash of bindings and attributes, keys pipeline states
+};
+
+// Numeric type a shader reads an attribute as, normalised and float formats read as float
+enum class VertexComponentType { Float, Int, Uint };
+
+// Numeric type and component count of a vertex attribute format
+struct VertexFormatComponents {
+	VertexComponentType type;	// Numeric type read by shaders
+	uint32_t count;				// Components per location
+};
+
+// Components a vertex attribute format provides
+constexpr VertexFormatComponents GetFormatComponents(VkFormat format) {
+	switch (format) {
+	case VK_FORMAT_R8_UINT: case VK_FORMAT_R16_UINT: case VK_FORMAT_R32_UINT:
+		return { VertexComponentType::Uint, 1 };
+	case VK_FORMAT_R16G16_UINT: case VK_FORMAT_R32G32_UINT:
+		return { VertexComponentType::Uint, 2 };
+	case VK_FORMAT_R32G32B32_UINT:
+		return { VertexComponentType::Uint, 3 };
+	case VK_FORMAT_R8G8B8A8_UINT: case VK_FORMAT_R16G16B16A16_UINT: case VK_FORMAT_R32G32B32A32_UINT:
+		return { VertexComponentType::Uint, 4 };
+	case VK_FORMAT_R8_SINT: case VK_FORMAT_R16_SINT: case VK_FORMAT_R32_SINT:
+		return { VertexComponentType::Int, 1 };
+	case VK_FORMAT_R16G16_SINT: case VK_FORMAT_R32G32_SINT:
+		return { VertexComponentType::Int, 2 };
+	case VK_FORMAT_R32G32B32_SINT:
+		return { VertexComponentType::Int, 3 };
+	case VK_FORMAT_R8G8B8A8_SINT: case VK_FORMAT_R16G16B16A16_SINT: case VK_FORMAT_R32G32B32A32_SINT:
+		return { VertexComponentType::Int, 4 };
+	case VK_FORMAT_R8_UNORM: case VK_FORMAT_R16_UNORM: case VK_FORMAT_R16_SFLOAT: case VK_FORMAT_R32_SFLOAT:
+		return { VertexComponentType::Float, 1 };
+	case VK_FORMAT_R8G8_UNORM: case VK_FORMAT_R16G16_UNORM: case VK_FORMAT_R16G16_SNORM: case VK_FORMAT_R16G16_SFLOAT: case VK_FORMAT_R32G32_SFLOAT:
+		return { VertexComponentType::Float, 2 };
+	case VK_FORMAT_R32G32B32_SFLOAT:
+		return { VertexComponentType::Float, 3 };
+	default:
+		return { VertexComponentType::Float, 4 };
+	}
+}
+
+// Locations an element occupies, elements larger than a location (e.g. matrices) define LOCATIONS
+template<typename Element, typename = void>
+struct VertexElementLocations { static constexpr uint32_t value = 1; };
+template<typename Element>
+struct VertexElementLocations<Element, std::void_t<decltype(Element::LOCATIONS)>> { static constexpr uint32_t value = Element::LOCATIONS; };
+
+// Attribute at shader location, Element is a trivially copyable CPU type defining its VkFormat as FORMAT
+template<uint32_t Location, typename Element>
+struct VertexAttribute {
+	static_assert(std::is_trivially_copyable_v<Element>, "Vertex elements must be trivially copyable!");
+	static_assert(sizeof(Element) % VertexElementLocations<Element>::value == 0, "Vertex element must split evenly over its locations!");
+
+	using ElementType = Element;
+	static constexpr uint32_t LOCATION = Location;										// First shader location
+	static constexpr uint32_t LOCATION_COUNT = VertexElementLocations<Element>::value;	// Consecutive locations used
+};
+
+namespace VertexLayoutDetail {
+	// FNV-1a step over a 64 bit value
+	constexpr uint64_t HashMix(uint64_t hash, uint64_t value) {
+		for (int i = 0; i < 8; i++) {
+			hash ^= (value >> (i * 8)) & 0xff;
+			hash *= 1099511628211ull;
+		}
+		return hash;
+	}
+
+	// Offsets of elements packed in order, each aligned to its own alignment
+	template<size_t N>
+	constexpr std::array<uint32_t, N> PackOffsets(const std::array<uint32_t, N>& sizes, const std::array<uint32_t, N>& alignments) {
+		std::array<uint32_t, N> offsets = {};
+		uint32_t offset = 0;
+		for (size_t i = 0; i < N; i++) {
+			offset = (offset + alignments[i] - 1) / alignments[i] * alignments[i];
+			offsets[i] = offset;
+			offset += sizes[i];
+		}
+		return offsets;
+	}
+
+	// Attribute descriptions for a binding, one per location
+	template<size_t Locations, size_t N>
+	constexpr std::array<VkVertexInputAttributeDescription, Locations> Describe(uint32_t binding, const std::array<uint32_t, N>& locations, const std::array<uint32_t, N>& locationCounts,
+		const std::array<VkFormat, N>& formats, const std::array<uint32_t, N>& offsets, const std::array<uint32_t, N>& sizes) {
+		std::array<VkVertexInputAttributeDescription, Locations> descriptions = {};
+		size_t next = 0;
+		for (size_t i = 0; i < N; i++) {
+			for (uint32_t j = 0; j < locationCounts[i]; j++) {
+				descriptions[next].location = locations[i] + j;
+				descriptions[next].binding = binding;
+				descriptions[next].format = formats[i];
+				descriptions[next].offset = offsets[i] + j * (sizes[i] / locationCounts[i]);
+				next++;
+			}
+		}
+		return descriptions;
+	}
+
+	// Join attribute arrays of several streams
+	template<size_t Total, size_t... Sizes>
+	constexpr std::array<VkVertexInputAttributeDescription, Total> Concatenate(const std::array<VkVertexInputAttributeDescription, Sizes>&... arrays) {
+		std::array<VkVertexInputAttributeDescription, Total> result = {};
+		size_t next = 0;
+		auto append = [&result, &next](const auto& attributes) {
+			for (auto& attribute : attributes) {
+				result[next++] = attribute;
+			}
+		};
+		(append(arrays), ...);
+		return result;
+	}
+
+	// True if no two attributes share a location
+	template<size_t N>
+	constexpr bool UniqueLocations(const std::array<VkVertexInputAttributeDescription, N>& attributes) {
+		for (size_t i = 0; i < N; i++) {
+			for (size_t j = i + 1; j < N; j++) {
+				if (attributes[i].location == attributes[j].location) return false;
+			}
+		}
+		return true;
+	}
+
+	// True if no two streams share a binding
+	template<size_t N>
+	constexpr bool UniqueBindings(const std::array<VkVertexInputBindingDescription, N>& bindings) {
+		for (size_t i = 0; i < N; i++) {
+			for (size_t j = i + 1; j < N; j++) {
+				if (bindings[i].binding == bindings[j].binding) return false;
+			}
+		}
+		return true;
+	}
+
+	// Hash of bindings and attributes
+	template<size_t B, size_t A>
+	constexpr uint64_t Hash(const std::array<VkVertexInputBindingDescription, B>& bindings, const std::array<VkVertexInputAttributeDescription, A>& attributes) {
+		uint64_t hash = 14695981039346656037ull;
+		for (auto& binding : bindings) {
+			hash = HashMix(hash, binding.binding);
+			hash = HashMix(hash, binding.stride);
+			hash = HashMix(hash, binding.inputRate);
+		}
+		for (auto& attribute : attributes) {
+			hash = HashMix(hash, attribute.location);
+			hash = HashMix(hash, attribute.binding);
+			hash = HashMix(hash, attribute.format);
+			hash = HashMix(hash, attribute.offset);
+		}
+		return hash;
+	}
+}
+
+// Interleaved vertex layout, CPU storage and Vulkan descriptions are both derived from the attribute list
+template<typename... Attributes>
+class VertexLayout {
+public:
+	template<size_t I>
+	using ElementType = typename std::tuple_element_t<I, std::tuple<Attributes...>>::ElementType;
+
+	static constexpr uint32_t ATTRIBUTE_COUNT = sizeof...(Attributes);					// Attributes in layout
+	static constexpr uint32_t LOCATION_COUNT = (Attributes::LOCATION_COUNT + ...);		// Shader locations used
+	static constexpr std::array<uint32_t, ATTRIBUTE_COUNT> OFFSETS = VertexLayoutDetail::PackOffsets<ATTRIBUTE_COUNT>(
+		{ static_cast<uint32_t>(sizeof(typename Attributes::ElementType))... }, { static_cast<uint32_t>(alignof(typename Attributes::ElementType))... });
+	static constexpr uint32_t STRIDE = (OFFSETS[ATTRIBUTE_COUNT - 1] + static_cast<uint32_t>(sizeof(ElementType<ATTRIBUTE_COUNT - 1>)) + 3) / 4 * 4;	// Bytes per vertex, multiple of 4
+
+	// Trivially copyable vertex of exactly STRIDE bytes
+	struct Vertex {
+		Vertex() = default;
+		Vertex(const typename Attributes::ElementType&... elements) { SetAll(std::index_sequence_for<Attributes...>(), elements...); }
+
+		// Write element I
+		template<size_t I>
+		void Set(const ElementType<I>& element) { std::memcpy(data + OFFSETS[I], &element, sizeof(element)); }
+
+		// Read element I
+		template<size_t I>
+		ElementType<I> Get() const {
+			ElementType<I> element;
+			std::memcpy(&element, data + OFFSETS[I], sizeof(element));
+			return element;
+		}
+
+		alignas(4) uint8_t data[STRIDE];	// Packed element bytes
+	private:
+		template<size_t... I>
+		void SetAll(std::index_sequence<I...>, const typename Attributes::ElementType&... elements) { (Set<I>(elements), ...); }
+	};
+
+	// Binding description for stream at binding
+	static constexpr VkVertexInputBindingDescription GetBindingDescription(uint32_t binding, VkVertexInputRate inputRate = VK_VERTEX_INPUT_RATE_VERTEX) {
+		return { binding, STRIDE, inputRate };
+	}
+
+	// Attribute descriptions for stream at binding
+	static constexpr std::array<VkVertexInputAttributeDescription, LOCATION_COUNT> GetAttributeDescriptions(uint32_t binding) {
+		return VertexLayoutDetail::Describe<LOCATION_COUNT, ATTRIBUTE_COUNT>(binding, { Attributes::LOCATION... }, { Attributes::LOCATION_COUNT... },
+			{ Attributes::ElementType::FORMAT... }, OFFSETS, { static_cast<uint32_t>(sizeof(typename Attributes::ElementType))... });
+	}
+
+	static_assert(sizeof(Vertex) == STRIDE, "Vertex storage must match stride!");
+	static_assert(std::is_trivially_copyable_v<Vertex>, "Vertex must be trivially copyable!");
+};
+
+
+// Layout read from one vertex buffer binding
+template<uint32_t Binding, typename Layout, VkVertexInputRate InputRate = VK_VERTEX_INPUT_RATE_VERTEX>
+struct VertexStream {
+	using LayoutType = Layout;
+	static constexpr uint32_t BINDING = Binding;	// Vertex buffer binding
+	static constexpr VkVertexInputBindingDescription BINDING_DESCRIPTION = Layout::GetBindingDescription(Binding, InputRate);
+	static constexpr std::array<VkVertexInputAttributeDescription, Layout::LOCATION_COUNT> ATTRIBUTES = Layout::GetAttributeDescriptions(Binding);
+};
+
+// Vertex input made of one or more streams, e.g. positions apart from other attributes so depth only passes fetch less
+template<typename... Streams>
+struct VertexInput {
+	static constexpr uint32_t BINDING_COUNT = sizeof...(Streams);									// Vertex buffers bound
+	static constexpr uint32_t ATTRIBUTE_COUNT = (Streams::LayoutType::LOCATION_COUNT + ...);		// Shader locations used
+	static constexpr std::array<VkVertexInputBindingDescription, BINDING_COUNT> BINDINGS = { { Streams::BINDING_DESCRIPTION... } };
+	static constexpr std::array<VkVertexInputAttributeDescription, ATTRIBUTE_COUNT> ATTRIBUTES = VertexLayoutDetail::Concatenate<ATTRIBUTE_COUNT>(Streams::ATTRIBUTES...);
+	static constexpr VertexInputDescription DESCRIPTION = { BINDINGS.data(), BINDING_COUNT, ATTRIBUTES.data(), ATTRIBUTE_COUNT, VertexLayoutDetail::Hash(BINDINGS, ATTRIBUTES) };
+
+	static_assert(VertexLayoutDetail::UniqueBindings(BINDINGS), "Vertex streams must use different bindings!");
+	static_assert(VertexLayoutDetail::UniqueLocations(ATTRIBUTES), "Vertex streams must use different shader locations!");
+	static_assert(ATTRIBUTE_COUNT <= 16, "Vertex input exceeds the 16 attributes every device supports!");
+};
@@ -91,10 +91,11 @@ void Window::UpdateSize(){
 	// Initialise to zeroes
 	int width = 0, height = 0;
 
-	// Wait until nonzero width and height
-	while (width = 0 || height == 0) {
-		glfwGetFramebufferSize(m_Window, &width, &height);
+	// Wait until nonzero width and height, only blocking on events while minimized
+	glfwGetFramebufferSize(m_Window, &width, &height);
+	while (width == 0 || height == 0) {
 		glfwWaitEvents();
+		glfwGetFramebufferSize(m_Window, &width, &height);
 	}
 
 	// Update width and height
@@ -6,6 +6,8 @@
 #include <GLFW/glfw3.h>
 #include <string>
 
+#include "../Core/Profiler.h"
+
 class Window {
 
 public:
@@ -13,8 +15,9 @@ public:
 	~Window();	// Destructor
 
 	VkResult CreateSurface(const VkInstance& instance, const VkAllocationCallbacks* allocator, VkSurfaceKHR* surface);
-	void Update() { glfwPollEvents(); }							// Poll for GLFW events
+	void Update() { PROFILE_SCOPE("Window::Update"); glfwPollEvents(); }	// Poll for GLFW events
 	bool IsClosed(){ return glfwWindowShouldClose(m_Window); }	// Return true if window is being closed
+	void WaitWhileMinimized() { UpdateSize(); }					// Block until framebuffer has a nonzero size
 
 	// GETTERS
 	static Window* Get() { return m_WindowInstance.get(); }
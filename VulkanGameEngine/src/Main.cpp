@@ -1,14 +1,105 @@
+#include <cstring>
 #include <iostream>
+#include <string>
+#include <vector>
 
+#include "Assets/MeshCooker.h"
+#include "Assets/MeshFile.h"
+#include "Assets/TextureCooker.h"
+#include "Core/Profiler.h"
 #include "Tests/TriangleTest.h"
 
-int main() {
+int main(int argc, char* argv[]) {
+	// Check for headless flag, trace output path, mesh path, texture paths, cook paths and texture cook paths
+	bool headless = false;
+	const char* tracePath = nullptr;
+	const char* meshPath = nullptr;
+	std::vector<std::string> texturePaths;
+	const char* cookInput = nullptr;
+	const char* cookOutput = nullptr;
+	const char* cookTextureInput = nullptr;
+	const char* cookTextureOutput = nullptr;
+	auto cookTextureFormat = BlockFormat::BC7;
+	for (int i = 1; i < argc; i++) {
+		if (std::strcmp(argv[i], "--headless") == 0) {
+			headless = true;
+		}
+		else if (std::strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+			tracePath = argv[++i];
+		}
+		else if (std::strcmp(argv[i], "--mesh") == 0 && i + 1 < argc) {
+			meshPath = argv[++i];
+		}
+		else if (std::strcmp(argv[i], "--texture") == 0 && i + 1 < argc) {
+			texturePaths.emplace_back(argv[++i]);
+		}
+		else if (std::strcmp(argv[i], "--cook") == 0 && i + 2 < argc) {
+			cookInput = argv[++i];
+			cookOutput = argv[++i];
+		}
+		else if (std::strcmp(argv[i], "--cook-texture") == 0 && i + 2 < argc) {
+			cookTextureInput = argv[++i];
+			cookTextureOutput = argv[++i];
+
+			// Optional block format, BC7 by default
+			if (i + 1 < argc && argv[i + 1][0] != '-') {
+				std::string format = argv[++i];
+				if (format == "bc1") {
+					cookTextureFormat = BlockFormat::BC1;
+				}
+				else if (format == "bc3") {
+					cookTextureFormat = BlockFormat::BC3;
+				}
+				else if (format == "bc5") {
+					cookTextureFormat = BlockFormat::BC5;
+				}
+				else if (format != "bc7") {
+					std::cout << "Unknown block format " << format << ", expected bc1, bc3, bc5 or bc7!" << std::endl;
+					return 1;
+				}
+			}
+		}
+	}
+
+	// Block compress image into KTX2 texture offline and exit
+	if (cookTextureInput) {
+		ThreadPool threadPool;
+		auto report = TextureCooker::CookImage(cookTextureInput, cookTextureOutput, cookTextureFormat, &threadPool);
+		std::cout << "Cooked " << cookTextureInput << " into " << cookTextureOutput << ", " << report.width << "x" << report.height << " with " << report.levels << " mip levels in format " << report.format << ", " << report.sourceBytes << " bytes compressed to " << report.cookedBytes << std::endl;
+		return 0;
+	}
+
+	// Cook OBJ into binary mesh offline and exit
+	if (cookInput) {
+		ThreadPool threadPool;
+		auto report = MeshCooker::CookObj(cookInput, cookOutput, &threadPool);
+		std::cout << "Cooked " << cookInput << " into " << cookOutput << ", " << MeshOptimizer::FormatReport(report) << std::endl;
+
+		// List level of detail chain as written
+		MeshFile meshFile(cookOutput);
+		for (size_t i = 0; i < meshFile.GetLods().size(); i++) {
+			std::cout << "LOD " << i << ": " << meshFile.GetLods()[i].indexCount / 3 << " triangles, error " << meshFile.GetLods()[i].error << std::endl;
+		}
+		return 0;
+	}
+
+	// Record CPU zones if a trace was requested
+	if (tracePath) {
+		Profiler::Get().SetEnabled(true);
+		Profiler::Get().SetThreadName("Main");
+	}
+
 	// Create application
-	TriangleTest triangleTest;
+	TriangleTest triangleTest(headless, meshPath, texturePaths);
 
 	// Run application
 	triangleTest.Run();
 
+	// Write recorded zones, viewable in chrome://tracing or Perfetto
+	if (tracePath && !Profiler::Get().WriteChromeTrace(tracePath)) {
+		std::cout << "Unable to write trace to " << tracePath << "!" << std::endl;
+	}
+
 	// Exit program
 	return 0;
 }
\ No newline at end of file
@@ -1,23 +1,86 @@
 #include "TriangleTest.h"
 
+#include "../Assets/MeshFile.h"
+#include "../Assets/MeshOptimizer.h"
+#include "../Assets/ObjLoader.h"
+#include "../Assets/TextureLoader.h"
+#include "../Core/Profiler.h"
 #include "../Graphics/Vertex.h"
 
+#include <chrono>
+#include <iostream>
 #include <memory>
+#include <string>
 
 // Constructor
-TriangleTest::TriangleTest(){
-	m_Graphics = new Graphics();
+TriangleTest::TriangleTest(bool headless, const char* meshPath, const std::vector<std::string>& texturePaths){
+	m_Graphics = new Graphics(headless);
 	m_Window = m_Graphics->GetWindow();
 
 	// Set window settings
-	m_Window->SetResizable(true);
+	if (m_Window) {
+		m_Window->SetResizable(true);
+	}
+
+	// Stream cooked textures, their levels are read on I/O threads while frames render
+	std::vector<std::string> imagePaths;
+	for (auto& texturePath : texturePaths) {
+		if (texturePath.size() <= 5 || texturePath.compare(texturePath.size() - 5, 5, ".ktx2") != 0) {
+			imagePaths.emplace_back(texturePath);
+			continue;
+		}
+		m_Graphics->GetStreamingManager()->StreamTexture(texturePath);
+		std::cout << "Streaming " << texturePath << std::endl;
+	}
+
+	// Decode other textures on the graphics worker threads and upload them with their mip chains
+	Texture* triangleTexture = nullptr;
+	if (!imagePaths.empty()) {
+		TextureLoader loader(m_Graphics->GetThreadPool());
+		auto textures = loader.LoadAll(imagePaths);
+		for (size_t i = 0; i < textures.size(); i++) {
+			auto texture = m_Graphics->AddTexture(textures[i]);
+			triangleTexture = triangleTexture ? triangleTexture : texture;
+			std::cout << "Loaded " << imagePaths[i] << " at " << textures[i].width << "x" << textures[i].height << " with " << texture->GetMipLevels() << " mip levels generated on the " << (texture->GetGpuMips() ? "GPU" : "CPU") << std::endl;
+		}
+	}
+
+	// Map cooked mesh, its data is uploaded without parsing
+	std::string path = meshPath ? meshPath : "";
+	if (path.size() > 5 && path.compare(path.size() - 5, 5, ".mesh") == 0) {
+		MeshFile meshFile(path);
+		m_Graphics->AddMesh(meshFile);
+		std::cout << "Loaded " << path << " with " << meshFile.GetVertexCount() << " vertices, " << (meshFile.GetLods().empty() ? meshFile.GetIndexCount() : meshFile.GetLods()[0].indexCount) / 3 << " triangles and " << meshFile.GetLods().size() << " levels of detail" << std::endl;
+		return;
+	}
 
-	// Create vertex buffer
-	Vertex vert1({ 0.0f, -0.5f, 0.0f }, { 1.0f, 0.0f, 0.0f }, { 0, 0 });
-	Vertex vert2({ 0.5f, 0.5f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 0, 0 });
-	Vertex vert3({ -0.5f, 0.5f, 0.0f }, { 0.0f, 0.0f, 1.0f }, { 0, 0 });
+	// Load OBJ mesh, parsed on the graphics worker threads
+	if (meshPath) {
+		ObjLoader loader(m_Graphics->GetThreadPool());
+		auto mesh = loader.Load(meshPath);
+		auto report = MeshOptimizer::Optimize(mesh.vertices, mesh.indices);
+		m_Graphics->AddMesh(mesh.vertices, mesh.indices);
+		std::cout << "Loaded " << meshPath << " with " << mesh.vertices.size() << " vertices and " << mesh.indices.size() / 3 << " triangles, " << MeshOptimizer::FormatReport(report) << std::endl;
+		return;
+	}
+
+	// Create triangle mesh
+	Vertex vert1({ 0.0f, -0.5f, 0.0f }, { 1.0f, 0.0f, 0.0f }, { 0.5f, 0.0f });
+	Vertex vert2({ 0.5f, 0.5f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 1.0f, 1.0f });
+	Vertex vert3({ -0.5f, 0.5f, 0.0f }, { 0.0f, 0.0f, 1.0f }, { 0.0f, 1.0f });
 	std::vector<Vertex> vertices = { vert1, vert2, vert3 };
-	m_Graphics->AddVertexBuffer(vertices);
+	std::vector<uint32_t> indices = { 0, 1, 2 };
+	if (!triangleTexture) {
+		m_Graphics->AddMesh(vertices, indices);
+		return;
+	}
+
+	// Sample first loaded texture through its bindless slot, no descriptor is bound for the draw
+	auto mesh = m_Graphics->AddMesh(vertices, indices, PipelineState::Textured());
+	ResourceIndices resources;
+	resources.texture = triangleTexture->GetBindlessIndex();
+	mesh->SetResources(resources);
+	std::cout << "Drawing triangle with texture slot " << resources.texture << " of " << m_Graphics->GetBindlessTable()->GetTextureCapacity() << (m_Graphics->GetBindlessTable()->GetBindless() ? " in bindless table" : " in per frame descriptor sets") << std::endl;
 }
 
 // Destructor
@@ -26,8 +89,34 @@ TriangleTest::~TriangleTest(){
 }
 
 void TriangleTest::Run(){
+	// Render fixed amount of frames and report frame time when headless
+	if (m_Graphics->GetHeadless()) {
+		ReadbackFrame frame;
+		uint32_t framesRead = 0;
+		auto start = std::chrono::high_resolution_clock::now();
+		for (uint32_t i = 0; i < m_HeadlessFrameCount; i++) {
+			m_Graphics->Update();
+			while (m_Graphics->ReadFrame(frame)) {
+				framesRead++;
+			}
+			Profiler::Get().Collect();
+		}
+		auto end = std::chrono::high_resolution_clock::now();
+		auto milliseconds = std::chrono::duration<double, std::milli>(end - start).count();
+		std::cout << "Rendered " << m_HeadlessFrameCount << " frames (" << framesRead << " read back) in " << milliseconds << "ms, "
+			<< milliseconds / m_HeadlessFrameCount << "ms per frame" << std::endl;
+
+		// Report streaming residency
+		auto stats = m_Graphics->GetStreamingManager()->GetStats();
+		std::cout << "Streamed " << stats.loads << " reads, " << stats.residentBytes << " of " << stats.budget << " budget bytes resident, " << stats.evictions << " evictions, " << stats.pendingLoads << " pending" << std::endl;
+		return;
+	}
+
 	while (!m_Window->IsClosed()) {
 		m_Window->Update();
 		m_Graphics->Update();
+
+		// Drain profiler buffers once per frame so they never overflow
+		Profiler::Get().Collect();
 	}
 }
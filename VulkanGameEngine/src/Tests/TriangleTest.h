@@ -1,5 +1,8 @@
 #pragma once
 
+#include <string>
+#include <vector>
+
 #include "../Graphics/Buffer.h"
 #include "../Graphics/Graphics.h"
 #include "../Graphics/Window.h"
@@ -7,9 +10,12 @@
 
 class TriangleTest : public Test {
 public:
-	TriangleTest();	// Constructor
+	TriangleTest(bool headless = false, const char* meshPath = nullptr, const std::vector<std::string>& texturePaths = {});	// Constructor, draws OBJ at mesh path instead of triangle if given, textures are uploaded for sampling
 	~TriangleTest();// Destructor
 	
 	// FUNCTIONS
 	void Run();
+private:
+	// VARIABLES
+	uint32_t m_HeadlessFrameCount = 1000;	// Frames rendered before a headless run exits
 };
\ No newline at end of file
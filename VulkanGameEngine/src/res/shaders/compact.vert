@@ -0,0 +1,28 @@
+#version 450
+#extension GL_ARB_separate_shader_objects : enable
+
+// Compact vertex, see VertexFormats.h, fixed function fetch already expands half, SNORM and UNORM formats
+layout(location = 0) in vec3 inPosition;
+layout(location = 1) in vec4 inColour;
+layout(location = 7) in vec2 inNormal;
+layout(location = 8) in vec2 inUV;
+
+layout(location = 0) out vec3 fragColor;
+
+const vec3 LIGHT_DIRECTION = vec3(0.0, 0.0, -1.0);
+
+// Unfold octahedral encoded unit normal
+vec3 OctDecode(vec2 encoded) {
+    vec3 normal = vec3(encoded, 1.0 - abs(encoded.x) - abs(encoded.y));
+    float fold = max(-normal.z, 0.0);
+    normal.x += normal.x >= 0.0 ? -fold : fold;
+    normal.y += normal.y >= 0.0 ? -fold : fold;
+    return normalize(normal);
+}
+
+void main() {
+    vec3 normal = OctDecode(inNormal);
+    float light = 0.5 + 0.5 * max(dot(normal, -LIGHT_DIRECTION), 0.0);
+    gl_Position = vec4(inPosition, 1.0);
+    fragColor = inColour.rgb * light;
+}
@@ -1,3 +1,4 @@
-C:\VulkanSDK\1.1.121.2\Bin32\glslc.exe %1.vert -o %1_vert.spv
-C:\VulkanSDK\1.1.121.2\Bin32\glslc.exe %1.frag -o %1_frag.spv
+if exist %1.vert C:\VulkanSDK\1.1.121.2\Bin32\glslc.exe %1.vert -o %1_vert.spv
+if exist %1.frag C:\VulkanSDK\1.1.121.2\Bin32\glslc.exe %1.frag -o %1_frag.spv
+if exist %1.comp C:\VulkanSDK\1.1.121.2\Bin32\glslc.exe %1.comp -o %1_comp.spv
 pause
\ No newline at end of file
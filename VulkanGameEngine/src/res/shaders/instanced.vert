@@ -0,0 +1,15 @@
+#version 450
+#extension GL_ARB_separate_shader_objects : enable
+
+layout(location = 0) in vec3 inPosition;
+layout(location = 1) in vec3 inColour;
+layout(location = 2) in mat4 inTransform;
+layout(location = 6) in vec4 inInstanceColour;
+
+layout(location = 0) out vec3 fragColor;
+
+
+void main() {
+    gl_Position = inTransform * vec4(inPosition, 1.0);
+    fragColor = inColour * inInstanceColour.rgb;
+}
\ No newline at end of file
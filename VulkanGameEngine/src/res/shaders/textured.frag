@@ -0,0 +1,21 @@
+#version 450
+#extension GL_ARB_separate_shader_objects : enable
+
+// Bindless table, see BindlessTable.h, arrays are sized to the table by specialization constants
+layout(constant_id = 0) const uint TEXTURE_CAPACITY = 1;
+layout(set = 0, binding = 0) uniform sampler2D textures[TEXTURE_CAPACITY];
+
+// Slots of this draw, dynamically uniform so no non-uniform qualifier is needed
+layout(push_constant) uniform Resources {
+    uint textureIndex;
+    uint bufferIndex;
+} resources;
+
+layout(location = 0) in vec3 fragColor;
+layout(location = 1) in vec2 fragUV;
+
+layout(location = 0) out vec4 outColor;
+
+void main() {
+    outColor = vec4(fragColor, 1.0) * texture(textures[resources.textureIndex], fragUV);
+}
\ No newline at end of file
@@ -0,0 +1,16 @@
+#version 450
+#extension GL_ARB_separate_shader_objects : enable
+
+layout(location = 0) in vec3 inPosition;
+layout(location = 1) in vec3 inColour;
+layout(location = 8) in vec2 inUV;
+
+layout(location = 0) out vec3 fragColor;
+layout(location = 1) out vec2 fragUV;
+
+
+void main() {
+    gl_Position = vec4(inPosition, 1.0);
+    fragColor = inColour;
+    fragUV = inUV;
+}
\ No newline at end of file